@@ -38,6 +38,10 @@
 
 #define HWDIV_TIMEOUT_WAIT_CNT              10000U    /* HWDIV timeout value*/
 
+#define I2C_TIMEOUT_WAIT_CNT                10000U    /* I2C disable timeout value*/
+
+#define SPI_TIMEOUT_WAIT_CNT                5000000U  /* SPI DMA transfer timeout value*/
+
 #define WDOG_WAITCONFIG_GOING_CNT           0xFFFFFU  /* WDOG config timeout value*/
 
 #endif /* PLATFORM_CFG_H */
@@ -15,6 +15,9 @@
 #define ADC_DRV_H
 
 #include "common_drv.h"
+#include "dma_drv.h"
+#include "tdg_drv.h"
+#include "mcpwm_drv.h"
 
 /** @addtogroup  Z20K14XM_Peripheral_Driver
  *  @{
@@ -375,6 +378,118 @@ typedef union
     uint32_t adcResult;                     /*!< Adc conversion result register*/
 } ADC_Conversion_Result_t;
 
+/**  
+ *  @brief ADC scan buffer done callback type definition
+ */
+typedef void (adc_scan_cb_t)(ADC_ID_t adcId);
+
+/**  
+ *  @brief ADC scan channel definition
+ */
+typedef struct
+{
+    ADC_P_Channel_t    channel;             /*!< Channel number, matched with the channel tag of
+                                                 the results */
+    uint16_t          *data;                /*!< De-interleaved results of this channel, dataLen
+                                                 entries */
+} ADC_ScanChannel_t;
+
+/**  
+ *  @brief ADC scan configure type definition
+ */
+typedef struct
+{
+    const ADC_ScanChannel_t *channels;      /*!< Scanned channels, kept until the scan is stopped */
+    uint32_t           channelNum;          /*!< Number of channels, 1 to 32 */
+    uint32_t          *rawBuffer;           /*!< Circular DMA buffer of 2 * halfLen results */
+    uint32_t           halfLen;             /*!< Results in each half of rawBuffer, a multiple of
+                                                 fifoWatermark + 1 */
+    uint32_t           dataLen;             /*!< Entries of each channel data array */
+    uint8_t            fifoWatermark;       /*!< FIFO watermark, a DMA request moves
+                                                 fifoWatermark + 1 results */
+    DMA_Channel_t      dmaChannel;          /*!< DMA channel */
+    adc_scan_cb_t     *halfCallback;        /*!< Called when the first half is de-interleaved,
+                                                 can be NULL */
+    adc_scan_cb_t     *fullCallback;        /*!< Called when the second half is de-interleaved,
+                                                 can be NULL */
+} ADC_ScanConfig_t;
+
+/**  
+ *  @brief ADC trigger pipeline sample definition
+ */
+typedef struct
+{
+    ADC_ID_t           adcId;               /*!< ADC converting the sample, ADC0 is triggered by
+                                                 TDG0 and ADC1 by TDG1 */
+    ADC_P_Channel_t    channel;             /*!< Channel to convert */
+    uint32_t           instantNs;           /*!< Sampling instant after the PWM counter reload
+                                                 (ns) */
+} ADC_PipelineSample_t;
+
+/**  
+ *  @brief ADC trigger pipeline configure type definition
+ */
+typedef struct
+{
+    MCPWM_ID_t         mcpwmId;             /*!< MCPWM giving the reload trigger */
+    MCPWM_CounterId_t  counterId;           /*!< MCPWM counter giving the reload trigger */
+    uint32_t           pwmPeriodNs;         /*!< PWM period (ns) */
+    uint32_t           tdgClkFreq;          /*!< TDG function clock frequency (Hz) */
+    TDG_ClkDivide_t    tdgClkDivide;        /*!< TDG counter clock divide */
+    uint32_t           adcClkFreq;          /*!< ADC function clock frequency (Hz) */
+    const ADC_PipelineSample_t *samples;    /*!< Samples, in ascending instants for each ADC */
+    uint32_t           sampleNum;           /*!< Number of samples, up to 6 for each ADC */
+} ADC_PipelineConfig_t;
+
+/**  
+ *  @brief ADC oversampling filter type definition
+ */
+typedef enum
+{
+    ADC_OVS_ACCUMULATE = 0U,                /*!< Sum of 4^n samples */
+    ADC_OVS_CIC2,                           /*!< Second order CIC, decimation 4^n, gain 16^n */
+    ADC_OVS_MOVING_AVG                      /*!< Sum of 4^n samples, averaged over the last 2^m
+                                                 results */
+} ADC_OvsFilter_t;
+
+/**  
+ *  @brief ADC oversampling result callback type definition
+ */
+typedef void (adc_ovs_cb_t)(ADC_ID_t adcId, uint32_t chIdx, uint32_t result);
+
+/**  
+ *  @brief ADC oversampling channel state definition, used by the driver
+ */
+typedef struct
+{
+    uint32_t           count;               /*!< Samples of the current result */
+    uint32_t           integ1;              /*!< Accumulator or first CIC integrator */
+    uint32_t           integ2;              /*!< Second CIC integrator */
+    uint32_t           comb1;               /*!< First CIC comb delay */
+    uint32_t           comb2;               /*!< Second CIC comb delay */
+    uint32_t           avgBuf[16];          /*!< Moving average history */
+    uint32_t           avgSum;              /*!< Moving average sum */
+    uint32_t           avgIdx;              /*!< Moving average oldest entry */
+    uint32_t           result;              /*!< Latest result */
+} ADC_OvsChannel_t;
+
+/**  
+ *  @brief ADC oversampling configure type definition
+ */
+typedef struct
+{
+    uint8_t            ratioLog4;           /*!< n: 4^n samples per result, 1 to 6 (1 to 5 for
+                                                 ADC_OVS_CIC2) */
+    uint8_t            shift;               /*!< Right shift of each result, e.g. n for 12 + n
+                                                 bits with ADC_OVS_ACCUMULATE */
+    ADC_OvsFilter_t    filter;              /*!< Decimation filter */
+    uint8_t            avgLog2;             /*!< m: 2^m results averaged, 0 to 4, only used by
+                                                 ADC_OVS_MOVING_AVG */
+    ADC_OvsChannel_t  *states;              /*!< State of each scanned channel, channelNum
+                                                 entries of the scan */
+    adc_ovs_cb_t      *callback;            /*!< Called on each result, can be NULL */
+} ADC_OvsConfig_t;
+
 /** @} end of group ADC_Public_Types*/
 
 
@@ -796,6 +911,135 @@ void ADC_SetStableTime(ADC_ID_t adcId, uint32_t stableTime);
  */
 void ADC_InstallCallBackFunc(ADC_ID_t adcId, ADC_INT_t intType, isr_cb_t * cbFun);
 
+/**
+ * @brief      Adc Scan Start Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ * @param[in]  scanConfig: Pointer to a scan configuration structure.
+ *
+ * @return
+ *             - SUCC: the scan is started
+ *             - ERR: invalid configuration or the scan is running
+ *
+ * The results are moved by DMA into rawBuffer continuously. When a half of
+ * rawBuffer is filled, its results are sorted by the channel tag into the
+ * data arrays of the channels and halfCallback or fullCallback is called.
+ * The channels, the trigger and the ADC enable are set up by the
+ * application.
+ */
+ResultStatus_t ADC_ScanStart(ADC_ID_t adcId, const ADC_ScanConfig_t* scanConfig);
+
+/**
+ * @brief      Adc Scan Stop Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ *
+ * @return     none
+ *
+ */
+void ADC_ScanStop(ADC_ID_t adcId);
+
+/**
+ * @brief      Adc Scan Get Number Of Channel Data Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ * @param[in]  chIdx:      Index of the channel in the scan configuration.
+ *
+ * @return     Number of results in the data array of the channel from the
+ *             last half buffer.
+ *
+ */
+uint32_t ADC_ScanGetNumOfChannelData(ADC_ID_t adcId, uint32_t chIdx);
+
+/**
+ * @brief      Adc Scan Get Latest Result Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ * @param[in]  chIdx:      Index of the channel in the scan configuration.
+ *
+ * @return     The latest result of the channel.
+ *
+ */
+uint16_t ADC_ScanGetLatest(ADC_ID_t adcId, uint32_t chIdx);
+
+/**
+ * @brief      Adc Trigger Pipeline Configure Function
+ *
+ * @param[in]  pipeConfig: Pointer to a trigger pipeline configuration
+ *                         structure.
+ *
+ * @return
+ *             - SUCC: the pipeline is configured
+ *             - ERR: the MCPWM, the counter or the timing is not valid, or
+ *                    the TDG configuration is not loaded. The ADCs and the
+ *                    TMU are not changed, the TDGs of the pipeline are
+ *                    disabled if the load failed.
+ *
+ * Each reload of the MCPWM counter triggers TDG0 and TDG1 through the TMU.
+ * TDG channel k of TDGn is delayed to the k-th sample of ADCn, whose CMDk
+ * buffer converts the sample channel in mapping mode, so the samples are
+ * converted every PWM cycle without CPU load. The instants are checked
+ * against the ADC stable time and conversion time of the current ADC
+ * configuration: the first sample of an ADC is after the stable time,
+ * samples of an ADC are at least one conversion time apart, and the last
+ * conversion ends within the PWM period. ADC_Init() shall be called
+ * before, the ADCs and the PWM are enabled by the application.
+ */
+ResultStatus_t ADC_TriggerPipelineConfig(const ADC_PipelineConfig_t* pipeConfig);
+
+/**
+ * @brief      Adc Oversampling Start Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ * @param[in]  ovsConfig:  Pointer to an oversampling configuration structure.
+ *
+ * @return
+ *             - SUCC: oversampling is started
+ *             - ERR: invalid configuration or the scan is not running
+ *
+ * The results of the running scan (see ADC_ScanStart()) are decimated per
+ * channel as they are de-interleaved: every 4^n samples of a channel give
+ * one result at 12 + n effective bits. A new scan stops oversampling.
+ */
+ResultStatus_t ADC_OversampleStart(ADC_ID_t adcId, const ADC_OvsConfig_t* ovsConfig);
+
+/**
+ * @brief      Adc Oversampling Stop Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ *
+ * @return     none
+ *
+ */
+void ADC_OversampleStop(ADC_ID_t adcId);
+
+/**
+ * @brief      Adc Oversampling Get Result Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ * @param[in]  chIdx:      Index of the channel in the scan configuration.
+ *
+ * @return     The latest oversampled result of the channel, 0 if
+ *             oversampling has never been started or chIdx is not a channel
+ *             of the scan.
+ *
+ */
+uint32_t ADC_OversampleGetResult(ADC_ID_t adcId, uint32_t chIdx);
+
 
 /** @} end of group ADC_Public_FunctionDeclaration */
 
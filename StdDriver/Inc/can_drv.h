@@ -348,6 +348,74 @@ typedef struct
     uint32_t id;             /*!< Rx FIFO ID filter element*/
 } CAN_IdFilter_t;
 
+/**
+ *  @brief CAN acceptance filter rule type
+ */
+typedef enum
+{
+    CAN_FILTER_RULE_ID = 0U,       /*!< accept one ID */
+    CAN_FILTER_RULE_RANGE,         /*!< accept IDs from id to param */
+    CAN_FILTER_RULE_MASK           /*!< accept IDs matching id on the bits set
+                                        in param */
+} CAN_FilterRule_t;
+
+/**
+ *  @brief CAN acceptance filter rule structure
+ */
+typedef struct
+{
+    CAN_FilterRule_t rule;           /*!< rule type */
+    CAN_MsgId_t idType;              /*!< standard or extended ID */
+    uint32_t id;                     /*!< ID, or the first ID of the range */
+    uint32_t param;                  /*!< last ID of the range, or ID mask */
+} CAN_FilterRuleCfg_t;
+
+/**
+ *  @brief CAN acceptance filter entry, an ID and the mask of compared bits.
+ */
+typedef struct
+{
+    uint32_t id;                     /*!< ID */
+    uint32_t mask;                   /*!< ID mask, 1: bit is compared */
+    CAN_MsgId_t idType;              /*!< standard or extended ID */
+} CAN_FilterEntry_t;
+
+/**
+ *  @brief CAN acceptance filter memory. It is used as working memory by 
+ *         CAN_CompileRxFilter() and keeps the software filter afterwards, so
+ *         it shall not be released while the filter is used.
+ */
+typedef struct
+{
+    CAN_FilterEntry_t *entryBuf;     /*!< entry storage, shall hold twice the
+                                          entries the rules are split into: one
+                                          per ID/mask rule and up to 2 per bit 
+                                          of ID width per range rule */
+    uint32_t entryNum;               /*!< number of entries in entryBuf */
+    uint32_t *hashBuf;               /*!< hash table of single IDs checked in
+                                          software, NULL to check them in the 
+                                          entry list */
+    uint32_t hashSize;               /*!< number of words in hashBuf, power 
+                                          of 2 */
+} CAN_FilterMem_t;
+
+/**
+ *  @brief CAN acceptance filter compile result
+ */
+typedef struct
+{
+    CAN_RxFifoIdFormat_t format;     /*!< selected RX FIFO ID filter format */
+    uint32_t hwEntryNum;             /*!< ID filter entries used in hardware */
+    uint32_t swEntryNum;             /*!< entries checked in the list of the 
+                                          software filter */
+    uint32_t swHashNum;              /*!< IDs checked in the hash table of the
+                                          software filter */
+    FlagStatus_t swFilterEn;         /*!< SET if the hardware filter accepts 
+                                          more IDs than the rules and frames 
+                                          shall be checked by 
+                                          CAN_RxFilterAccept() */
+} CAN_FilterResult_t;
+
 /**
  *  @brief CAN massage info structure
  */
@@ -377,6 +445,107 @@ typedef struct
     uint8_t dataLen;                    /*!< Length of data in bytes */    
 } CAN_MsgBuf_t;
 
+/** 
+ * @brief CAN locked message buffer view. The data words are in MB RAM and 
+ *        are valid until the MB is released.
+ */
+typedef struct
+{
+    uint32_t cs;                        /*!< Code and Status*/
+    uint32_t msgId;                     /*!< Message ID*/    
+    const volatile uint32_t *data;      /*!< Data words of the CAN message in
+                                             MB RAM, byte 0 is the most 
+                                             significant byte of word 0 */
+    uint8_t dataLen;                    /*!< Length of data in bytes */    
+} CAN_MbView_t;
+
+/** 
+ * @brief CAN RX ring frame structure
+ */
+typedef struct
+{
+    CAN_MsgBuf_t msg;                   /*!< The received frame */
+    uint16_t timeStamp;                 /*!< Value of the free running timer
+                                             (CAN_TIMER) latched by hardware
+                                             when the frame was received */
+    uint8_t mbIdx;                      /*!< MB index the frame was received
+                                             in, or CAN_RX_RING_FIFO_IDX if it
+                                             was read from RX FIFO */
+} CAN_RxFrame_t;
+
+/** 
+ * @brief CAN TX queue frame structure
+ */
+typedef struct
+{
+    CAN_MessageInfo_t txInfo;           /*!< TX MB info */
+    uint32_t msgId;                     /*!< Message ID */
+    uint8_t data[64];                   /*!< Data bytes of the CAN message */
+    uint8_t localPrio;                  /*!< Local priority field, it is used
+                                             when the TX priority mode is 
+                                             CAN_TX_PRI_LOCAL_PRI_EN */
+    uint16_t next;                      /*!< For driver internal use */
+    uint16_t timeStamp;                 /*!< For driver internal use */
+} CAN_TxQueueFrame_t;
+
+/** 
+ * @brief CAN TX queue configuration
+ */
+typedef struct
+{
+    CAN_TxQueueFrame_t *frameBuf;       /*!< Frame storage of the TX queue */
+    uint16_t frameNum;                  /*!< Number of frames in frameBuf */
+    uint8_t firstMb;                    /*!< First MB of the TX MB pool */
+    uint8_t mbNum;                      /*!< Number of MBs in the TX MB pool,
+                                             1 ~ CAN_TX_QUEUE_MB_MAX */
+} CAN_TxQueueConfig_t;
+
+/** 
+ * @brief CAN TX queue status
+ */
+typedef struct
+{
+    uint32_t depth;                     /*!< Frames waiting for a TX MB */
+    uint32_t maxDepth;                  /*!< Maximum depth since configured */
+    uint32_t sentCnt;                   /*!< Frames transmitted */
+    uint32_t dropCnt;                   /*!< Frames dropped because the queue 
+                                             was full or the frame could not
+                                             be loaded into a MB */
+    uint32_t abortCnt;                  /*!< Frames aborted and requeued to
+                                             give the TX MB to a higher 
+                                             priority frame */
+} CAN_TxQueueStatus_t;
+
+/** 
+ * @brief CAN statistics. Times are in CAN_TIMER ticks (nominal bit times).
+ */
+typedef struct
+{
+    uint32_t txFrameCnt;                /*!< Frames transmitted */
+    uint32_t rxFrameCnt;                /*!< Frames received */
+    uint32_t txByteCnt;                 /*!< Data bytes transmitted */
+    uint32_t rxByteCnt;                 /*!< Data bytes received */
+    uint32_t busBitCnt;                 /*!< Estimated bits of the frames 
+                                             transmitted and received, without
+                                             stuff bits, FD data phase counted
+                                             at nominal bit rate */
+    uint32_t busOffCnt;                 /*!< Bus off events */
+    uint32_t errIntCnt;                 /*!< Error interrupts */
+    uint32_t stuffErrCnt;               /*!< Stuff errors */
+    uint32_t formErrCnt;                /*!< Form errors */
+    uint32_t crcErrCnt;                 /*!< CRC errors */
+    uint32_t ackErrCnt;                 /*!< ACK errors */
+    uint32_t bitErrCnt;                 /*!< Bit0/bit1 errors */
+    uint32_t txLatencyHist[8];          /*!< TX latency from send (or TX queue
+                                             send) to transmission, bin 0: 
+                                             < 128 ticks, bin n: < 128 << n 
+                                             ticks, bin 7: >= 8192 ticks */
+    uint32_t isrCnt;                    /*!< MB interrupts handled */
+    uint32_t isrTimeSum;                /*!< Sum of MB interrupt handling time*/
+    uint16_t isrTimeMax;                /*!< Max MB interrupt handling time */
+    uint16_t timeStamp;                 /*!< CAN_TIMER value of the snapshot */
+} CAN_Stats_t;
+
 /** 
  * @brief CAN configuration
  */
@@ -502,6 +671,16 @@ typedef void (*can_mb_cb_t)(uint32_t mbIdx);
 
 #define CAN_ABORT_EN                (1U)
 
+#define CAN_STATS_EN                (0U)    /*!< 1: record CAN statistics */
+
+#define CAN_RX_RING_FIFO_IDX        (0xFFU) /*!< mbIdx of frames read from 
+                                                 RX FIFO */
+#define CAN_TX_QUEUE_MB_MAX         (16U)   /*!< max MB number in TX MB pool */
+
+/*!< get data byte (index) of a locked MB view */
+#define CAN_MB_VIEW_BYTE(view, index)   \
+    ((uint8_t)((view)->data[(index) >> 2U] >> ((3U - ((index) & 3U)) << 3U)))
+
 /** @} end of group CAN_Public_Constants */
 
 /** @defgroup CAN_Public_Macro
@@ -840,6 +1019,50 @@ ResultStatus_t CAN_ConfigRxMb(CAN_Id_t id, uint8_t mbIdx,
  */
 ResultStatus_t CAN_ConfigRxFifo(CAN_Id_t id, CAN_RxFifoIdFormat_t format,
                                 const CAN_IdFilter_t *idFilterTable);
+
+/**
+ * @brief      Compile acceptance filter rules into the RX FIFO ID filter table
+ *             and individual masks. The ID filter format (A/B/C) accepting the
+ *             fewest IDs outside of the rules is selected. If the rules do not
+ *             fit the ID filter table exactly, the closest superset is set in 
+ *             hardware and the rules are kept in a software filter checked by
+ *             CAN_RxFilterAccept().
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  rules: points to the filter rules
+ * @param[in]  ruleNum: number of rules. 0 rejects all frames.
+ * @param[in]  mem: points to the filter memory
+ * @param[out] result: points to the address where the result will be stored,
+ *                     it can be NULL
+ *
+ * @note       RX FIFO shall be enabled and the RX individual mask type 
+ *             selected. It runs in O(n^3) of the entry number and is meant to
+ *             be called at initialization.
+ *
+ * @return     status
+ *             - SUCC -- successful
+ *             - ERR -- some error
+ *
+ */
+ResultStatus_t CAN_CompileRxFilter(CAN_Id_t id, const CAN_FilterRuleCfg_t *rules,
+                                   uint32_t ruleNum, const CAN_FilterMem_t *mem,
+                                   CAN_FilterResult_t *result);
+
+/**
+ * @brief      Check a received frame ID against the software filter set by
+ *             CAN_CompileRxFilter(). The RX ring drops the RX FIFO frames 
+ *             rejected by it.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  idType: standard or extended ID
+ * @param[in]  msgId: the received ID
+ *
+ * @return     SET: the frame is accepted, or no software filter is used
+ *             RESET: the frame is rejected
+ *
+ */
+FlagStatus_t CAN_RxFilterAccept(CAN_Id_t id, CAN_MsgId_t idType, 
+                                uint32_t msgId);
                       
 /**
  * @brief      Get a message buffer field values.
@@ -859,6 +1082,36 @@ ResultStatus_t CAN_ConfigRxFifo(CAN_Id_t id, CAN_RxFifoIdFormat_t format,
  */
 ResultStatus_t CAN_GetMsgBuff(CAN_Id_t id, uint32_t mbIdx, CAN_MsgBuf_t *msgBuff);
 
+/**
+ * @brief      Lock a message buffer and get a view of it without copying the
+ *             payload. The data can be read from view->data or with 
+ *             CAN_MB_VIEW_BYTE() until CAN_ReleaseMb() is called.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  mbIdx: MB index. The MB should not be occupied by RX FIFO if RX
+ *                    FIFO is enabled, othersise, it will return ERR.
+ * @param[out] view: points to the address where the MB view will be stored 
+ *
+ * @note       Only one MB of a CAN instance can be locked. Accessing another 
+ *             MB, including from the MB interrupts, releases the lock.
+ *
+ * @return     status
+ *             - SUCC -- the MB is locked
+ *             - ERR -- some error
+ *
+ */
+ResultStatus_t CAN_LockMb(CAN_Id_t id, uint32_t mbIdx, CAN_MbView_t *view);
+
+/**
+ * @brief      Release the message buffer locked by CAN_LockMb().
+ *
+ * @param[in]  id: select the CAN ID
+ *
+ * @return     none
+ *
+ */
+void CAN_ReleaseMb(CAN_Id_t id);
+
 /**
  * @brief      Read a frame in RX FIFO.
  *
@@ -871,6 +1124,98 @@ ResultStatus_t CAN_GetMsgBuff(CAN_Id_t id, uint32_t mbIdx, CAN_MsgBuf_t *msgBuff
  */
 void CAN_ReadRxFifo(CAN_Id_t id, CAN_MsgBuf_t *msgBuff);
 
+/**
+ * @brief      Config the RX ring of a CAN instance. When the RX ring is 
+ *             configured, the MB interrupt handlers copy every received frame
+ *             of the RX MBs and the RX FIFO into the ring and free the MB 
+ *             immediately. The frames are then read with CAN_ReceiveBatch().
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  frameBuf: points to the frame storage of the ring. NULL 
+ *                       disables the RX ring.
+ * @param[in]  frameNum: number of frames in frameBuf, it shall be a power 
+ *                       of 2.
+ *
+ * @note       It shall be called while the MB interrupts are masked.
+ *
+ * @return     status
+ *             - SUCC -- successful
+ *             - ERR -- frameNum is not a power of 2
+ *
+ */
+ResultStatus_t CAN_RxRingConfig(CAN_Id_t id, CAN_RxFrame_t *frameBuf, 
+                                uint32_t frameNum);
+
+/**
+ * @brief      Read the received frames out of the RX ring.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[out] frames: points to the buffer where the frames will be stored
+ * @param[in]  maxNum: the maximum number of frames to be read
+ *
+ * @return     the number of frames read
+ *
+ */
+uint32_t CAN_ReceiveBatch(CAN_Id_t id, CAN_RxFrame_t *frames, uint32_t maxNum);
+
+/**
+ * @brief      Get the number of frames dropped because the RX ring was full.
+ *
+ * @param[in]  id: select the CAN ID
+ *
+ * @return     the number of dropped frames
+ *
+ */
+uint32_t CAN_GetRxRingDropCount(CAN_Id_t id);
+
+/**
+ * @brief      Config the TX queue of a CAN instance. Frames sent through 
+ *             CAN_TxQueueSend() are ordered according to the TX priority mode
+ *             selected by CAN_SelectTxPriorityMode(), and loaded into the free
+ *             MBs of the TX MB pool. The pool MBs are refilled from their TX
+ *             complete interrupts.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  config: points to the TX queue configuration. NULL disables 
+ *                     the TX queue.
+ *
+ * @return     status
+ *             - SUCC -- successful
+ *             - ERR -- some error
+ *
+ */
+ResultStatus_t CAN_TxQueueConfig(CAN_Id_t id, const CAN_TxQueueConfig_t *config);
+
+/**
+ * @brief      Put a frame into the TX queue.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  txInfo: TX MB info
+ * @param[in]  msgId: message ID
+ * @param[in]  msgData: data of the message
+ * @param[in]  localPrio: the local priority field for the MB
+ *
+ * @return     status
+ *             - SUCC -- the frame is queued or loaded into a TX MB
+ *             - ERR -- the TX queue is not configured or txInfo is invalid
+ *             - BUSY -- the TX queue is full, the frame is dropped
+ *
+ */
+ResultStatus_t CAN_TxQueueSend(CAN_Id_t id, const CAN_MessageInfo_t *txInfo,
+                               uint32_t msgId, const uint8_t *msgData, 
+                               uint8_t localPrio);
+
+/**
+ * @brief      Get the TX queue status.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[out] status: points to the address where the status will be stored
+ *
+ * @return     none
+ *
+ */
+void CAN_GetTxQueueStatus(CAN_Id_t id, CAN_TxQueueStatus_t *status);
+
 /**
  * @brief      Sets the Rx masking type.
  *
@@ -1667,6 +2012,33 @@ void CAN_BusOffRecoveryScheme(CAN_Id_t id, CAN_BusOffRecovery_t recov);
  */
 void CAN_RecoverFromBusOffManually(CAN_Id_t id);
 
+#if (1U == CAN_STATS_EN)
+/**
+ * @brief      Get a snapshot of the CAN statistics. Interrupts are disabled
+ *             only while the statistics are copied.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[out] stats: points to the address where the statistics will be 
+ *                    stored
+ *
+ * @note  This function is available only when CAN_STATS_EN = 1U
+ * @return     none
+ *
+ */
+void CAN_GetStats(CAN_Id_t id, CAN_Stats_t *stats);
+
+/**
+ * @brief      Clear the CAN statistics.
+ *
+ * @param[in]  id: select the CAN ID
+ *
+ * @note  This function is available only when CAN_STATS_EN = 1U
+ * @return     none
+ *
+ */
+void CAN_ClearStats(CAN_Id_t id);
+#endif
+
 /** @} end of group CAN_Public_FunctionDeclaration */
 
 /** @} end of group CAN  */
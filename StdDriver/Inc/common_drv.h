@@ -658,6 +658,34 @@ LOCAL_INLINE uint32_t COMMON_GetFPSCR(void)
 #endif
 }
 
+/**
+ * @brief     Reverse the byte order of a word (REV instruction)
+ * @param[in] value: the word to be reversed
+ * @return    result: the word with reversed byte order
+ */
+LOCAL_INLINE uint32_t COMMON_ReverseBytes(uint32_t value)
+{
+    uint32_t result;
+
+    ASM_KEYWORD("REV %0, %1" : "=r" (result) : "r" (value) );
+
+    return (result);
+}
+
+/**
+ * @brief     Count the leading zero bits of a word (CLZ instruction)
+ * @param[in] value: the word to be counted
+ * @return    result: number of leading zero bits, 32 if value is 0
+ */
+LOCAL_INLINE uint32_t COMMON_CountLeadingZeros(uint32_t value)
+{
+    uint32_t result;
+
+    ASM_KEYWORD("CLZ %0, %1" : "=r" (result) : "r" (value) );
+
+    return (result);
+}
+
 /** @} end of group COMMON_Public_FunctionDeclaration */
 
 /** @} end of group COMMON_DRV  */
@@ -313,6 +313,36 @@ typedef struct
                                                      - DISABLE: enable channel request after done */
 } DMA_TransferConfig_t;
 
+/**
+ *  @brief DMA chain node type definition
+ */
+typedef struct DMA_ChainNode_s DMA_ChainNode_t;
+
+/**
+ *  @brief DMA chain node done callback type definition
+ */
+typedef void (dma_chain_cb_t)(DMA_Channel_t channel, const DMA_ChainNode_t *node);
+
+/**
+ *  @brief DMA chain node (software descriptor)
+ *
+ *  The register fields hold the pre-encoded channel register image and are
+ *  filled by DMA_ChainNodeInit(). The user links nodes through next: NULL
+ *  ends the chain, pointing back to an earlier node makes it circular.
+ */
+struct DMA_ChainNode_s
+{
+    uint32_t saddr;                             /*!< DMA_SADDR register image */
+    uint32_t daddr;                             /*!< DMA_DADDR register image */
+    uint32_t aoff;                              /*!< DMA_AOFF register image */
+    uint32_t mlaoff;                            /*!< DMA_MLAOFF register image */
+    uint32_t num;                               /*!< DMA_NUM register image */
+    uint32_t iter;                              /*!< DMA_ITER register image */
+    uint32_t cs;                                /*!< DMA_CS register image */
+    dma_chain_cb_t *callback;                   /*!< called when this node is done, NULL if not used */
+    DMA_ChainNode_t *next;                      /*!< next node to load, NULL ends the chain */
+};
+
 /** @} end of group DMA_Public_Types */
 
 /** @defgroup DMA_Public_Constants
@@ -838,6 +868,67 @@ void DMA_InstallCallBackFunc(DMA_Channel_t channel, DMA_Int_t intType,
  *******************************************************************************/
 ResultStatus_t DMA_ConfigTransfer(const DMA_TransferConfig_t * config);
 
+/****************************************************************************//**
+ * @brief      Dma chain node init Function
+ *
+ * @param[out] node:     Pointer to the chain node to be initialized.
+ * @param[in]  config:   Pointer to dma transfer configuration of this node. The
+ *                       channel, priority, preempt, source and
+ *                       disableRequestAfterDoneCmd members are not used.
+ * @param[in]  callback: function called when this node is done, can be NULL.
+ *
+ * @return function execution result
+ *             - SUCC: node is encoded, node->next is set to NULL
+ *             - ERR: alignment or size check of config fails
+ *
+ *******************************************************************************/
+ResultStatus_t DMA_ChainNodeInit(DMA_ChainNode_t *node, 
+                                 const DMA_TransferConfig_t * config,
+                                 dma_chain_cb_t *callback);
+
+/****************************************************************************//**
+ * @brief      Dma chain start Function
+ *
+ * @param[in]  channel: dma channel id
+ * @param[in]  head:    first node of the chain
+ *
+ * @return function execution result
+ *             - SUCC: first node is loaded and channel is started
+ *             - BUSY: a chain is already running on this channel
+ *
+ * @note       The request source and priority of the channel shall be set
+ *             before, e.g. by DMA_ConfigTransfer() with the first node's
+ *             configuration, and the channel done interrupt shall be enabled
+ *             in NVIC. The done interrupt of the channel loads the next node,
+ *             so DMA_InstallCallBackFunc() done callback is not called while
+ *             the chain is running.
+ *
+ *******************************************************************************/
+ResultStatus_t DMA_ChainStart(DMA_Channel_t channel, DMA_ChainNode_t *head);
+
+/****************************************************************************//**
+ * @brief      Dma chain stop Function
+ *
+ * @param[in]  channel: dma channel id
+ *
+ * @return none
+ *
+ * @note       The channel request is disabled; a minor loop in progress still
+ *             completes.
+ *
+ *******************************************************************************/
+void DMA_ChainStop(DMA_Channel_t channel);
+
+/****************************************************************************//**
+ * @brief      Get dma chain current node Function
+ *
+ * @param[in]  channel: dma channel id
+ *
+ * @return the node being transferred, NULL if no chain is running
+ *
+ *******************************************************************************/
+DMA_ChainNode_t *DMA_ChainGetNode(DMA_Channel_t channel);
+
 /** @} end of group DMA_Public_FunctionDeclaration */
 
 /** @} end of group DMA  */
@@ -0,0 +1,177 @@
+/**************************************************************************************************/
+/**
+ * @file     eeprom_drv.h
+ * @brief    EEPROM emulation module header file.
+ * @version  V1.0.0
+ * @date     December-2022
+ * @author   Zhixin Semiconductor
+ *
+ * @note
+ * Copyright (C) 2021-2023 Zhixin Semiconductor Ltd. All rights reserved.
+ *
+ **************************************************************************************************/
+
+#ifndef EEPROM_DRV_H
+#define EEPROM_DRV_H
+
+#include "common_drv.h"
+#include "flash_drv.h"
+#include "crc_drv.h"
+
+/** @addtogroup  Z20K14XM_Peripheral_Driver
+ *  @{
+ */
+
+/** @addtogroup  EEPROM
+ *  @{
+ */
+
+/** @defgroup EEPROM_Public_Types
+ *  @{
+ */
+
+/**
+ *  @brief number of data bytes carried by one record. Each record occupies
+ *         one 16-byte flash phrase: 2-byte id, data and 2-byte CRC.
+ */
+#define EEPROM_DATA_SIZE     12U
+
+/**
+ *  @brief number of flash operations failing in a row after which the store
+ *         is stopped until EEPROM_Init() is called again
+ */
+#define EEPROM_RETRY_MAX     3U
+
+/**
+ *   @brief Asynchronous write completion call back function pointer type
+ *   - id: id of the record written
+ *   - result: SUCC if the record is stored, ERR otherwise
+ */
+typedef void (* eeprom_cb_t)(uint16_t id, ResultStatus_t result);
+
+/**
+ * @brief EEPROM emulation Configuration Structure
+ */
+typedef struct
+{
+    uint32_t baseAddr;      /*!< start address of the first flash sector used,
+                                 normally in data flash (FLASH_DATA_BASE_ADDR) */
+    uint32_t sectorSize;    /*!< flash sector size in bytes */
+    uint32_t sectorNum;     /*!< number of consecutive sectors used. It should
+                                 be at least 3 */
+    uint32_t *index;        /*!< RAM index with indexNum entries. Entry n holds
+                                 the flash address of the newest record of id n.
+                                 It is filled by EEPROM_Init() */
+    uint16_t indexNum;      /*!< number of record ids, valid ids are
+                                 0 .. indexNum - 1. It should be less than
+                                 (sectorNum - 2) * (sectorSize / 16 - 1) */
+} EEPROM_Config_t;
+
+/** @} end of group EEPROM_Public_Types */
+
+/** @defgroup EEPROM_Public_FunctionDeclaration
+ *  @brief EEPROM emulation functions declaration
+ *  @{
+ */
+
+/**
+ * @brief      Initialize the EEPROM emulation. The sector headers and records
+ *             are scanned once to rebuild the RAM index, sectors left by an
+ *             interrupted erase or sector swap are erased. If no valid sector
+ *             is found, all sectors are erased and the store is formatted.
+ *
+ * @param[in]  config: points to the configuration structure. config->index
+ *                     shall stay valid while the store is used.
+ *
+ * @note       CRC module clock shall be enabled. CRC module is configured by
+ *             this module before each record CRC calculation, other users of
+ *             CRC module shall call CRC_Init() before their own calculation.
+ *             Multi-bit ECC bus error is disabled for the emulation area so
+ *             that records torn by a power loss can be read and discarded.
+ *             The single FLASH_IgnoreBusErrorConfig() window is used for it,
+ *             a window set by the application is replaced.
+ *
+ * @return     - SUCC -- successful
+ *             - ERR -- parameter error or flash command error
+ *
+ */
+ResultStatus_t EEPROM_Init(const EEPROM_Config_t *config);
+
+/**
+ * @brief      Read the newest data of a record. The flash address is taken
+ *             from the RAM index, flash is not scanned.
+ *
+ * @param[in]  id: record id
+ * @param[out] data: points to EEPROM_DATA_SIZE bytes where the data will be
+ *                   stored
+ *
+ * @return     - SUCC -- successful
+ *             - ERR -- invalid id or the record has never been written
+ *             - BUSY -- a flash command is executing, try again later
+ *
+ */
+ResultStatus_t EEPROM_Read(uint16_t id, uint8_t data[]);
+
+/**
+ * @brief      Write a record and wait until it is programmed. A compaction
+ *             that is needed to get free space is also finished here.
+ *
+ * @param[in]  id: record id
+ * @param[in]  data: points to EEPROM_DATA_SIZE bytes to be written
+ *
+ * @note       if an asynchronous operation is in progress, FLASH command
+ *             complete interrupt shall be able to preempt the caller.
+ *
+ * @return     - SUCC -- successful
+ *             - ERR -- invalid parameter, flash program error or the store
+ *                      is stopped after EEPROM_RETRY_MAX flash errors in a row
+ *
+ */
+ResultStatus_t EEPROM_Write(uint16_t id, const uint8_t data[]);
+
+/**
+ * @brief      Queue a record to be written by EEPROM_MainFunction(). The
+ *             data is copied, so the buffer can be reused on return. Until it
+ *             is programmed, EEPROM_Read() returns the queued data.
+ *
+ * @param[in]  id: record id
+ * @param[in]  data: points to EEPROM_DATA_SIZE bytes to be written
+ * @param[in]  callBack: called from EEPROM_MainFunction() when the record is
+ *                       programmed. It can be NULL.
+ *
+ * @return     - SUCC -- the write is queued
+ *             - ERR -- invalid parameter or the store is stopped
+ *             - BUSY -- last queued write is not finished
+ *
+ */
+ResultStatus_t EEPROM_WriteAsync(uint16_t id, const uint8_t data[],
+                                 eeprom_cb_t callBack);
+
+/**
+ * @brief      EEPROM emulation background process. It shall be called
+ *             periodically. Each call checks the flash command started by the
+ *             last call and starts at most one new flash command by
+ *             FLASH_ProgramAsync()/FLASH_EraseAsync(): queued write,
+ *             sector swap or one step of the sector compaction.
+ *
+ * @param[in]  none
+ *
+ * @note       FLASH command complete interrupt shall be enabled. This function
+ *             and the write functions shall be called from the same context.
+ *
+ * @return     - SUCC -- no more work pending
+ *             - ERR -- the flash command finished in this call failed, or
+ *                      the store is stopped after EEPROM_RETRY_MAX flash
+ *                      errors in a row. EEPROM_Init() restarts it.
+ *             - BUSY -- work is pending
+ *
+ */
+ResultStatus_t EEPROM_MainFunction(void);
+
+/** @} end of group EEPROM_Public_FunctionDeclaration */
+
+/** @} end of group EEPROM */
+
+/** @} end of group Z20K14XM_Peripheral_Driver */
+
+#endif /* EEPROM_DRV_H */
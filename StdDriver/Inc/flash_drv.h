@@ -121,6 +121,42 @@ typedef struct
 
 } FLASH_EccState_t;
 
+/**
+ *  @brief FLASH asynchronous operation state type definition
+ */
+typedef enum
+{
+    FLASH_ASYNC_IDLE = 0U,    /*!< no asynchronous operation has been started */
+    FLASH_ASYNC_BUSY,         /*!< asynchronous operation is in progress */
+    FLASH_ASYNC_DONE,         /*!< asynchronous operation finished successfully */
+    FLASH_ASYNC_ERR           /*!< asynchronous operation stopped on an error */
+}FLASH_AsyncState_t;
+
+/** 
+ *   @brief Asynchronous operation completion call back function pointer type
+ *   It is called from the command complete interrupt once the whole operation
+ *   is finished or stopped on an error.
+ *   - result: SUCC when all commands completed, ERR otherwise
+ *   - errStatus: FSTAT error flags (FLASH_STATUS_FAIL_MASK,
+ *                FLASH_STATUS_CMDABT_MASK, FLASH_STATUS_ACCERR_MASK,
+ *                FLASH_STATUS_PREABT_MASK) of the failed command, 0 on success
+ */
+typedef void (* flash_async_cb_t)(ResultStatus_t result, uint32_t errStatus);
+
+/**
+ * @brief Flash asynchronous operation status Structure
+ */
+typedef struct
+{
+    FLASH_AsyncState_t state;   /*!< state of the last asynchronous operation */
+    uint32_t totalLen;          /*!< number of bytes requested. For erase it
+                                     is 0 */
+    uint32_t doneLen;           /*!< number of bytes already programmed */
+    uint32_t errAddr;           /*!< address of the failed command, only valid
+                                     in FLASH_ASYNC_ERR state */
+    uint32_t errStatus;         /*!< FSTAT error flags of the failed command */
+} FLASH_AsyncStatus_t;
+
 /** @} end of group FLASH_Public_Types */
 
 /** @defgroup FLASH_Public_Constants
@@ -446,6 +482,62 @@ ResultStatus_t FLASH_EraseAll(const FLASH_CmdConfig_t *config);
  */
 ResultStatus_t FLASH_EraseSector(uint32_t addr, const FLASH_CmdConfig_t *config);
 
+/**
+ * @brief      program flash memory asynchronously. The first phrase is issued
+ *             here, every following phrase is issued from the command complete
+ *             interrupt, so the CPU is free while the flash is busy.
+ *
+ * @param[in] flashAddr: start address of flash memory. It is the start address of 
+ *                   a phrase. This address should be aligned to 4 words(16 bytes)
+ * @param[in] len: length in byte to be programmed.
+ *                 This length should be aligned to 4 words(16 bytes).
+ * @param[in] dataP: points to the source buffer from which data is taken 
+ *                     for program operation. It shall stay valid until the
+ *                     operation is finished.
+ * @param[in]  callBack: called when the operation is finished. It can be NULL,
+ *                       FLASH_GetAsyncStatus() can then be used to poll.
+ *
+ * @note       FLASH command complete interrupt shall be enabled in NVIC. The
+ *             CCIF callback installed by FLASH_InstallCallBackFunc() is not
+ *             called for asynchronous operations. The code executed while the
+ *             operation is in progress must not be placed in the flash block
+ *             being programmed.
+ *
+ * @return     - SUCC -- the operation is started
+ *             - ERR -- parameter error
+ *             - BUSY -- flash is executing last command or an asynchronous
+ *                       operation is in progress.
+ *
+ */
+ResultStatus_t FLASH_ProgramAsync(uint32_t flashAddr, uint32_t len,
+                                  const uint8_t *dataP, flash_async_cb_t callBack);
+
+/**
+ * @brief      Erase a flash sector asynchronously. Completion is reported
+ *             from the command complete interrupt.
+ *
+ * @param[in]  addr: sector start address
+ * @param[in]  callBack: called when the erase is finished. It can be NULL.
+ *
+ * @note       the same restrictions as FLASH_ProgramAsync() apply.
+ *
+ * @return     - SUCC -- the operation is started
+ *             - BUSY -- flash is executing last command or an asynchronous
+ *                       operation is in progress.
+ *
+ */
+ResultStatus_t FLASH_EraseAsync(uint32_t addr, flash_async_cb_t callBack);
+
+/**
+ * @brief      Get the status and progress of the last asynchronous operation
+ *
+ * @param[out] status: points to the status structure to be filled
+ *
+ * @return     none
+ *
+ */
+void FLASH_GetAsyncStatus(FLASH_AsyncStatus_t *status);
+
 /**
  * @brief      Flash enters security mode. In this mdoe, debug Port is prevented
  *             to read any AHB-AP memory-map addresses
@@ -15,6 +15,7 @@
 #define I2C_DRV_H
 
 #include "common_drv.h"
+#include "dma_drv.h"
 
 /** @addtogroup  Z20K14XM_Peripheral_Driver
  *  @{
@@ -329,11 +330,72 @@ typedef struct
     uint32_t i2cDmaRecvReqLevel;          /*!< DMA Receive data level, the valid range is 0 - 3 */
 } I2C_DmaConfig_t;
 
+/**
+ *  @brief I2C master transfer done callback type definition
+ *
+ *  errorStatus is 0 when the transfer succeeded, otherwise the abort causes
+ *  with bit n set for I2C_ErrorStatus_t value n.
+ */
+typedef void (i2c_xfer_cb_t)(I2C_Id_t i2cNo, uint32_t errorStatus);
+
+/**
+ *  @brief I2C polled device statistics. Latency is the number of scheduler
+ *         ticks from the poll being due until it is done.
+ */
+typedef struct
+{
+    uint32_t pollCnt;               /*!< polls done */
+    uint32_t errorCnt;              /*!< polls ended with an error */
+    uint32_t lastError;             /*!< error status of the last failed poll */
+    uint32_t latencyMin;            /*!< minimum poll latency */
+    uint32_t latencyMax;            /*!< maximum poll latency */
+} I2C_PollStats_t;
+
+/**
+ *  @brief I2C polled device. The fields after stats are used by the
+ *         scheduler.
+ */
+typedef struct
+{
+    uint32_t slaveAddr;             /*!< slave address */
+    const uint8_t *txData;          /*!< bytes written, e.g. register address */
+    uint32_t txLen;                 /*!< number of bytes written */
+    uint8_t *rxData;                /*!< memory for the bytes read */
+    uint32_t rxLen;                 /*!< number of bytes read */
+    uint32_t period;                /*!< poll period in ticks, 1 or more */
+    uint32_t phase;                 /*!< tick of the first poll, spreads
+                                         devices of the same period */
+    I2C_PollStats_t stats;          /*!< statistics */
+    uint32_t dueTick;               /*!< tick the next poll is due */
+    uint32_t pendTick;              /*!< tick the pending poll was due */
+    FlagStatus_t pending;           /*!< a poll is waiting for the bus */
+} I2C_PollDevice_t;
+
+/**
+ *  @brief I2C poll done callback type definition, devIdx is the index of
+ *         the device in the schedule.
+ */
+typedef void (i2c_poll_cb_t)(I2C_Id_t i2cNo, uint32_t devIdx,
+                             uint32_t errorStatus);
+
+/**
+ *  @brief I2C poll schedule type definition
+ */
+typedef struct
+{
+    I2C_PollDevice_t *devices;      /*!< polled devices */
+    uint32_t deviceNum;             /*!< number of devices */
+    uint32_t timeout;               /*!< ticks a poll may take before the bus
+                                         is recovered, 0 if not used */
+    i2c_poll_cb_t *callback;        /*!< poll done callback, can be NULL */
+} I2C_PollSchedule_t;
+
 /** @} end of group I2C_Public_Types definitions */
 
 /** @defgroup I2C_Public_Constants
  *  @{
  */
+#define I2C_POLL_ERR_TIMEOUT  (0x80000000UL)  /*!< poll error status: timeout */
 
 /** @} end of group I2C_Public_Constants definitions*/
 
@@ -974,6 +1036,157 @@ uint32_t I2C_ErrorFlushCount(I2C_Id_t i2cNo);
  */
 FlagStatus_t I2C_GetStatus(I2C_Id_t i2cNo, I2C_Status_t statusType);
 
+/**
+ * @brief      Start a master write-then-read transfer driven by interrupt.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  slaveAddr: The slave address.
+ * @param[in]  txData: The bytes to be written, e.g. register address and
+ *                     data.
+ * @param[in]  txLen: The number of bytes to be written, can be 0.
+ * @param[out] rxData: The memory for the bytes to be read.
+ * @param[in]  rxLen: The number of bytes to be read after a RESTART, can
+ *                    be 0.
+ * @param[in]  callback: Called in interrupt when the STOP is detected, can
+ *                       be NULL.
+ *
+ * @return     status
+ *             - SUCC : the transfer is started
+ *             - BUSY : a transfer is in progress
+ *             - ERR : both txLen and rxLen are 0
+ *
+ * The I2C shall be initialized as master with RESTART enabled and the I2C
+ * IRQ enabled in NVIC. The interrupts used by the transfer are restored to
+ * their previous state when it is done.
+ */
+ResultStatus_t I2C_MasterTransferAsync(I2C_Id_t i2cNo, uint32_t slaveAddr,
+                                       const uint8_t txData[], uint32_t txLen,
+                                       uint8_t rxData[], uint32_t rxLen,
+                                       i2c_xfer_cb_t * callback);
+
+/**
+ * @brief      Get the status of I2C_MasterTransferAsync().
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     - SET : the transfer is in progress
+ *             - RESET : no transfer is in progress
+ *
+ */
+FlagStatus_t I2C_MasterGetTransferStatus(I2C_Id_t i2cNo);
+
+/**
+ * @brief      Select the DMA channels of I2C_MasterDmaTransfer().
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  txChannel: DMA channel writing the command stream.
+ * @param[in]  rxChannel: DMA channel collecting the read bytes.
+ *
+ * @return     status
+ *             - SUCC
+ *             - BUSY : a transfer is in progress
+ *
+ */
+ResultStatus_t I2C_MasterDmaChannelConfig(I2C_Id_t i2cNo, 
+                                          DMA_Channel_t txChannel,
+                                          DMA_Channel_t rxChannel);
+
+/**
+ * @brief      Start a master write-then-read transfer moved by DMA.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  slaveAddr: The slave address.
+ * @param[in]  txData: The bytes to be written.
+ * @param[in]  txLen: The number of bytes to be written, can be 0.
+ * @param[out] rxData: The memory for the bytes to be read.
+ * @param[in]  rxLen: The number of bytes to be read after a RESTART, can
+ *                    be 0.
+ * @param[out] cmdBuf: Memory for the command stream, txLen + rxLen words.
+ * @param[in]  callback: Called in interrupt when the transfer is done, can
+ *                       be NULL.
+ *
+ * @return     status
+ *             - SUCC : the transfer is started
+ *             - BUSY : a transfer is in progress
+ *             - ERR : no data, or more than 32767 bytes in total
+ *
+ * The I2C_COMMAND_DATA words (data bytes, then read commands with RESTART
+ * and STOP bits) are generated into cmdBuf and fed by the TX DMA channel,
+ * the read bytes are collected by the RX DMA channel. The CPU only runs at
+ * start, at STOP_DET and at the RX DMA done interrupt, which shall be
+ * enabled in NVIC with the I2C IRQ. Abort causes are reported as for
+ * I2C_MasterTransferAsync(). HOLD_EN_RXFIFO_FULL is enabled so a late RX
+ * DMA holds the bus instead of losing bytes. cmdBuf and the buffers shall
+ * be kept until the callback.
+ */
+ResultStatus_t I2C_MasterDmaTransfer(I2C_Id_t i2cNo, uint32_t slaveAddr,
+                                     const uint8_t txData[], uint32_t txLen,
+                                     uint8_t rxData[], uint32_t rxLen,
+                                     uint32_t cmdBuf[], 
+                                     i2c_xfer_cb_t * callback);
+
+/**
+ * @brief      Start the periodic poll schedule of an I2C master.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  schedule: The poll schedule, it shall be kept until stopped.
+ *
+ * @return     status
+ *             - SUCC : the schedule is started
+ *             - ERR : invalid device, a schedule or a transfer is running
+ *
+ * I2C_PollScheduleTick() shall be called periodically from a timer
+ * interrupt with the same priority as the I2C interrupt. Polls due at the
+ * same tick are run back-to-back from the transfer done interrupt through
+ * I2C_MasterTransferAsync(); the target address is only rewritten when it
+ * changes. After an SDA stuck timeout the SDA recovery is run, after other
+ * aborts (NACK excluded) or a timeout the module is re-enabled; the bus
+ * recover feature is enabled while the schedule runs.
+ */
+ResultStatus_t I2C_PollScheduleStart(I2C_Id_t i2cNo,
+                                     const I2C_PollSchedule_t * schedule);
+
+/**
+ * @brief      Stop the poll schedule, a running poll is finished.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     none
+ *
+ */
+void I2C_PollScheduleStop(I2C_Id_t i2cNo);
+
+/**
+ * @brief      Advance the poll schedule by one tick.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     none
+ *
+ */
+void I2C_PollScheduleTick(I2C_Id_t i2cNo);
+
+/**
+ * @brief      Get the number of bus recoveries run by the poll schedule.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     The number of recoveries.
+ *
+ */
+uint32_t I2C_PollGetRecoverCount(I2C_Id_t i2cNo);
+
+/**
+ * @brief      Get the number of polls skipped as the previous one of the
+ *             same device was still waiting for the bus.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     The number of skipped polls.
+ *
+ */
+uint32_t I2C_PollGetOverrunCount(I2C_Id_t i2cNo);
+
 /** @} end of group I2C_Public_FunctionDeclaration */
 
 /** @} end of group I2C  */
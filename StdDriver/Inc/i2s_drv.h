@@ -15,6 +15,7 @@
 #define I2S_DRV_H
 
 #include "common_drv.h"
+#include "dma_drv.h"
 
 /** @addtogroup  Z20K14XM_Peripheral_Driver
  *  @{
@@ -216,6 +217,35 @@ typedef struct
                                                                         */
 }I2S_Config_t;
 
+/**
+ *  @brief I2S stream direction definition
+ */
+typedef enum
+{
+    I2S_STREAM_RX = 0U,                             /*!< I2S stream receives into the buffers */
+    I2S_STREAM_TX = 1U                              /*!< I2S stream transmits from the buffers */
+}I2S_StreamDir_t;
+
+/**
+ *  @brief I2S stream buffer done callback type definition
+ */
+typedef void (i2s_stream_cb_t)(I2S_Id_t i2sId, I2S_ChannelId_t channelId);
+
+/**
+ *  @brief I2S stream configuration structure typedef
+ */
+typedef struct
+{
+    I2S_StreamDir_t dir;                            /*!< stream direction */
+    I2S_TransferMode_t mode;                        /*!< data register used: left, right or cyclic */
+    uint32_t *buffer[2];                            /*!< ping-pong buffers, one word per sample */
+    uint32_t bufLen;                                /*!< samples in each buffer */
+    ControlState_t dmaEnable;                       /*!< move the samples by DMA */
+    DMA_Channel_t dmaChannel;                       /*!< DMA channel, only used if dmaEnable is ENABLE */
+    i2s_stream_cb_t *halfCallback;                  /*!< called when buffer[0] is done, can be NULL */
+    i2s_stream_cb_t *fullCallback;                  /*!< called when buffer[1] is done, can be NULL */
+}I2S_StreamConfig_t;
+
 /**
  * @brief      I2S interrupt handle
  *
@@ -747,6 +777,56 @@ void I2S_TransmitData(I2S_Id_t i2sId, I2S_ChannelId_t channelId, I2S_TransferMod
  *
  */
 uint32_t I2S_ReceiveData(I2S_Id_t i2sId, I2S_ChannelId_t channelId, I2S_TransferMode_t i2sTransferMode);
+
+/**
+ * @brief      Start a double-buffered stream on an I2S channel.
+ *
+ * @param[in]  i2sId:               Select the I2S ID:
+ *                                      -I2S_ID_0
+ *                                      -I2S_ID_1
+ *
+ * @param[in]  channelId:           Select the I2S Channel ID:
+ *                                      -Channel0_ID
+ *                                      -Channel1_ID
+ *                                      -Channel2_ID
+ *                                      -Channel3_ID
+ *
+ * @param[in]  config:              Stream configuration.
+ *
+ * @return function execution result
+ *             - SUCC : the stream is started
+ *             - ERR : invalid configuration, the channel is streaming, or
+ *                     DMA is requested and the I2S DMA request is in use
+ *
+ * The stream runs until stopped: buffer[0] and buffer[1] are filled (RX)
+ * or drained (TX) in turn and halfCallback/fullCallback are called when
+ * buffer[0]/buffer[1] is done; the application shall handle a buffer
+ * before its next turn. Without DMA the FIFO trigger level interrupt
+ * moves a block of samples per interrupt. The I2S has one DMA request per
+ * instance, so only one channel of an instance can stream by DMA, with up
+ * to 32767 samples per buffer. The I2S and the channel shall be
+ * configured and enabled by the application.
+ */
+ResultStatus_t I2S_StreamStart(I2S_Id_t i2sId, I2S_ChannelId_t channelId,
+                               const I2S_StreamConfig_t *config);
+
+/**
+ * @brief      Stop the stream of an I2S channel.
+ *
+ * @param[in]  i2sId:               Select the I2S ID:
+ *                                      -I2S_ID_0
+ *                                      -I2S_ID_1
+ *
+ * @param[in]  channelId:           Select the I2S Channel ID:
+ *                                      -Channel0_ID
+ *                                      -Channel1_ID
+ *                                      -Channel2_ID
+ *                                      -Channel3_ID
+ *
+ * @return     none
+ *
+ */
+void I2S_StreamStop(I2S_Id_t i2sId, I2S_ChannelId_t channelId);
 /** @} end of group I2S_Public_Types */
 
 /** @} end of group I2S  */
@@ -15,6 +15,7 @@
 #define SPI_DRV_H
 
 #include "common_drv.h"
+#include "dma_drv.h"
 
 /** @addtogroup  Z20K14XM_Peripheral_Driver
  *  @{
@@ -168,6 +169,66 @@ typedef struct
     uint32_t   dmaRecvReqLevel;         /*!< Receive  data level,
                                              the valid range is 0 - 3 */
 } SPI_DmaLvl_t;
+
+/**
+ *  @brief SPI transfer done callback type definition
+ */
+typedef void (spi_xfer_cb_t)(SPI_Id_t spiId);
+
+/**
+ *  @brief SPI block transfer DMA offload configuration
+ */
+typedef struct
+{
+    ControlState_t  dmaEnable;          /*!< Offload large transfers to DMA */
+    DMA_Channel_t   txChannel;          /*!< DMA channel feeding the TX FIFO */
+    DMA_Channel_t   rxChannel;          /*!< DMA channel draining the RX FIFO.
+                                             It should have a higher priority
+                                             than txChannel */
+    uint32_t        dmaThreshold;       /*!< Transfers of at least this number
+                                             of frames use DMA */
+} SPI_XferDmaConfig_t;
+
+/**
+ *  @brief SPI slave device profile used by the transaction queue
+ */
+typedef struct
+{
+    uint32_t          dataSize;         /*!< Data frame size, 4 to 32 bits */
+    SPI_ClkPhase_t    clkPhase;         /*!< Serial clock phase */
+    SPI_ClkPolar_t    clkPolarity;      /*!< Serial clock polarity */
+    uint32_t          clkDivider;       /*!< Clock divider, see SPI_Config_t */
+    SPI_SelectSlave_t chipSelect;       /*!< Slave select of the device */
+} SPI_DeviceProfile_t;
+
+/**
+ *  @brief SPI queued transaction type definition
+ */
+typedef struct SPI_Transaction_s SPI_Transaction_t;
+
+/**
+ *  @brief SPI queued transaction done callback type definition
+ */
+typedef void (spi_trans_cb_t)(SPI_Id_t spiId, SPI_Transaction_t *trans);
+
+/**
+ *  @brief SPI queued transaction
+ *
+ *  Owned by the queue from SPI_QueueSubmit() until its callback is called.
+ */
+struct SPI_Transaction_s
+{
+    const SPI_DeviceProfile_t *device;  /*!< Profile of the slave device */
+    const uint8_t *txData;              /*!< Frames to be sent, NULL sends 0 */
+    uint8_t *rxData;                    /*!< Received frames, NULL discards */
+    uint32_t frameNum;                  /*!< Number of frames */
+    spi_trans_cb_t *callback;           /*!< Called when done, can be NULL */
+    ResultStatus_t status;              /*!< Set by the queue before callback
+                                             - SUCC: transferred
+                                             - ERR: not started, buffers not
+                                               aligned or SPI busy */
+    SPI_Transaction_t *next;            /*!< Used by the queue */
+};
 /** @} end of group SPI_Public_Types  */
 
 
@@ -394,6 +455,122 @@ void SPI_IntMask(SPI_Id_t spiNo, SPI_Int_t intType, IntMask_t intMask);
  */
 void SPI_InstallCallbackFunc(SPI_Id_t spiId, SPI_Int_t intId, isr_cb_t * cbFun);
 
+/**
+ * @brief      Config the DMA offload of SPI_TransferBlocking() and 
+ *             SPI_TransferAsync().
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ * @param[in]  config:  Pointer to the DMA offload configuration.
+ *
+ * @return     status
+ *             - SUCC
+ *             - BUSY : a transfer is in progress
+ *
+ */
+ResultStatus_t SPI_TransferDmaConfig(SPI_Id_t spiNo, 
+                                     const SPI_XferDmaConfig_t * config);
+
+/**
+ * @brief      Full-duplex transfer of a buffer, wait until it is done.
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ * @param[in]  txData:  Frames to be sent, NULL to send 0.
+ * @param[out] rxData:  Memory for the received frames, NULL to discard them.
+ * @param[in]  frameNum:  The number of frames.
+ *
+ * @return     status
+ *             - SUCC
+ *             - BUSY : an async transfer is in progress
+ *             - ERR : frameNum is 0, the SPI is not in SPI_TMOD_TR mode or
+ *                     the DMA transfer is not done within
+ *                     SPI_TIMEOUT_WAIT_CNT. The DMA channels are then
+ *                     stopped and the received frames are incomplete.
+ *
+ * A frame takes 1, 2 or 4 bytes of the buffers for a frame size of 4-8, 
+ * 9-16 or 17-32 bits and the buffers shall be aligned to it. The SPI shall 
+ * be a master, enabled and with the slave selected. When DMA offload is 
+ * used the done interrupt of the DMA RX channel shall be enabled and able
+ * to preempt the caller, otherwise the transfer ends with ERR.
+ */
+ResultStatus_t SPI_TransferBlocking(SPI_Id_t spiNo, const uint8_t txData[],
+                                    uint8_t rxData[], uint32_t frameNum);
+
+/**
+ * @brief      Start a full-duplex transfer of a buffer in background.
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ * @param[in]  txData:  Frames to be sent, NULL to send 0.
+ * @param[out] rxData:  Memory for the received frames, NULL to discard them.
+ * @param[in]  frameNum:  The number of frames.
+ * @param[in]  callback:  Called in interrupt when the transfer is done, 
+ *                        can be NULL.
+ *
+ * @return     status
+ *             - SUCC
+ *             - BUSY : a transfer is in progress
+ *             - ERR : frameNum is 0 or the SPI is not in SPI_TMOD_TR mode
+ *
+ * Same buffer rules as SPI_TransferBlocking(). The RXF interrupt of the SPI
+ * shall be enabled in NVIC, or the done interrupt of the DMA RX channel when
+ * DMA offload is used. The buffers shall be kept until the transfer is done.
+ */
+ResultStatus_t SPI_TransferAsync(SPI_Id_t spiNo, const uint8_t txData[],
+                                 uint8_t rxData[], uint32_t frameNum,
+                                 spi_xfer_cb_t * callback);
+
+/**
+ * @brief      Get the status of SPI_TransferAsync().
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ *
+ * @return     SET : the transfer is in progress
+ *             RESET : no transfer is in progress
+ *
+ */
+FlagStatus_t SPI_GetTransferStatus(SPI_Id_t spiNo);
+
+/**
+ * @brief      Queue a transaction to a slave device.
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ * @param[in]  trans:  The transaction, it shall be kept until its callback.
+ *
+ * @return     status
+ *             - SUCC : the transaction is queued
+ *             - ERR : no device, frameNum is 0 or dataSize is out of range
+ *
+ * Transactions are run back-to-back by SPI_TransferAsync() from the
+ * previous transfer done interrupt. The device profile is applied before
+ * each transaction, the SPI is only disabled when the frame format or
+ * clock divider really changes. The SPI shall be initialized as master in
+ * SPI_TMOD_TR mode; the queue enables it. While a transfer out of the queue
+ * is in progress, the queue waits and is started when that transfer ends.
+ */
+ResultStatus_t SPI_QueueSubmit(SPI_Id_t spiNo, SPI_Transaction_t * trans);
+
+/**
+ * @brief      Drop the queued transactions not started yet.
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ *
+ * @return     none
+ *
+ * The running transaction is finished normally. No callback is called for
+ * the dropped ones.
+ */
+void SPI_QueueFlush(SPI_Id_t spiNo);
+
+/**
+ * @brief      Get the status of the transaction queue.
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ *
+ * @return     SET : a transaction is running or queued
+ *             RESET : the queue is empty
+ *
+ */
+FlagStatus_t SPI_QueueGetStatus(SPI_Id_t spiNo);
+
 /** @} end of group SPI_Public_FunctionDeclaration */
 
 /** @} end of group SPI  */
@@ -15,6 +15,7 @@
 #define UART_DRV_H
 
 #include "common_drv.h"
+#include "dma_drv.h"
 
 /** @addtogroup  Z20K14XM_Peripheral_Driver
  *  @{
@@ -219,6 +220,28 @@ typedef struct
     UART_IdleDetectLength_t len;            /*!< IDLE detect length */
 } UART_IdleDetectConfig_t;
 
+/**
+ *  @brief UART DMA RX packet callback type definition. It is called from the
+ *         UART interrupt when the line becomes idle, length is the number of
+ *         bytes received since the previous idle.
+ */
+typedef void (uart_dma_rx_cb_t)(UART_ID_t uartId, uint32_t length);
+
+/**
+ *  @brief UART DMA streaming Configuration Structure type definition
+ */
+typedef struct
+{
+    DMA_Channel_t rxChannel;        /*!< DMA channel writing into rxBuf */
+    uint8_t *rxBuf;                 /*!< circular RX buffer, NULL disables 
+                                         DMA RX */
+    uint16_t rxSize;                /*!< size of rxBuf in bytes, 2 - 32768 */
+    UART_IdleDetectLength_t idleLen;/*!< idle length ending a packet */
+    uart_dma_rx_cb_t *rxCallback;   /*!< packet callback, can be NULL */
+    DMA_Channel_t txChannel;        /*!< DMA channel used by UART_DmaWrite() */
+    ControlState_t txEnable;        /*!< Enable/disable DMA TX */
+} UART_DmaConfig_t;
+
 /**
  *  @brief UART LIN Configuration Structure type definition
  */
@@ -255,6 +278,118 @@ typedef struct
     uint8_t data[8];                /*!< the response payload exclude checksum*/
 } UART_LinResponse_t;
 
+/**
+ *  @brief UART LIN schedule slot direction type definition
+ */
+typedef enum
+{
+    UART_LIN_SLOT_TX = 0U,          /*!< master sends the response */
+    UART_LIN_SLOT_RX,               /*!< master receives the response */
+    UART_LIN_SLOT_HEADER_ONLY       /*!< master sends the header only, e.g.
+                                         slave to slave frame */
+} UART_LinSlotDir_t;
+
+/**
+ *  @brief UART LIN schedule slot result type definition
+ */
+typedef enum
+{
+    UART_LIN_SLOT_OK = 0U,          /*!< frame done */
+    UART_LIN_SLOT_HEADER_ERR,       /*!< header error */
+    UART_LIN_SLOT_RSP_ERR,          /*!< response checksum error or it can
+                                         not be started */
+    UART_LIN_SLOT_NO_RSP            /*!< frame not done before the slot ends */
+} UART_LinSlotStatus_t;
+
+/**
+ *  @brief UART LIN schedule slot Structure type definition
+ */
+typedef struct
+{
+    uint8_t id;                     /*!< 6-bit ID */
+    UART_LinSlotDir_t dir;          /*!< response direction */
+    UART_LinCheckSum_t checkType;   /*!< checksum type */
+    uint8_t len;                    /*!< response length exclude checksum, 
+                                         1 - 8 */
+    uint8_t *data;                  /*!< response data sent in TX slots, or
+                                         received in RX slots */
+    uint16_t delay;                 /*!< slot length in schedule ticks */
+} UART_LinSlot_t;
+
+/**
+ *  @brief UART LIN slot done callback type definition, slotIdx is the index
+ *         of the slot in the schedule table.
+ */
+typedef void (uart_lin_slot_cb_t)(UART_ID_t uartId, uint32_t slotIdx,
+                                  UART_LinSlotStatus_t status);
+
+/**
+ *  @brief UART LIN schedule table Structure type definition
+ */
+typedef struct
+{
+    const UART_LinSlot_t *slots;    /*!< slot table, run in a loop */
+    uint32_t slotNum;               /*!< number of slots */
+    uint32_t breakLen;              /*!< break field length of headers */
+    uint32_t deleLen;               /*!< delemiter length of headers */
+    uart_lin_slot_cb_t *callback;   /*!< slot done callback, can be NULL */
+} UART_LinSchedule_t;
+
+/**
+ *  @brief UART LIN schedule statistics Structure type definition. Latency is 
+ *         the tickLatency given to UART_LinScheduleTick() when a header is 
+ *         started, its spread (latencyMax - latencyMin) is the slot jitter.
+ */
+typedef struct
+{
+    uint32_t slotCnt;               /*!< headers started */
+    uint32_t headerErrCnt;          /*!< slots ended with header error */
+    uint32_t rspErrCnt;             /*!< slots ended with response error */
+    uint32_t noRspCnt;              /*!< slots not done in time */
+    uint32_t overrunCnt;            /*!< headers not started as UART busy */
+    uint32_t latencyMin;            /*!< minimum header start latency */
+    uint32_t latencyMax;            /*!< maximum header start latency */
+    uint32_t latencySum;            /*!< sum of header start latency */
+} UART_LinScheduleStats_t;
+
+/**
+ *  @brief UART LIN slave response direction type definition
+ */
+typedef enum
+{
+    UART_LIN_RSP_PUBLISH = 0U,      /*!< slave sends the response */
+    UART_LIN_RSP_SUBSCRIBE          /*!< slave receives the response */
+} UART_LinRspDir_t;
+
+/**
+ *  @brief UART LIN slave response table entry Structure type definition
+ */
+typedef struct
+{
+    uint8_t id;                     /*!< 6-bit ID */
+    UART_LinRspDir_t dir;           /*!< response direction */
+    UART_LinResponse_t rsp;         /*!< checksum type and length of the
+                                         response. The data is the cached
+                                         response of a published ID, or the
+                                         last response of a subscribed ID */
+} UART_LinSlaveEntry_t;
+
+/**
+ *  @brief UART LIN slave frame done callback type definition
+ */
+typedef void (uart_lin_slave_cb_t)(UART_ID_t uartId, uint8_t id,
+                                   UART_LinSlotStatus_t status);
+
+/**
+ *  @brief UART LIN slave response table Structure type definition
+ */
+typedef struct
+{
+    UART_LinSlaveEntry_t *entries;  /*!< response table */
+    uint32_t entryNum;              /*!< number of entries, 1 - 64 */
+    uart_lin_slave_cb_t *callback;  /*!< frame done callback, can be NULL */
+} UART_LinSlaveTable_t;
+
 
 
 /** @}end of group UART_Public_Types */
@@ -804,6 +939,254 @@ ResultStatus_t UART_LinStartReceiveResponse(UART_ID_t uartId,
  */
 void UART_LinReadResponse(UART_ID_t uartId, uint32_t len, uint8_t data[]);
 
+/**
+ * @brief      Config the buffered mode of a UART. In buffered mode the
+ *             UART_INT_TBEI and UART_INT_RBFI/UART_INT_RCVRTO interrupts move
+ *             data between the hardware FIFO and the TX/RX rings in bursts
+ *             sized by the UART_FIFOConfig() trigger levels. Installed call
+ *             back functions of these interrupts are still called as a
+ *             notification, and the interrupts are not masked if there is no
+ *             call back function.
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  txBuf:  points to the TX ring storage. NULL disables buffered TX.
+ * @param[in]  txSize:  size of txBuf in bytes, it shall be a power of 2.
+ * @param[in]  rxBuf:  points to the RX ring storage. NULL disables buffered RX.
+ * @param[in]  rxSize:  size of rxBuf in bytes, it shall be a power of 2.
+ * @note       It shall be called after UART_Init() and UART_FIFOConfig(),
+ *             while the UART interrupt is disabled. The RX interrupt is 
+ *             unmasked here if rxBuf is not NULL.
+ * @return     status
+ *             - SUCC -- successful
+ *             - ERR -- txSize or rxSize is not a power of 2, or rxBuf is
+ *                      given while DMA RX is in use
+ */
+ResultStatus_t UART_BufferedConfig(UART_ID_t uartId, uint8_t txBuf[], 
+                                   uint32_t txSize, uint8_t rxBuf[],
+                                   uint32_t rxSize);
+
+/**
+ * @brief      Copy data into the TX ring and start the transmission. It does
+ *             not wait, and it shall not be called from different contexts at
+ *             the same time.
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  data:  points to the data to be sent
+ * @param[in]  length:  the number of bytes to be sent
+ * @return     the number of bytes copied into the TX ring, it is less than
+ *             length if the ring is full
+ */
+uint32_t UART_Write(UART_ID_t uartId, const uint8_t data[], uint32_t length);
+
+/**
+ * @brief      Read received data out of the RX ring. It does not wait, and it
+ *             shall not be called from different contexts at the same time.
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[out] data:  points to the memory where the data to be stored
+ * @param[in]  length:  the maximum number of bytes to be read
+ * @return     the number of bytes read
+ */
+uint32_t UART_Read(UART_ID_t uartId, uint8_t data[], uint32_t length);
+
+/**
+ * @brief      Get the number of bytes waiting in the TX ring
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     the number of bytes not yet moved into the TX FIFO
+ */
+uint32_t UART_GetTxPending(UART_ID_t uartId);
+
+/**
+ * @brief      Get the number of received bytes dropped because the RX ring
+ *             was full
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     the number of dropped bytes
+ */
+uint32_t UART_GetRxDropCount(UART_ID_t uartId);
+
+/**
+ * @brief      Config the DMA streaming mode of a UART. The RX DMA channel
+ *             writes received bytes into rxBuf continuously and wraps around
+ *             at its end. The idle detection reports the end of each packet
+ *             through the character timeout interrupt, so the CPU does not 
+ *             touch individual bytes.
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  config:  Pointer to the DMA streaming configuration
+ * @note       It shall be called after UART_Init() and UART_FIFOConfig().
+ *             The channel priorities are kept as set by 
+ *             DMA_SetChannelPriority()/DMA_SetChannelPreempt(). The RX 
+ *             interrupt is unmasked here, and the UART interrupt shall be 
+ *             enabled in NVIC to get the packet callback.
+ * @return     status
+ *             - SUCC -- successful
+ *             - ERR -- rxSize is out of range, or buffered RX is in use
+ */
+ResultStatus_t UART_DmaConfig(UART_ID_t uartId, const UART_DmaConfig_t *config);
+
+/**
+ * @brief      Read received data out of the DMA RX buffer. It does not wait,
+ *             and it shall not be called from different contexts at the same 
+ *             time.
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[out] data:  points to the memory where the data to be stored
+ * @param[in]  length:  the maximum number of bytes to be read
+ * @note       Data not read before the DMA wraps around rxBuf is overwritten.
+ * @return     the number of bytes read
+ */
+uint32_t UART_DmaRead(UART_ID_t uartId, uint8_t data[], uint32_t length);
+
+/**
+ * @brief      Get the number of bytes in the DMA RX buffer not read yet
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     the number of bytes can be read by UART_DmaRead()
+ */
+uint32_t UART_DmaGetRxCount(UART_ID_t uartId);
+
+/**
+ * @brief      Send a buffer through the TX DMA channel
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  data:  points to the data to be sent. It shall be kept until
+ *                    UART_DmaGetTxStatus() returns RESET.
+ * @param[in]  length:  the number of bytes to be sent, 1 - 65535
+ * @return     status
+ *             - SUCC -- the transfer is started
+ *             - BUSY -- the previous transfer is not finished
+ *             - ERR -- DMA TX is not enabled or length is 0
+ */
+ResultStatus_t UART_DmaWrite(UART_ID_t uartId, const uint8_t data[], 
+                             uint16_t length);
+
+/**
+ * @brief      Get the DMA TX status
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     SET: the DMA is still moving data into the TX FIFO
+ *             RESET: the DMA TX is idle
+ */
+FlagStatus_t UART_DmaGetTxStatus(UART_ID_t uartId);
+
+/**
+ * @brief      Start a LIN master schedule table. If a table is running, the
+ *             new table takes over from its first slot at the next slot 
+ *             boundary. The UART HEADER_DONE and RSP_DONE interrupts are
+ *             unmasked, installed call back functions of them are still 
+ *             called as a notification.
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  schedule:  points to the schedule table, it shall be kept 
+ *                        while it is running.
+ * @note       The UART shall be configured by UART_LinConfig() as a master.
+ *             The timer interrupt calling UART_LinScheduleTick() and the UART
+ *             interrupt shall have the same NVIC priority.
+ * @return     status
+ *             - SUCC : the table is accepted
+ *             - ERR : the table is empty or a slot is invalid
+ */
+ResultStatus_t UART_LinScheduleStart(UART_ID_t uartId,
+                                     const UART_LinSchedule_t *schedule);
+
+/**
+ * @brief      Stop the LIN master schedule table and the frame in progress
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     none
+ */
+void UART_LinScheduleStop(UART_ID_t uartId);
+
+/**
+ * @brief      Advance the LIN schedule by one tick. It shall be called from
+ *             a periodic timer interrupt (STIM or TIM compare), the header
+ *             of the next slot is sent when the current slot ends.
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  tickLatency:  time passed since the timer event, e.g. the
+ *                           STIM counter value when the counter restarts
+ *                           from 0 on compare match. It is only used for
+ *                           the jitter statistics.
+ * @return     none
+ */
+void UART_LinScheduleTick(UART_ID_t uartId, uint32_t tickLatency);
+
+/**
+ * @brief      Get the LIN schedule statistics
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[out] stats:  points to the memory where the statistics to be stored
+ * @return     none
+ */
+void UART_LinGetScheduleStats(UART_ID_t uartId, UART_LinScheduleStats_t *stats);
+
+/**
+ * @brief      Clear the LIN schedule statistics
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     none
+ */
+void UART_LinClearScheduleStats(UART_ID_t uartId);
+
+/**
+ * @brief      Start the LIN slave node with a response table. The ID filters
+ *             are loaded from the table: the first 16 IDs use the exact ID
+ *             filters and the rest share the vague ID filter. On each header
+ *             of a published ID the cached response is pushed into the TX 
+ *             FIFO from the header done interrupt, without call back.
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  table:  points to the response table, it shall be kept while 
+ *                     the slave node is running.
+ * @note       The UART shall be configured by UART_LinConfig() as a slave. 
+ *             The UART HEADER_DONE and RSP_DONE interrupts are unmasked, 
+ *             installed call back functions of them are still called as a
+ *             notification.
+ * @return     status
+ *             - SUCC : the slave node is started
+ *             - ERR : the table is invalid, the UART is busy or a schedule
+ *                     table is running
+ */
+ResultStatus_t UART_LinSlaveStart(UART_ID_t uartId, 
+                                  const UART_LinSlaveTable_t *table);
+
+/**
+ * @brief      Stop the LIN slave node
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     none
+ */
+void UART_LinSlaveStop(UART_ID_t uartId);
+
+/**
+ * @brief      Update the cached response of a published ID
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  id:  6-bit ID
+ * @param[in]  data:  the new response, its length is set in the table
+ * @return     status
+ *             - SUCC : the response is updated
+ *             - ERR : the ID is not published by the table
+ */
+ResultStatus_t UART_LinSlaveUpdateResponse(UART_ID_t uartId, uint8_t id,
+                                           const uint8_t data[]);
+
+/**
+ * @brief      Read the last response of a subscribed ID
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  id:  6-bit ID
+ * @param[out] data:  points to the memory where the response to be stored, 
+ *                    its length is set in the table
+ * @return     status
+ *             - SUCC : the response is read
+ *             - ERR : the ID is not subscribed by the table
+ */
+ResultStatus_t UART_LinSlaveReadData(UART_ID_t uartId, uint8_t id,
+                                     uint8_t data[]);
+
 
 
 /** @}end of group UART_Public_FunctionDeclaration */
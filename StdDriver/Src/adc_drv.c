@@ -12,6 +12,7 @@
  **************************************************************************************************/
 
 #include "adc_drv.h"
+#include "tmu_drv.h"
 
 /** @addtogroup  Z20K14XM_Peripheral_Driver
  *  @{
@@ -26,6 +27,30 @@
  *  @{
  */
 
+/**
+ *  @brief ADC scan control
+ */
+typedef struct
+{
+    const ADC_ScanChannel_t *channels;          /*!< scanned channels */
+    uint32_t channelNum;                        /*!< number of channels */
+    uint32_t *rawBuffer;                        /*!< circular DMA buffer */
+    uint32_t halfLen;                           /*!< results in each half */
+    uint32_t dataLen;                           /*!< entries of each channel data array */
+    adc_scan_cb_t *halfCallback;                /*!< first half done callback */
+    adc_scan_cb_t *fullCallback;                /*!< second half done callback */
+    DMA_Channel_t dmaChannel;                   /*!< DMA channel */
+    FlagStatus_t active;                        /*!< scan is running */
+    uint8_t slot[32];                           /*!< channel tag to channel index */
+    uint32_t count[32];                         /*!< results of each channel */
+    uint16_t latest[32];                        /*!< latest result of each channel */
+    DMA_ChainNode_t node[2];                    /*!< DMA nodes of the halves */
+    FlagStatus_t ovsEnable;                     /*!< oversampling is running */
+    uint32_t ovsRatio;                          /*!< samples of an oversampled result */
+    uint32_t ovsChannelNum;                     /*!< entries of ovs.states */
+    ADC_OvsConfig_t ovs;                        /*!< oversampling configuration */
+} ADC_Scan_t;
+
 /*@} end of group ADC_Private_Type*/
 
 /** @defgroup ADC_Private_Defines
@@ -37,6 +62,17 @@
 #define ADC_CALIBRATION_CHANNEL   (22U)     /*!< ADC calibration channel number*/
 #define ADC_TEMPSENSOR_CHANNEL    (23U)     /*!< ADC temperature sensor channel number*/
 
+#define ADC_SCAN_CHANNEL_MAX      (32U)     /*!< ADC channel tags */
+#define ADC_SCAN_SLOT_NONE        (0xFFU)   /*!< ADC channel tag not scanned */
+#define ADC_SCAN_MINOR_LOOP_MAX   (32767U)  /*!< ADC DMA requests of a half buffer */
+
+#define ADC_CMD_BUFFER_NUM        (6U)      /*!< ADC CMD buffers */
+#define ADC_NS_PER_SECOND         (1000000000UL)
+
+#define ADC_OVS_RATIO_LOG4_MAX    (6U)      /*!< 4^6 12-bit samples fit 32 bits */
+#define ADC_OVS_CIC2_LOG4_MAX     (5U)      /*!< CIC2 gain 16^5 * 12 bits fit 32 bits */
+#define ADC_OVS_AVG_LOG2_MAX      (4U)      /*!< moving average history of 16 */
+
 /** @} end of group ADC_Private_Defines */
 
 /** @defgroup ADC_Private_Variables
@@ -98,6 +134,63 @@ static isr_cb_t * adcIsrCbFunc[ADC_NUM][ADC_INT_ALL] =
     {NULL,NULL,NULL,NULL,NULL}
 };
 
+/**
+ *  @brief ADC scan control array
+ */
+static ADC_Scan_t adcScan[ADC_NUM];
+
+/**
+ *  @brief ADC DMA request array
+ */
+static const DMA_RequestSource_t adcDmaReqTable[ADC_NUM] =
+{
+    DMA_REQ_ADC0,
+    DMA_REQ_ADC1
+};
+
+/**
+ *  @brief ADC successive approximation clocks of each resolution
+ */
+static const uint32_t adcSarCycleTable[] =
+{
+    13U,                       /*!< ADC_RESOLUTION_12BIT */
+    11U,                       /*!< ADC_RESOLUTION_10BIT */
+    9U                         /*!< ADC_RESOLUTION_8BIT */
+};
+
+/**
+ *  @brief ADC averaged conversions of each AVGS setting
+ */
+static const uint32_t adcAvgsNumTable[] =
+{
+    1U,                        /*!< ADC_AVGS_DISABLED */
+    4U,                        /*!< ADC_AVGS_4 */
+    8U,                        /*!< ADC_AVGS_8 */
+    16U,                       /*!< ADC_AVGS_16 */
+    32U                        /*!< ADC_AVGS_32 */
+};
+
+/**
+ *  @brief ADC trigger pipeline TMU source of each MCPWM counter reload
+ */
+static const TMU_Source_t adcPipeTrigSrcTable[2][4] =
+{
+    {TMU_SOURCE_MCPWM0_INIT_TRIG0, TMU_SOURCE_MCPWM0_INIT_TRIG1,
+     TMU_SOURCE_MCPWM0_INIT_TRIG2, TMU_SOURCE_MCPWM0_INIT_TRIG3},
+    {TMU_SOURCE_MCPWM1_INIT_TRIG0, TMU_SOURCE_MCPWM1_INIT_TRIG1,
+     TMU_SOURCE_MCPWM1_INIT_TRIG2, TMU_SOURCE_MCPWM1_INIT_TRIG3}
+};
+
+/**
+ *  @brief ADC trigger pipeline TDG and TMU target of each ADC
+ */
+static const TDG_ID_t adcPipeTdgTable[ADC_NUM] = {TDG0_ID, TDG1_ID};
+static const TMU_Module_t adcPipeTdgTrigTable[ADC_NUM] =
+{
+    TMU_MODULE_TDG0_TRIG_IN,
+    TMU_MODULE_TDG1_TRIG_IN
+};
+
 /** @} end of group ADC_Private_Variables */
 
 /** @defgroup ADC_Global_Variables
@@ -112,6 +205,12 @@ static isr_cb_t * adcIsrCbFunc[ADC_NUM][ADC_INT_ALL] =
 void ADC0_DriverIRQHandler(void);
 void ADC1_DriverIRQHandler(void);
 static void ADC_IntHandler(ADC_ID_t adcId);
+static void ADC_ScanDeinterleave(ADC_ID_t adcId, const uint32_t raw[]);
+static FlagStatus_t ADC_OvsKernel(const ADC_Scan_t * scan, ADC_OvsChannel_t * state,
+                                  uint32_t sample);
+static void ADC_ScanDmaDone(DMA_Channel_t channel, const DMA_ChainNode_t *node);
+static uint32_t ADC_CyclesToTicks(uint32_t cycles, uint32_t adcClkFreq,
+                                  uint32_t tickFreq);
 /** @} end of group ADC_Private_FunctionDeclaration */
 
 /** @defgroup ADC_Private_Functions
@@ -247,6 +346,175 @@ void ADC1_DriverIRQHandler(void)
     ADC_IntHandler(ADC1_ID);
 }
 
+/**
+ * @brief      ADC oversampling kernel, run on each sample of a channel
+ *
+ * @param[in]  scan:       Scan control.
+ * @param[in]  state:      Channel state.
+ * @param[in]  sample:     Sample.
+ *
+ * @return     SET if a new result is in state->result
+ *
+ * The integrators wrap modulo 2^32; the CIC combs cancel the wrap as long
+ * as the result itself fits 32 bits.
+ */
+static FlagStatus_t ADC_OvsKernel(const ADC_Scan_t * scan, ADC_OvsChannel_t * state,
+                                  uint32_t sample)
+{
+    FlagStatus_t ready = RESET;
+    uint32_t out;
+    uint32_t comb;
+
+    state->integ1 += sample;
+    if(ADC_OVS_CIC2 == scan->ovs.filter)
+    {
+        state->integ2 += state->integ1;
+    }
+
+    state->count++;
+    if(state->count >= scan->ovsRatio)
+    {
+        state->count = 0U;
+
+        if(ADC_OVS_CIC2 == scan->ovs.filter)
+        {
+            comb = state->integ2 - state->comb1;
+            state->comb1 = state->integ2;
+            out = comb - state->comb2;
+            state->comb2 = comb;
+        }
+        else
+        {
+            out = state->integ1;
+            state->integ1 = 0U;
+        }
+
+        out = out >> scan->ovs.shift;
+
+        if(ADC_OVS_MOVING_AVG == scan->ovs.filter)
+        {
+            state->avgSum = state->avgSum + out - state->avgBuf[state->avgIdx];
+            state->avgBuf[state->avgIdx] = out;
+            state->avgIdx = (state->avgIdx + 1U) & ((1UL << scan->ovs.avgLog2) - 1U);
+            out = state->avgSum >> scan->ovs.avgLog2;
+        }
+
+        state->result = out;
+        ready = SET;
+    }
+
+    return ready;
+}
+
+/**
+ * @brief      ADC scan de-interleave
+ *
+ * @param[in]  adcId:      Select the ADC ID.
+ * @param[in]  raw:        Half buffer of results.
+ *
+ * @return     none
+ *
+ */
+static void ADC_ScanDeinterleave(ADC_ID_t adcId, const uint32_t raw[])
+{
+    ADC_Scan_t * scan = &adcScan[adcId];
+    ADC_Conversion_Result_t result;
+    uint32_t slot;
+    uint32_t idx;
+
+    for(idx = 0U; idx < scan->channelNum; idx++)
+    {
+        scan->count[idx] = 0U;
+    }
+
+    for(idx = 0U; idx < scan->halfLen; idx++)
+    {
+        result.adcResult = raw[idx];
+        slot = scan->slot[result.bf.channel];
+
+        if(slot != ADC_SCAN_SLOT_NONE)
+        {
+            scan->latest[slot] = (uint16_t)result.bf.data;
+
+            if(scan->count[slot] < scan->dataLen)
+            {
+                scan->channels[slot].data[scan->count[slot]] = (uint16_t)result.bf.data;
+                scan->count[slot]++;
+            }
+
+            if((SET == scan->ovsEnable) &&
+               (SET == ADC_OvsKernel(scan, &scan->ovs.states[slot], result.bf.data)) &&
+               (scan->ovs.callback != NULL))
+            {
+                scan->ovs.callback(adcId, slot, scan->ovs.states[slot].result);
+            }
+        }
+    }
+}
+
+/**
+ * @brief      ADC scan DMA node done callback
+ *
+ * @param[in]  channel:    DMA channel.
+ * @param[in]  node:       The node done.
+ *
+ * @return     none
+ *
+ */
+static void ADC_ScanDmaDone(DMA_Channel_t channel, const DMA_ChainNode_t *node)
+{
+    ADC_Scan_t * scan;
+    uint32_t adcId;
+
+    (void)channel;
+
+    for(adcId = 0U; adcId < ADC_NUM; adcId++)
+    {
+        scan = &adcScan[adcId];
+
+        if(&scan->node[0] == node)
+        {
+            ADC_ScanDeinterleave((ADC_ID_t)adcId, scan->rawBuffer);
+            if(scan->halfCallback != NULL)
+            {
+                scan->halfCallback((ADC_ID_t)adcId);
+            }
+        }
+        else if(&scan->node[1] == node)
+        {
+            ADC_ScanDeinterleave((ADC_ID_t)adcId, &scan->rawBuffer[scan->halfLen]);
+            if(scan->fullCallback != NULL)
+            {
+                scan->fullCallback((ADC_ID_t)adcId);
+            }
+        }
+        else
+        {
+            /* not this ADC */
+        }
+    }
+}
+
+/**
+ * @brief      ADC clock cycles to TDG ticks, rounded up
+ *
+ * @param[in]  cycles:     ADC clock cycles.
+ * @param[in]  adcClkFreq: ADC function clock frequency (Hz).
+ * @param[in]  tickFreq:   TDG counter clock frequency (Hz).
+ *
+ * @return     TDG ticks
+ *
+ */
+static uint32_t ADC_CyclesToTicks(uint32_t cycles, uint32_t adcClkFreq,
+                                  uint32_t tickFreq)
+{
+    uint64_t ticks;
+
+    ticks = (((uint64_t)cycles * tickFreq) + adcClkFreq - 1U) / adcClkFreq;
+
+    return (uint32_t)ticks;
+}
+
 /** @} end of group ADC_Private_Functions */
 
 /** @defgroup ADC_Public_Functions
@@ -913,6 +1181,451 @@ void ADC_InstallCallBackFunc(ADC_ID_t adcId, ADC_INT_t intType,isr_cb_t * cbFun)
     adcIsrCbFunc[adcId][intType] = cbFun;
 }
 
+/**
+ * @brief      Adc Scan Start Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ * @param[in]  scanConfig: Pointer to a scan configuration structure.
+ *
+ * @return
+ *             - SUCC: the scan is started
+ *             - ERR: invalid configuration or the scan is running
+ *
+ */
+ResultStatus_t ADC_ScanStart(ADC_ID_t adcId, const ADC_ScanConfig_t* scanConfig)
+{
+    adc_reg_w_t * ADCWx = (adc_reg_w_t *) (adcRegWPtr[adcId]);
+    ADC_Scan_t * scan = &adcScan[adcId];
+    DMA_TransferConfig_t dmaConfig;
+    ResultStatus_t ret = SUCC;
+    uint32_t burst = (uint32_t)scanConfig->fifoWatermark + 1U;
+    uint32_t idx;
+
+    if((SET == scan->active) || (NULL == scanConfig->channels) ||
+       (0U == scanConfig->channelNum) ||
+       (scanConfig->channelNum > ADC_SCAN_CHANNEL_MAX) ||
+       (NULL == scanConfig->rawBuffer) || (0U == scanConfig->halfLen) ||
+       (scanConfig->fifoWatermark > 15U) || ((scanConfig->halfLen % burst) != 0U) ||
+       ((scanConfig->halfLen / burst) > ADC_SCAN_MINOR_LOOP_MAX))
+    {
+        ret = ERR;
+    }
+
+    for(idx = 0U; (idx < ADC_SCAN_CHANNEL_MAX) && (SUCC == ret); idx++)
+    {
+        scan->slot[idx] = ADC_SCAN_SLOT_NONE;
+    }
+
+    for(idx = 0U; (SUCC == ret) && (idx < scanConfig->channelNum); idx++)
+    {
+        if(((uint32_t)scanConfig->channels[idx].channel >= ADC_SCAN_CHANNEL_MAX) ||
+           ((scanConfig->dataLen != 0U) && (NULL == scanConfig->channels[idx].data)))
+        {
+            ret = ERR;
+        }
+        else
+        {
+            scan->slot[scanConfig->channels[idx].channel] = (uint8_t)idx;
+            scan->count[idx] = 0U;
+            scan->latest[idx] = 0U;
+        }
+    }
+
+    if(SUCC == ret)
+    {
+        scan->channels = scanConfig->channels;
+        scan->channelNum = scanConfig->channelNum;
+        scan->rawBuffer = scanConfig->rawBuffer;
+        scan->halfLen = scanConfig->halfLen;
+        scan->dataLen = scanConfig->dataLen;
+        scan->halfCallback = scanConfig->halfCallback;
+        scan->fullCallback = scanConfig->fullCallback;
+        scan->dmaChannel = scanConfig->dmaChannel;
+        scan->ovsEnable = RESET;
+
+        /* a request moves the results above the watermark from the FIFO */
+        dmaConfig.channel = scanConfig->dmaChannel;
+        dmaConfig.channelPriority = DMA_GetChannelPriority(scanConfig->dmaChannel);
+        dmaConfig.channelPreempt = DMA_GetChannelPreempt(scanConfig->dmaChannel);
+        dmaConfig.source = adcDmaReqTable[adcId];
+        /*PRQA S 0306 ++*/
+        dmaConfig.srcAddr = (uint32_t)&ADCWx->ADC_DATA_RD;
+        /*PRQA S 0306 --*/
+        dmaConfig.minorLoopSrcOffset = 0;
+        dmaConfig.minorLoopDestOffset = 4;
+        dmaConfig.majorLoopSrcOffset = 0;
+        dmaConfig.majorLoopDestOffset = 0;
+        dmaConfig.transferByteNum = burst * 4U;
+        dmaConfig.minorLoopNum = (uint16_t)(scanConfig->halfLen / burst);
+        dmaConfig.srcTransferSize = DMA_TRANSFER_SIZE_4B;
+        dmaConfig.destTransferSize = DMA_TRANSFER_SIZE_4B;
+        dmaConfig.disableRequestAfterDoneCmd = ENABLE;
+
+        dmaConfig.destAddr = (uint32_t)scanConfig->rawBuffer;
+        ret = DMA_ChainNodeInit(&scan->node[0], &dmaConfig, ADC_ScanDmaDone);
+        if(SUCC == ret)
+        {
+            dmaConfig.destAddr = (uint32_t)&scanConfig->rawBuffer[scanConfig->halfLen];
+            ret = DMA_ChainNodeInit(&scan->node[1], &dmaConfig, ADC_ScanDmaDone);
+        }
+    }
+
+    if(SUCC == ret)
+    {
+        /* the halves are filled in turn until stopped */
+        scan->node[0].next = &scan->node[1];
+        scan->node[1].next = &scan->node[0];
+
+        ADC_FifoWatermarkConfig(adcId, scanConfig->fifoWatermark);
+        DMAMUX_SelChannelSource(scanConfig->dmaChannel, adcDmaReqTable[adcId]);
+        DMAMUX_OutputChannelEnable(scanConfig->dmaChannel);
+        ret = DMA_ChainStart(scanConfig->dmaChannel, &scan->node[0]);
+
+        if(SUCC == ret)
+        {
+            scan->active = SET;
+            ADC_DmaRequestCmd(adcId, ENABLE);
+        }
+        else
+        {
+            DMAMUX_OutputChannelDisable(scanConfig->dmaChannel);
+            ret = ERR;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Adc Scan Stop Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ *
+ * @return     none
+ *
+ */
+void ADC_ScanStop(ADC_ID_t adcId)
+{
+    ADC_Scan_t * scan = &adcScan[adcId];
+
+    if(SET == scan->active)
+    {
+        ADC_DmaRequestCmd(adcId, DISABLE);
+        DMA_ChainStop(scan->dmaChannel);
+        DMAMUX_OutputChannelDisable(scan->dmaChannel);
+        scan->active = RESET;
+    }
+}
+
+/**
+ * @brief      Adc Scan Get Number Of Channel Data Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ * @param[in]  chIdx:      Index of the channel in the scan configuration.
+ *
+ * @return     Number of results in the data array of the channel from the
+ *             last half buffer.
+ *
+ */
+uint32_t ADC_ScanGetNumOfChannelData(ADC_ID_t adcId, uint32_t chIdx)
+{
+    return adcScan[adcId].count[chIdx];
+}
+
+/**
+ * @brief      Adc Scan Get Latest Result Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ * @param[in]  chIdx:      Index of the channel in the scan configuration.
+ *
+ * @return     The latest result of the channel.
+ *
+ */
+uint16_t ADC_ScanGetLatest(ADC_ID_t adcId, uint32_t chIdx)
+{
+    return adcScan[adcId].latest[chIdx];
+}
+
+/**
+ * @brief      Adc Oversampling Start Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ * @param[in]  ovsConfig:  Pointer to an oversampling configuration structure.
+ *
+ * @return
+ *             - SUCC: oversampling is started
+ *             - ERR: invalid configuration or the scan is not running
+ *
+ */
+ResultStatus_t ADC_OversampleStart(ADC_ID_t adcId, const ADC_OvsConfig_t* ovsConfig)
+{
+    ADC_Scan_t * scan = &adcScan[adcId];
+    ResultStatus_t ret = SUCC;
+    uint32_t primask;
+    uint32_t idx;
+    uint32_t hist;
+
+    if((RESET == scan->active) || (NULL == ovsConfig->states) ||
+       ((uint32_t)ovsConfig->filter > (uint32_t)ADC_OVS_MOVING_AVG) ||
+       (0U == ovsConfig->ratioLog4) || (ovsConfig->ratioLog4 > ADC_OVS_RATIO_LOG4_MAX) ||
+       ((ADC_OVS_CIC2 == ovsConfig->filter) &&
+        (ovsConfig->ratioLog4 > ADC_OVS_CIC2_LOG4_MAX)) ||
+       (ovsConfig->avgLog2 > ADC_OVS_AVG_LOG2_MAX) || (ovsConfig->shift > 31U))
+    {
+        ret = ERR;
+    }
+    else
+    {
+        primask = COMMON_GetPRIMASK();
+        COMMON_DISABLE_INTERRUPTS();
+
+        for(idx = 0U; idx < scan->channelNum; idx++)
+        {
+            ovsConfig->states[idx].count = 0U;
+            ovsConfig->states[idx].integ1 = 0U;
+            ovsConfig->states[idx].integ2 = 0U;
+            ovsConfig->states[idx].comb1 = 0U;
+            ovsConfig->states[idx].comb2 = 0U;
+            ovsConfig->states[idx].avgSum = 0U;
+            ovsConfig->states[idx].avgIdx = 0U;
+            ovsConfig->states[idx].result = 0U;
+            for(hist = 0U; hist < 16U; hist++)
+            {
+                ovsConfig->states[idx].avgBuf[hist] = 0U;
+            }
+        }
+
+        scan->ovs = *ovsConfig;
+        scan->ovsRatio = 1UL << (2U * (uint32_t)ovsConfig->ratioLog4);
+        scan->ovsChannelNum = scan->channelNum;
+        scan->ovsEnable = SET;
+
+        COMMON_SetPRIMASK(primask);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Adc Oversampling Stop Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ *
+ * @return     none
+ *
+ */
+void ADC_OversampleStop(ADC_ID_t adcId)
+{
+    adcScan[adcId].ovsEnable = RESET;
+}
+
+/**
+ * @brief      Adc Oversampling Get Result Function
+ *
+ * @param[in]  adcId:      Select the ADC ID:
+ *                           - ADC0_ID
+ *                           - ADC1_ID
+ * @param[in]  chIdx:      Index of the channel in the scan configuration.
+ *
+ * @return     The latest oversampled result of the channel, 0 if
+ *             oversampling has never been started or chIdx is not a channel
+ *             of the scan.
+ *
+ */
+uint32_t ADC_OversampleGetResult(ADC_ID_t adcId, uint32_t chIdx)
+{
+    const ADC_Scan_t * scan = &adcScan[adcId];
+    uint32_t result = 0U;
+
+    /* ovs.states is sized for the scan running at ADC_OversampleStart() */
+    if((scan->ovs.states != NULL) && (chIdx < scan->ovsChannelNum))
+    {
+        result = scan->ovs.states[chIdx].result;
+    }
+
+    return result;
+}
+
+/**
+ * @brief      Adc Trigger Pipeline Configure Function
+ *
+ * @param[in]  pipeConfig: Pointer to a trigger pipeline configuration
+ *                         structure.
+ *
+ * @return
+ *             - SUCC: the pipeline is configured
+ *             - ERR: the MCPWM, the counter or the timing is not valid, or
+ *                    the TDG configuration is not loaded
+ *
+ */
+ResultStatus_t ADC_TriggerPipelineConfig(const ADC_PipelineConfig_t* pipeConfig)
+{
+    adc_reg_t * ADCx;
+    ResultStatus_t ret = SUCC;
+    uint32_t tickFreq = pipeConfig->tdgClkFreq >> (uint32_t)pipeConfig->tdgClkDivide;
+    uint32_t periodTicks;
+    uint32_t stableTicks[ADC_NUM];
+    uint32_t convTicks[ADC_NUM];
+    uint32_t cmdNum[ADC_NUM] = {0U, 0U};
+    uint32_t nextFree[ADC_NUM];
+    uint16_t offset[ADC_NUM][ADC_CMD_BUFFER_NUM];
+    ADC_P_Channel_t cmdCh[ADC_NUM][ADC_CMD_BUFFER_NUM];
+    uint32_t instant;
+    uint32_t adcId;
+    uint32_t idx;
+    uint32_t cycles;
+    FlagStatus_t tdgChanged = RESET;
+    TDG_InitConfig_t tdgConfig;
+    TDG_DelayOutputConfig_t doConfig;
+    TDG_ChannelConfig_t chConfig;
+    ADC_TDGTriggerConfig_t trigConfig;
+
+    if((0U == tickFreq) || (0U == pipeConfig->adcClkFreq) ||
+       (NULL == pipeConfig->samples) || (0U == pipeConfig->sampleNum) ||
+       ((uint32_t)pipeConfig->mcpwmId > (uint32_t)MCPWM1_ID) ||
+       ((uint32_t)pipeConfig->counterId > (uint32_t)MCPWM_COUNTER_3))
+    {
+        ret = ERR;
+    }
+
+    periodTicks = (SUCC == ret) ?
+        (uint32_t)(((uint64_t)pipeConfig->pwmPeriodNs * tickFreq) / ADC_NS_PER_SECOND) : 0U;
+    if((0U == periodTicks) || (periodTicks > 0x10000U))
+    {
+        ret = ERR;
+    }
+
+    /* conversion time of the current ADC configuration in TDG ticks */
+    for(adcId = 0U; (adcId < ADC_NUM) && (SUCC == ret); adcId++)
+    {
+        ADCx = (adc_reg_t *)(adcRegPtr[adcId]);
+        cycles = (ADCx->ADC_CFG.STS + adcSarCycleTable[ADCx->ADC_CFG.RES]) *
+                 adcAvgsNumTable[ADCx->ADC_CFG.AVGS];
+        convTicks[adcId] = ADC_CyclesToTicks(cycles, pipeConfig->adcClkFreq, tickFreq);
+        stableTicks[adcId] = ADC_CyclesToTicks(ADCx->ADC_CTRL.STABLE_T,
+                                               pipeConfig->adcClkFreq, tickFreq);
+        nextFree[adcId] = stableTicks[adcId];
+    }
+
+    for(idx = 0U; (idx < pipeConfig->sampleNum) && (SUCC == ret); idx++)
+    {
+        adcId = (uint32_t)pipeConfig->samples[idx].adcId;
+        instant = (uint32_t)(((uint64_t)pipeConfig->samples[idx].instantNs * tickFreq) /
+                             ADC_NS_PER_SECOND);
+
+        /* the ADC shall be idle and the conversion done within the period */
+        if((adcId >= ADC_NUM) || (cmdNum[adcId] >= ADC_CMD_BUFFER_NUM) ||
+           (instant < nextFree[adcId]) ||
+           ((instant + convTicks[adcId]) > periodTicks))
+        {
+            ret = ERR;
+        }
+        else
+        {
+            offset[adcId][cmdNum[adcId]] = (uint16_t)instant;
+            cmdCh[adcId][cmdNum[adcId]] = pipeConfig->samples[idx].channel;
+            cmdNum[adcId]++;
+            nextFree[adcId] = instant + convTicks[adcId];
+        }
+    }
+
+    /* TDGs first: their load is the only step that can fail, and it is not
+       triggered before the TMU below connects it to the PWM */
+    for(adcId = 0U; (adcId < ADC_NUM) && (SUCC == ret); adcId++)
+    {
+        if(cmdNum[adcId] != 0U)
+        {
+            /* TDG: one count per PWM reload, channel k fires the k-th sample */
+            tdgChanged = SET;
+            TDG_Enable(adcPipeTdgTable[adcId], DISABLE);
+            tdgConfig.modVal = (uint16_t)(periodTicks - 1U);
+            tdgConfig.countMode = TDG_COUNT_SINGLE;
+            tdgConfig.clkDivide = pipeConfig->tdgClkDivide;
+            tdgConfig.trigSource = TDG_TRIG_EXTERNAL;
+            tdgConfig.updateMode = TDG_UPDATE_IMMEDIATELY;
+            tdgConfig.clearMode = TDG_CLEAR_MODULATOR;
+            TDG_InitConfig(adcPipeTdgTable[adcId], &tdgConfig);
+
+            for(idx = 0U; idx < ADC_CMD_BUFFER_NUM; idx++)
+            {
+                doConfig.doId = TDG_DO_0;
+                doConfig.offset = (idx < cmdNum[adcId]) ? offset[adcId][idx] : 0U;
+                doConfig.cmd = (idx < cmdNum[adcId]) ? ENABLE : DISABLE;
+                chConfig.channelId = (TDG_ChannelId_t)idx;
+                chConfig.intDelayVal = 0U;
+                chConfig.doNum = 1U;
+                chConfig.doConfig = &doConfig;
+                TDG_ChannelDelayOutputConfig(adcPipeTdgTable[adcId], &chConfig,
+                                             doConfig.cmd);
+                if(idx >= cmdNum[adcId])
+                {
+                    /* unused buffers repeat the first channel */
+                    cmdCh[adcId][idx] = cmdCh[adcId][0];
+                }
+            }
+
+            TDG_Enable(adcPipeTdgTable[adcId], ENABLE);
+            ret = TDG_LoadCmd(adcPipeTdgTable[adcId]);
+        }
+    }
+
+    if((ERR == ret) && (SET == tdgChanged))
+    {
+        /* leave no TDG of the pipeline half configured */
+        for(adcId = 0U; adcId < ADC_NUM; adcId++)
+        {
+            if(cmdNum[adcId] != 0U)
+            {
+                TDG_Enable(adcPipeTdgTable[adcId], DISABLE);
+            }
+        }
+    }
+
+    for(adcId = 0U; (adcId < ADC_NUM) && (SUCC == ret); adcId++)
+    {
+        if(cmdNum[adcId] != 0U)
+        {
+            ADCx = (adc_reg_t *)(adcRegPtr[adcId]);
+
+            /* ADC: CMDk converts on TDG channel k */
+            ADCx->ADC_CTRL.TRIG_MODE_ENABLE = 1U;
+            trigConfig.adcTDGTrigMode = ADC_MAPPING_MODE;
+            trigConfig.adcCmd0 = cmdCh[adcId][0];
+            trigConfig.adcCmd1 = cmdCh[adcId][1];
+            trigConfig.adcCmd2 = cmdCh[adcId][2];
+            trigConfig.adcCmd3 = cmdCh[adcId][3];
+            trigConfig.adcCmd4 = cmdCh[adcId][4];
+            trigConfig.adcCmd5 = cmdCh[adcId][5];
+            trigConfig.loopModeDepth = 0U;
+            ADC_TDGTriggerConfig((ADC_ID_t)adcId, &trigConfig);
+
+            /* TMU: the PWM counter reload starts the TDG */
+            TMU_SetSourceForModule(adcPipeTrigSrcTable[pipeConfig->mcpwmId][pipeConfig->counterId],
+                                   adcPipeTdgTrigTable[adcId]);
+            TMU_ModuleCmd(adcPipeTdgTrigTable[adcId], ENABLE);
+        }
+    }
+
+    if(SUCC == ret)
+    {
+        MCPWM_InitTriggerCmd(pipeConfig->mcpwmId, ENABLE);
+    }
+
+    return ret;
+}
+
 /** @} end of group ADC_Public_Functions */
 
 /** @} end of group ADC_definitions */
@@ -91,6 +91,74 @@ typedef struct
    isr_cb_t * cbf[(uint32_t)CAN_INT_ALL - 1U];   /*!< other call back functions */ 
 } CAN_cbf_t;
 
+/**
+ *  @brief CAN MB address lookup table. It is built from the FD payload 
+ *         configuration in CAN_Init(), so that the MB address and region of
+ *         an MB index can be got without walking the MB RAM regions.
+ */
+typedef struct 
+{
+    uint16_t mbOffset[CAN67_MB_NUM]; /*!< byte offset of each MB from CAN_MB[0] */
+    uint8_t regionPayload[4];        /*!< payload size (in bytes) of each FD MB 
+                                          region */
+    uint8_t mbNum;                   /*!< number of MBs that fit in the MB RAM */
+} CAN_MbAddrTable_t;
+
+/**
+ *  @brief CAN RX ring control. The MB interrupt handler is the only producer
+ *         and CAN_ReceiveBatch() is the only consumer.
+ */
+typedef struct 
+{
+    CAN_RxFrame_t *frameBuf;         /*!< frame storage, NULL if not used */
+    uint32_t frameNum;               /*!< number of frames, power of 2 */
+    volatile uint32_t head;          /*!< write count, updated by producer */
+    volatile uint32_t tail;          /*!< read count, updated by consumer */
+    uint32_t dropCnt;                /*!< frames dropped when ring is full */
+} CAN_RxRing_t;
+
+/**
+ *  @brief CAN TX queue control. Pending frames are kept in a list sorted by
+ *         priority, frames of the same priority keep their send order.
+ */
+typedef struct 
+{
+    CAN_TxQueueFrame_t *frameBuf;    /*!< frame storage, NULL if not used */
+    uint16_t frameNum;               /*!< number of frames */
+    uint16_t pendHead;               /*!< first (highest priority) pending 
+                                          frame */
+    uint16_t freeHead;               /*!< first free frame */
+    uint8_t firstMb;                 /*!< first MB of TX MB pool */
+    uint8_t mbNum;                   /*!< number of MBs in TX MB pool */
+    uint16_t mbFrame[CAN_TX_QUEUE_MB_MAX]; /*!< frame loaded in each pool MB */
+    uint32_t abortMask;              /*!< pool MBs with abort requested */
+    CAN_TxPriMode_t prioMode;        /*!< TX priority mode */
+    CAN_TxQueueStatus_t status;      /*!< queue status */
+} CAN_TxQueue_t;
+
+/**
+ *  @brief CAN software acceptance filter
+ */
+typedef struct 
+{
+    const CAN_FilterEntry_t *entryBuf; /*!< entries checked one by one */
+    uint32_t entryNum;                 /*!< number of entries */
+    const uint32_t *hashBuf;           /*!< hash table of single IDs */
+    uint32_t hashMask;                 /*!< hash table size - 1, 0: not used */
+    FlagStatus_t enable;               /*!< software filter is used */
+} CAN_SwFilter_t;
+
+#if (1U == CAN_STATS_EN)
+/**
+ *  @brief CAN statistics control
+ */
+typedef struct 
+{
+    CAN_Stats_t stats;                 /*!< statistics */
+    uint16_t txStartTime[CAN67_MB_NUM]; /*!< send time of each TX MB */
+} CAN_StatsCtrl_t;
+#endif
+
 /** @} end of group CAN_Private_Type*/
 
 /** @defgroup CAN_Private_Defines
@@ -190,15 +258,17 @@ typedef struct
 #define CAN_RX_FIFO_OCUP_LAST_MB_NUM(x) (5U + ((((x) + 1U) * 8U) >> 2U))
 
 #define CAN_SWAP_BYTES_IN_WORD_INDEX(index)    (((index) & ~3U) + (3U - ((index) & 3U)))
-#define CAN_SWAP_BYTES_IN_WORD(a, b)            REV_BYTES_32(a, b)
+#define CAN_SWAP_BYTES_IN_WORD(a)               COMMON_ReverseBytes(a)
 
 #define CAN_GET_MB_NUM(id)          (((id) < CAN_ID_6) ? CAN05_MB_NUM : CAN67_MB_NUM)
+#define CAN_GET_MB_INT_GROUP_SIZE(id)   (((id) < CAN_ID_6) ? 16U : 32U)
 
 #define CAN_CODE_BUSY_MASK          (0x01U)
 
 #define CAN_RXFIFO_FRAME_AVAILABLE  (5U)
 #define CAN_RXFIFO_WARNING          (6U)
 #define CAN_RXFIFO_OVERFLOW         (7U)
+#define CAN_RXFIFO_INT_MASK         (0xFFU)
 
 #define CAN_STATUS_ALL_MASK        (0xDC00FF00U)
 
@@ -211,6 +281,32 @@ typedef struct
 #define CAN_RAM_FD_SCRATCH_ADDR           (0xF28U)
 #define CAN_RAM_FD_SCRATCH_LEN_IN_WORD    (54U)
 
+#define CAN_RAM_BLOCK_SIZE                (512U)
+#define CAN_RAM_BLOCK_SHIFT               (9U)
+#define CAN_MB_CONFIG_FIELD_SIZE          (8U)
+
+#define CAN_TX_QUEUE_NONE                 (0xFFFFU)
+
+#define CAN_CS_IDE_MASK                   (0x00200000U)
+#define CAN_FILTER_STD_FULL_MASK          (0x7FFU)
+#define CAN_FILTER_B_EXT_MASK             (0x1FFF8000U)
+#define CAN_FILTER_C_FULL_MASK            (0xFFU)
+#define CAN_FILTER_A_GLOBAL_MASK          (0x7FFFFFFEU)
+#define CAN_FILTER_B_GLOBAL_MASK          (0x7FFF7FFFU)
+#define CAN_FILTER_C_GLOBAL_MASK          (0xFFFFFFFFU)
+#define CAN_FILTER_HASH_EMPTY             (0xFFFFFFFFU)
+#define CAN_FILTER_HASH_EXT_FLAG          (0x80000000U)
+#define CAN_FILTER_HASH(key, hashMask)    \
+    ((((key) * 0x9E3779B1U) >> 15U) & (hashMask))
+#define CAN_FILTER_FORMAT_NUM             (3U)
+
+#define CAN_STATS_LATENCY_BIN_NUM         (8U)
+#define CAN_STATS_LATENCY_BIN_SHIFT       (7U)
+#define CAN_STATS_STD_FRAME_BITS          (47U)
+#define CAN_STATS_EXT_FRAME_BITS          (67U)
+#define CAN_MB_CODE_SHIFT                 (24U)
+#define CAN_MB_CODE_MASK                  (0xFU)
+
 /** @} end of group CAN_Private_Defines */
 
 /** @defgroup CAN_Private_Variables
@@ -355,6 +451,18 @@ static uint32_t canIntMaskStatus1[CAN_INSTANCE_NUM] = {
 #endif
 };
 
+static CAN_MbAddrTable_t canMbAddrTable[CAN_INSTANCE_NUM];
+
+static CAN_RxRing_t canRxRing[CAN_INSTANCE_NUM];
+
+static CAN_TxQueue_t canTxQueue[CAN_INSTANCE_NUM];
+
+static CAN_SwFilter_t canSwFilter[CAN_INSTANCE_NUM];
+
+#if (1U == CAN_STATS_EN)
+static CAN_StatsCtrl_t canStats[CAN_INSTANCE_NUM];
+#endif
+
 /** @} end of group CAN_Private_Variables */
 
 /** @defgroup CAN_Global_Variables
@@ -927,46 +1035,52 @@ static uint8_t CAN_GetPayloadSize(CAN_Id_t id,CAN_FdMbRegion_t region)
 }
 
 /**
- * @brief      get the limit of max MB number, the actual MB number can not 
- *             exceed it
+ * @brief      Build the MB address lookup table from the current FD payload
+ *             configuration. It shall be called whenever FDEN or MBDSRx is 
+ *             changed.
  *
  * @param[in]  id: select the CAN ID
  *
- * @return     the limit of max MB number 
+ * @return     none
  *
  */
-static uint8_t CAN_GetMaxMbNumLimit(CAN_Id_t id)
+static void CAN_BuildMbAddrTable(CAN_Id_t id)
 {
-    uint32_t payloadSize;
-    uint8_t configFieldSize = 8U;
-    uint32_t ramBlockSize = 512U;
+    CAN_MbAddrTable_t *table = &canMbAddrTable[id];
+    uint32_t maxRegionIndex;
+    uint32_t region;
     uint32_t mbSize;
-    uint32_t totalMbNum;
-
-    payloadSize = CAN_GetPayloadSize(id,CAN_FD_MB_REGION_0);
-    mbSize= payloadSize + configFieldSize;
-    totalMbNum = ramBlockSize / mbSize;
+    uint32_t regionMaxMbNum;
+    uint32_t ramBlockOffset = 0U;
+    uint32_t mbNum = 0U;
+    uint32_t index;
     
-    payloadSize = CAN_GetPayloadSize(id,CAN_FD_MB_REGION_1);
-    mbSize= payloadSize + configFieldSize;
-    totalMbNum += (ramBlockSize / mbSize);
+    maxRegionIndex = ((uint32_t)id < (uint32_t)CAN_ID_6) ? 
+                     (uint32_t)CAN_FD_MB_REGION_1 : (uint32_t)CAN_FD_MB_REGION_3;
     
-    if((CAN_ID_6 == id ) || (CAN_ID_7 == id))
+    for(region = 0U; region <= maxRegionIndex; region++)
     {
-        payloadSize = CAN_GetPayloadSize(id,CAN_FD_MB_REGION_2);
-        mbSize= payloadSize + configFieldSize;
-        totalMbNum += (ramBlockSize / mbSize);
-    
-        payloadSize = CAN_GetPayloadSize(id,CAN_FD_MB_REGION_3);
-        mbSize= payloadSize + configFieldSize;
-        totalMbNum += (ramBlockSize / mbSize);
+        table->regionPayload[region] = CAN_GetPayloadSize(id, 
+                                                  (CAN_FdMbRegion_t)region);
+        mbSize = (uint32_t)table->regionPayload[region] + 
+                 CAN_MB_CONFIG_FIELD_SIZE;
+        regionMaxMbNum = CAN_RAM_BLOCK_SIZE / mbSize;
+        
+        for(index = 0U; index < regionMaxMbNum; index++)
+        {
+            table->mbOffset[mbNum] = (uint16_t)(ramBlockOffset + 
+                                                index * mbSize);
+            mbNum++;
+        }
+        
+        ramBlockOffset += CAN_RAM_BLOCK_SIZE;
     }
     
-    return (uint8_t)totalMbNum;
+    table->mbNum = (uint8_t)mbNum;
 }
 
 /**
- * @brief      get the start address of a MB
+ * @brief      get the start address of a MB from the MB address lookup table
  *
  * @param[in]  id: select the CAN ID
  * @param[in]  mbIdx: MB index
@@ -983,1084 +1097,2210 @@ static ResultStatus_t CAN_GetMbAddr(CAN_Id_t id,uint8_t mbIdx,
                                       CAN_Mb_t **addr)
 {
     can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
-    uint8_t payloadSize;
-    uint8_t configFieldSize = 8U;
-    uint32_t ramBlockSize = 512U;
-    uint32_t ramBlockOffset = 0U;
-    uint32_t mbSize;
-    uint32_t regionMaxMbNum = 0U;
+    const CAN_MbAddrTable_t *table = &canMbAddrTable[id];
     uint32_t mbOffset;
-    CAN_FdMbRegion_t maxRegionIndex;
-    uint32_t maxRamSize;
-    uint32_t index;
     ResultStatus_t res = SUCC;
     
-    if(region != NULL)
+    if(mbIdx >= table->mbNum)
     {
-        *region = CAN_FD_MB_REGION_0;
+        res = ERR;
     }
-    
-    maxRegionIndex = ((uint32_t)id < (uint32_t)CAN_ID_6) ? CAN_FD_MB_REGION_1 : 
-                                         CAN_FD_MB_REGION_3;
-    
-    for(index = 0U; index <= (uint32_t)maxRegionIndex; index++)
+    else
     {
-        mbIdx -= (uint8_t)regionMaxMbNum;
-        
-        payloadSize = CAN_GetPayloadSize(id,(CAN_FdMbRegion_t)index);
-        mbSize= (uint32_t)payloadSize + (uint32_t)configFieldSize;
-        regionMaxMbNum  = ramBlockSize / mbSize;
+        mbOffset = table->mbOffset[mbIdx];
         
         if(region != NULL)
         {
-            *region = (CAN_FdMbRegion_t)index;
+            *region = (CAN_FdMbRegion_t)(mbOffset >> CAN_RAM_BLOCK_SHIFT);
         }
         
-        if(mbIdx < regionMaxMbNum)
-        {
-            /* Multiply the MB index by the MB size (in words) */
-            mbOffset = ramBlockOffset + mbIdx * mbSize;
-            /*PRQA S 0303 ++*/
-            *addr = (CAN_Mb_t *)((uint32_t)&(CANx->CAN_MB[0]) + mbOffset);
-            /*PRQA S 0303 --*/
-            break;
-        }
-        else
-        {
-            ramBlockOffset += 512U;
-        }
-    }
-    maxRamSize = ((uint32_t)id < (uint32_t)CAN_ID_6)? CAN05_RAM_SIZE_IN_BYTE : 
-                  CAN67_RAM_SIZE_IN_BYTE;
-    if(ramBlockOffset >= maxRamSize)
-    {
-        res = ERR;
+        /*PRQA S 0303 ++*/
+        *addr = (CAN_Mb_t *)((uint32_t)&(CANx->CAN_MB[0]) + mbOffset);
+        /*PRQA S 0303 --*/
     }
       
     return res;
 }
 
 /**
- * @brief Set TX message buffer.It copys user's buffer into the message buffer 
- * data area and configure the message buffer as required for transmission.
+ * @brief      Copy a message payload into the data words of a MB. Every MB 
+ *             data word is written exactly once, the bytes are reordered with
+ *             the REV instruction when the user buffer is word aligned.
  *
- * @param[in]  id: select the CAN ID
- * @param[in]  mbIdx: MB index
- * @param[in]  messInfo: message info config
- * @param[in]  msgId: config message id
- * @param[in]  msgData: message data
- * @param[in]  code: code command
- * @param[in]  localPrio: priority
+ * @param[in]  mbData: points to the data words of the MB
+ * @param[in]  msgData: data of the message
+ * @param[in]  dataLen: length of the message data in bytes
+ * @param[in]  dataSize: payload size in bytes of the DLC used for the message
+ * @param[in]  padding: value filled into the bytes from dataLen to dataSize
+ *
+ * @return     none
  *
- * @return 
- *        -SUCC: set tx MB successfully
- *        -ERR:  fail to tx MB 
  */
-static ResultStatus_t CAN_SetTxMb(CAN_Id_t id, uint8_t mbIdx,
-                                      const CAN_MessageInfo_t *messInfo, 
-                                      uint32_t msgId, const uint8_t *msgData,
-                                      uint32_t code, uint8_t localPrio)
+static void CAN_CopyPayloadToMb(volatile uint32_t *mbData, 
+                                const uint8_t *msgData, uint32_t dataLen,
+                                uint32_t dataSize, uint8_t padding)
 {
-    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
-    ResultStatus_t retVal = SUCC;
-    uint8_t count;
-    uint8_t tmpNum;
-    uint8_t tmpIndex;
-    uint32_t dlc;
-    uint32_t dataSize;
-    CAN_FdMbRegion_t region;
-    CAN_Mb_t *mbAddr;
-    volatile uint8_t  *mbData;
+    uint32_t wordNum = dataLen >> 2U;
+    uint32_t wordIdx = 0U;
+    uint32_t byteIdx;
+    uint32_t count;
+    uint32_t word;
+    const uint32_t *msgWord;
     
-    if(ERR == CAN_GetMbAddr(id, mbIdx, &region, &mbAddr))
-    {
-        retVal = ERR;
-    }
-    else if(messInfo->dataLen > 64U)
+    /*PRQA S 0306 ++*/
+    if(0U == ((uint32_t)msgData & 0x3U))
+    /*PRQA S 0306 --*/
     {
-        retVal = ERR;
+        /*PRQA S 0310, 3305 ++*/
+        msgWord = (const uint32_t *)(const void *)msgData;
+        /*PRQA S 0310, 3305 --*/
+        
+        /* 16 bytes per iteration, a 64-byte FD payload takes 4 iterations */
+        while((wordIdx + 4U) <= wordNum)
+        {
+            mbData[wordIdx] = COMMON_ReverseBytes(msgWord[wordIdx]);
+            mbData[wordIdx + 1U] = COMMON_ReverseBytes(msgWord[wordIdx + 1U]);
+            mbData[wordIdx + 2U] = COMMON_ReverseBytes(msgWord[wordIdx + 2U]);
+            mbData[wordIdx + 3U] = COMMON_ReverseBytes(msgWord[wordIdx + 3U]);
+            wordIdx += 4U;
+        }
+        
+        while(wordIdx < wordNum)
+        {
+            mbData[wordIdx] = COMMON_ReverseBytes(msgWord[wordIdx]);
+            wordIdx++;
+        }
     }
     else
     {
-        mbData = (volatile uint8_t *)(&mbAddr->data[0]);
-    
-        if(ERR == CAN_CheckMbId(id,mbIdx))
+        while(wordIdx < wordNum)
         {
-            retVal = ERR;
+            byteIdx = wordIdx << 2U;
+            mbData[wordIdx] = ((uint32_t)msgData[byteIdx] << 24U) |
+                              ((uint32_t)msgData[byteIdx + 1U] << 16U) |
+                              ((uint32_t)msgData[byteIdx + 2U] << 8U) |
+                              (uint32_t)msgData[byteIdx + 3U];
+            wordIdx++;
         }
-        else
+    }
+    
+    /* The last partial word and the padding words */
+    while((wordIdx << 2U) < dataSize)
+    {
+        word = 0U;
+        for(count = 0U; count < 4U; count++)
         {
-            if(CANx->CAN_MCR.FDEN != 0U)
-            {
-                if(messInfo->brsEn == ENABLE)
-                {
-                    CANx->CAN_FDCTRL.FD_RATE = 1U;
-                }
-            }
-        
-            if(messInfo->dataLen > CAN_GetPayloadSize(id,region))
-            {
-                retVal = ERR;
-            }
-            else
-            {
-                CAN_ComputeDlcAndDataSize(messInfo->dataLen,&dlc, &dataSize);   
-        
-                /* Copy user's buffer into the message buffer data area */
-                if(msgData != NULL)
-                {
-                    tmpNum = (uint8_t)(messInfo->dataLen >> 2U);
-                    for (count = 0; count < tmpNum; count += 1U)
-                    {
-                        mbAddr->data[count] = ((uint32_t)msgData[count*4U] << 24U) |
-                                             ((uint32_t)msgData[count*4U + 1U] << 16U)|
-                                             ((uint32_t)msgData[count*4U + 2U] << 8U) |
-                                             (uint32_t)msgData[count*4U + 3U];   
-                    }
-
-                    for ( count = tmpNum*4U; count < messInfo->dataLen; count++)
-                    {
-                        tmpIndex = CAN_SWAP_BYTES_IN_WORD_INDEX(count) & 0x3FU;
-                        mbData[tmpIndex] =  msgData[count];
-                    }
-                    /* Add padding, if needed */
-                    for (count = messInfo->dataLen; count < (uint8_t)dataSize; count++)
-                    {
-                        tmpIndex = CAN_SWAP_BYTES_IN_WORD_INDEX(count) & 0x3FU;
-                        mbData[tmpIndex] = messInfo->fdPadding;
-                    }
-                }        
-            
-                mbAddr->config.WORDVAL = 0U;
-                mbAddr->id.WORDVAL = 0U;   
-                /* set DLC */
-                mbAddr->config.BF.DLC = dlc;
-            
-                /* Set the ID according the format structure */
-                if (CAN_MSG_ID_EXT == messInfo->idType)
-                {
-                    /* ID [28-0] */
-                    mbAddr->id.WORDVAL = msgId & CAN_ID_EXT_MASK;
-                    mbAddr->id.BF.PRIO = localPrio;
-                    /* Set IDE */
-                    mbAddr->config.BF.IDE = 1U;
-                    /* Clear SRR bit */
-                    mbAddr->config.BF.SRR = 0U;
-                }
-                else
-                {
-                    /* ID[28-18] */
-                    mbAddr->id.BF.ID_STANDARD = msgId;
-                    mbAddr->id.BF.PRIO = localPrio;
-
-                    /* clear IDE  */
-                    mbAddr->config.BF.IDE = 0U;
-                    /* Clear SRR bit */
-                    mbAddr->config.BF.SRR = 0U;
-                }
-                
-                if(SET == messInfo->remoteFlag )
-                {
-                    /* Set RTR bit */
-                    mbAddr->config.BF.RTR = 1U;
-                }
-                
-                /* Set MB CODE */
-                /* Reset the code */
-                mbAddr->config.BF.CODE = 0U;
-                        
-                if (ENABLE == messInfo->fdEn)
-                {
-                    mbAddr->config.BF.EDL = 1U;
-                }
-                        
-                mbAddr->config.BF.BRS = (uint32_t)(messInfo->brsEn);
-                        
-                /* Set the code */
-                mbAddr->config.BF.CODE = code;           
-            }
+            byteIdx = (wordIdx << 2U) + count;
+            word = (word << 8U) | 
+                   (uint32_t)((byteIdx < dataLen) ? msgData[byteIdx] : padding);
         }
-        
+        mbData[wordIdx] = word;
+        wordIdx++;
     }
-    return retVal;
 }
 
 /**
- * @brief Set Rx message buffer. It copys user's buffer into the message buffer 
- * data area and configure the message buffer as required for transmission.
- *
- * @param[in]  id: select the CAN ID
- * @param[in]  mbIdx: MB index
- * @param[in]  idType: CAN Message ID type
- * @param[in]  msgId: config message id
- * @param[in]  code: code command
+ * @brief      Copy the payload in the data words of a MB into a user buffer.
+ *             Every MB data word is read exactly once, the bytes are 
+ *             reordered with the REV instruction.
  *
- * @return  ERR/SUCC
+ * @param[in]  mbData: points to the data words of the MB
+ * @param[out] msgData: points to the buffer where the payload will be stored
+ * @param[in]  payloadSize: payload size in bytes
  *
+ * @return     none
  *
  */
-static ResultStatus_t CAN_SetRxMb(CAN_Id_t id, uint8_t mbIdx,
-                                  CAN_MsgId_t idType, 
-                                  uint32_t msgId, uint32_t code)
+static void CAN_CopyPayloadFromMb(const volatile uint32_t *mbData, 
+                                  uint8_t *msgData, uint32_t payloadSize)
 {
-    CAN_FdMbRegion_t region;
-    CAN_Mb_t *mbAddr;
-    ResultStatus_t retVal = SUCC;
-    if(ERR == CAN_GetMbAddr(id, mbIdx, &region, &mbAddr))
-    {
-        retVal = ERR;
-    }  
-    else if(ERR == CAN_CheckMbId(id,mbIdx))
-    {
-        retVal = ERR;
-    }
-    else
+    uint32_t wordNum = payloadSize >> 2U;
+    uint32_t wordIdx = 0U;
+    uint32_t byteIdx;
+    uint32_t word;
+    uint32_t *msgWord;
+    
+    /*PRQA S 0306 ++*/
+    if(0U == ((uint32_t)msgData & 0x3U))
+    /*PRQA S 0306 --*/
     {
-        mbAddr->config.WORDVAL = 0U;
-        mbAddr->id.WORDVAL = 0U;   
+        /*PRQA S 0310, 3305 ++*/
+        msgWord = (uint32_t *)(void *)msgData;
+        /*PRQA S 0310, 3305 --*/
         
-        /* Set the ID according to the format structure */
-        if (CAN_MSG_ID_EXT == idType)
+        /* 16 bytes per iteration, a 64-byte FD payload takes 4 iterations */
+        while((wordIdx + 4U) <= wordNum)
         {
-            /* ID [28-0] */
-            mbAddr->id.WORDVAL = msgId & CAN_ID_EXT_MASK;
-            /* Set IDE */
-            mbAddr->config.BF.IDE = 1U;
-            /* Clear SRR bit */
-            mbAddr->config.BF.SRR = 0U;
+            msgWord[wordIdx] = COMMON_ReverseBytes(mbData[wordIdx]);
+            msgWord[wordIdx + 1U] = COMMON_ReverseBytes(mbData[wordIdx + 1U]);
+            msgWord[wordIdx + 2U] = COMMON_ReverseBytes(mbData[wordIdx + 2U]);
+            msgWord[wordIdx + 3U] = COMMON_ReverseBytes(mbData[wordIdx + 3U]);
+            wordIdx += 4U;
         }
-        else
+        
+        while(wordIdx < wordNum)
         {
-            /* ID[28-18] */
-            mbAddr->id.BF.ID_STANDARD = msgId;
-
-            /* clear IDE  */
-            mbAddr->config.BF.IDE = 0U;
-            /* Clear SRR bit */
-            mbAddr->config.BF.SRR = 0U;
+            msgWord[wordIdx] = COMMON_ReverseBytes(mbData[wordIdx]);
+            wordIdx++;
         }
-        
-        if(code != CAN_NOT_USED)
+    }
+    
+    /* Unaligned buffer or the last partial word */
+    byteIdx = wordIdx << 2U;
+    while(byteIdx < payloadSize)
+    {
+        word = COMMON_ReverseBytes(mbData[wordIdx]);
+        do
         {
-            mbAddr->config.BF.CODE = code;
-        }       
+            msgData[byteIdx] = (uint8_t)word;
+            word >>= 8U;
+            byteIdx++;
+        } while(((byteIdx & 0x3U) != 0U) && (byteIdx < payloadSize));
+        wordIdx++;
     }
-    return retVal;
 }
 
-
+#if (1U == CAN_STATS_EN)
 /**
- * @brief Clears CAN memory positions that require initialization.
+ * @brief      Record a transmitted or received frame in the statistics
  *
  * @param[in]  id: select the CAN ID
- * 
- * @return none
+ * @param[in]  cs: CS word of the frame
+ * @param[in]  isTx: SET if the frame is transmitted
+ *
+ * @return     none
  *
  */
-static void CAN_ClearRam(CAN_Id_t id)
+static void CAN_StatsFrame(CAN_Id_t id, uint32_t cs, FlagStatus_t isTx)
 {
-    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
-    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint32_t dataByte;
-    uint32_t ramSize;
-    uint32_t rxImrSize;
-    volatile uint32_t *RAM = &(CANxw->CAN_MB[0].MB0);
+    CAN_Stats_t *stats = &canStats[id].stats;
+    uint32_t dataLen;
     
-    if((uint32_t)id < (uint32_t)CAN_ID_6)
+    dataLen = CAN_ComputePayloadSize((uint8_t)((cs >> 16U) & 0xFU));
+    
+    if(SET == isTx)
     {
-        ramSize = CAN05_RAM_SIZE_IN_WORD;
-        rxImrSize = CAN05_MB_NUM;
+        stats->txFrameCnt++;
+        stats->txByteCnt += dataLen;
     }
     else
     {
-        ramSize = CAN67_RAM_SIZE_IN_WORD;
-        rxImrSize = CAN67_MB_NUM;
+        stats->rxFrameCnt++;
+        stats->rxByteCnt += dataLen;
     }
-
-    CANx->CAN_CTRL2.WRMFRZ = 1U;
-    /* Clear MB region */
-    for (dataByte = 0U; dataByte < ramSize; dataByte++)
-    {
-        RAM[dataByte] = 0x0U;
-    }
-
-    RAM = &(CANxw->CAN_RXIMR[0]);
-
-    /* Clear RXIMR region */
-    for (dataByte = 0; dataByte < rxImrSize; dataByte++)
-    {
-        RAM[dataByte] = 0xFFFFFFFFU;
-    }
-    
-    /* init mask */
-    CANxw->CAN_RXMGMSK = 0xFFFFFFFFU;
-    CANxw->CAN_RX14MASK = 0xFFFFFFFFU;
-    CANxw->CAN_RX15MASK = 0xFFFFFFFFU;
-    
-    /* RX FIFO global mask */
-    CANxw->CAN_RXFGMASK = 0xFFFFFFFFU;
-  
-    /* RX FIFO */
-    /*PRQA S 0303 ++*/
-    RAM = (volatile uint32_t*)((uint32_t)canRegPtr[id] + CAN_RAM_RX_FIFO_ADDR);
-    /*PRQA S 0303 --*/
-    for (dataByte = 0U; dataByte < CAN_RAM_RX_FIFO_LEN_IN_WORD; dataByte++)
-    {
-        RAM[dataByte] = 0U;
-    }
-    
-    /* RXMGMASK, RXFGMASK, RX14MSK, RX15MASK */
-    /*PRQA S 0303 ++*/
-    RAM = (volatile uint32_t*)((uint32_t)canRegPtr[id] + CAN_RAM_MSK_ADDR);
-    /*PRQA S 0303 --*/
-    for (dataByte = 0U; dataByte < CAN_RAM_MSK_LEN_IN_WORD; dataByte++)
-    {
-        RAM[dataByte] = 0xFFFFFFFFU;
-    }
-    
-    /* Rx_SMB0, Rx_SMB1 */
-    /*PRQA S 0303 ++*/
-    RAM = (volatile uint32_t*)((uint32_t)canRegPtr[id] + CAN_RAM_RX_SMB_ADDR);
-    /*PRQA S 0303 --*/
-    for (dataByte = 0U; dataByte < CAN_RAM_RX_SMB_LEN_IN_WORD; dataByte++)
-    {
-        RAM[dataByte] = 0U;
-    }
-    
-    /* CAN-FD scratch memory */
-    /*PRQA S 0303 ++*/
-    RAM = (volatile uint32_t*)((uint32_t)canRegPtr[id] + CAN_RAM_FD_SCRATCH_ADDR);    
-    /*PRQA S 0303 --*/
-    for (dataByte = 0U; dataByte < CAN_RAM_FD_SCRATCH_LEN_IN_WORD; dataByte++)
-    {
-        RAM[dataByte] = 0U;
-    }
-    CANx->CAN_CTRL2.WRMFRZ = 0U;
-}
+    
+    stats->busBitCnt += (((cs & CAN_CS_IDE_MASK) != 0U) ? 
+                         CAN_STATS_EXT_FRAME_BITS : CAN_STATS_STD_FRAME_BITS) +
+                        (dataLen << 3U);
+}
 
 /**
- * @brief      CAN handler for bus off/ bus off done interrupts
+ * @brief      Record the MB of an MB interrupt in the statistics. A TX MB
+ *             records its latency from the send time to the time stamp of
+ *             the transmitted frame.
  *
  * @param[in]  id: select the CAN ID
+ * @param[in]  mbIdx: MB index
  *
- * @return    none
+ * @return     none
  *
- */ 
-static void CAN_BusOffHandler(CAN_Id_t id)
+ */
+static void CAN_StatsMb(CAN_Id_t id, uint32_t mbIdx)
 {
-    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint32_t status;
-    
-    status = CANxw->CAN_ESR1; 
-    /* only check enabled interrupts */
-    status = status & (canIntMaskStatus1[id] & CAN_INT_MSK_FLAG_ALL_BUSOFF);
-    /* clear int status */
-    CANxw->CAN_ESR1 = status;
+    CAN_StatsCtrl_t *ctrl = &canStats[id];
+    CAN_FdMbRegion_t region;
+    CAN_Mb_t *mbAddr;
+    uint32_t cs;
+    uint32_t code;
+    uint32_t latency;
+    uint32_t bin;
     
-    /* bus off interrupt */
-    if((status & CAN_INT_MSK_FLAG_BUS_OFF) != 0U)
+    if(SUCC == CAN_GetMbAddr(id, mbIdx, &region, &mbAddr))
     {
-        if(canIsrCbFunc[id].cbf[CAN_INT_BUS_OFF] != NULL)
-        {
-            canIsrCbFunc[id].cbf[CAN_INT_BUS_OFF]();
-        }
-        else
+        /* it locks the MB, it is unlocked when CAN_TIMER is read at the end
+           of the MB interrupt */
+        cs = mbAddr->config.WORDVAL;
+        code = (cs >> CAN_MB_CODE_SHIFT) & CAN_MB_CODE_MASK;
+        
+        if(CAN_TX_INACTIVE == code)
         {
-            if(SUCC != CAN_IntMask(id, CAN_INT_BUS_OFF, MASK, 0, 0, 0, 0))
+            CAN_StatsFrame(id, cs, SET);
+            
+            latency = (uint16_t)((uint16_t)cs - ctrl->txStartTime[mbIdx]);
+            bin = 0U;
+            if(latency >= (1UL << CAN_STATS_LATENCY_BIN_SHIFT))
             {
+                bin = 32U - COMMON_CountLeadingZeros(latency) - 
+                      CAN_STATS_LATENCY_BIN_SHIFT;
+                if(bin >= CAN_STATS_LATENCY_BIN_NUM)
+                {
+                    bin = CAN_STATS_LATENCY_BIN_NUM - 1U;
+                }
             }
-        }            
-    }
-    
-    /* bus off done interrupt */
-    if((status & CAN_INT_MSK_FLAG_BUS_OFF_DONE) != 0U)
-    {
-        if(canIsrCbFunc[id].cbf[CAN_INT_BUS_OFF_DONE] != NULL)
+            ctrl->stats.txLatencyHist[bin]++;
+        }
+        else if(((uint32_t)CAN_MB_RX_FULL == code) || 
+                ((uint32_t)CAN_MB_RX_OVERRUN == code))
         {
-            canIsrCbFunc[id].cbf[CAN_INT_BUS_OFF_DONE]();
+            CAN_StatsFrame(id, cs, RESET);
         }
         else
         {
-            if(SUCC != CAN_IntMask(id, CAN_INT_BUS_OFF_DONE, MASK, 0, 0, 0, 0))
-            {
-            }
-        }            
+            /* aborted TX or no frame */
+        }
     }
-    
 }
 
 /**
- * @brief      CAN Handler for TX warning interrupt
+ * @brief      Record the errors of an error interrupt in the statistics
  *
  * @param[in]  id: select the CAN ID
+ * @param[in]  esr1: ESR1 value of the error interrupt
  *
- * @return    none
+ * @return     none
  *
- */ 
-static void CAN_TxWarnHandler(CAN_Id_t id)
+ */
+static void CAN_StatsErr(CAN_Id_t id, uint32_t esr1)
 {
-    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    
-    /* clear TX warning interrupt status */
-    CANxw->CAN_ESR1 = CAN_INT_MSK_FLAG_TXW;
+    CAN_Stats_t *stats = &canStats[id].stats;
+    /* nominal and fast error flags */
+    uint32_t status = esr1 | (esr1 >> 16U);
     
-    if(canIsrCbFunc[id].cbf[CAN_INT_TXW] != NULL)
+    stats->errIntCnt++;
+    if((status & (1UL << (uint32_t)CAN_STATUS_STUFF_ERR)) != 0U)
     {
-        canIsrCbFunc[id].cbf[CAN_INT_TXW]();
+        stats->stuffErrCnt++;
     }
-    else
+    if((status & (1UL << (uint32_t)CAN_STATUS_FORM_ERR)) != 0U)
     {
-        if(SUCC != CAN_IntMask(id, CAN_INT_TXW, MASK, 0, 0, 0, 0))
-        {
-        }
-    }  
+        stats->formErrCnt++;
+    }
+    if((status & (1UL << (uint32_t)CAN_STATUS_CRC_ERR)) != 0U)
+    {
+        stats->crcErrCnt++;
+    }
+    if((status & (1UL << (uint32_t)CAN_STATUS_ACK_ERR)) != 0U)
+    {
+        stats->ackErrCnt++;
+    }
+    if((status & ((1UL << (uint32_t)CAN_STATUS_BIT0_ERR) | 
+                  (1UL << (uint32_t)CAN_STATUS_BIT1_ERR))) != 0U)
+    {
+        stats->bitErrCnt++;
+    }
 }
+#endif
 
 /**
- * @brief      CAN Handler for RX warning interrupt
+ * @brief      Read the ID, CS and payload of a MB into a message buffer.
+ *             The MB shall be locked by the caller if it is a RX MB.
  *
- * @param[in]  id: select the CAN ID
+ * @param[in]  mbAddr: start address of the MB
+ * @param[in]  maxPayload: payload size of the MB region
+ * @param[out] msgBuff: point to the address where the message buffer will be 
+ *                      stored
  *
- * @return    none
+ * @return     none
  *
  */
-static void CAN_RxWarnHandler(CAN_Id_t id)
+static void CAN_ReadMbFrame(const CAN_Mb_t *mbAddr, uint8_t maxPayload,
+                            CAN_MsgBuf_t *msgBuff)
 {
-    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
+    uint8_t payloadSize;
     
-    /* clear interrupt status */
-    CANxw->CAN_ESR1 = CAN_INT_MSK_FLAG_RXW;
+    payloadSize = CAN_ComputePayloadSize((uint8_t)(mbAddr->config.BF.DLC));
+    if(payloadSize > maxPayload)
+    {
+        payloadSize = maxPayload;
+    }
     
-    if(canIsrCbFunc[id].cbf[CAN_INT_RXW] != NULL)
+    msgBuff->dataLen = payloadSize;
+    msgBuff->cs = mbAddr->config.WORDVAL;
+    if(mbAddr->config.BF.IDE != 0U)
     {
-        canIsrCbFunc[id].cbf[CAN_INT_RXW]();
+        msgBuff->msgId = mbAddr->id.WORDVAL & CAN_ID_EXT_MASK;
     }
     else
     {
-        if(SUCC != CAN_IntMask(id, CAN_INT_RXW, MASK, 0, 0, 0, 0))
-        {
-        }
-    }  
+        msgBuff->msgId = mbAddr->id.BF.ID_STANDARD;
+    }
+    
+    CAN_CopyPayloadFromMb(&mbAddr->data[0], msgBuff->data, payloadSize);
 }
 
 /**
- * @brief      CAN Handler for Error interrupt
+ * @brief      Check an ID against the software acceptance filter
  *
- * @param[in]  id: select the CAN ID
+ * @param[in]  filter: points to the software filter
+ * @param[in]  idType: standard or extended ID
+ * @param[in]  msgId: the ID to be checked
  *
- * @return    none
+ * @return     SET: the ID is accepted
+ *             RESET: the ID is rejected
  *
  */
-static void CAN_ErrHandler(CAN_Id_t id)
+static FlagStatus_t CAN_SwFilterMatch(const CAN_SwFilter_t *filter,
+                                      CAN_MsgId_t idType, uint32_t msgId)
 {
-    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    
-    canEsr1Buf[id] = CANxw->CAN_ESR1;
+    const CAN_FilterEntry_t *entry;
+    uint32_t key;
+    uint32_t index;
+    uint32_t i;
+    FlagStatus_t ret = RESET;
     
-    /* clear interrupt status */
-    CANxw->CAN_ESR1 = CAN_INT_MSK_FLAG_ERR;
-        
-    if(canIsrCbFunc[id].cbf[CAN_INT_ERR] != NULL)
+    if(filter->hashMask != 0U)
     {
-        canIsrCbFunc[id].cbf[CAN_INT_ERR]();
+        key = (CAN_MSG_ID_EXT == idType) ? (msgId | CAN_FILTER_HASH_EXT_FLAG) :
+                                           msgId;
+        index = CAN_FILTER_HASH(key, filter->hashMask);
+        while(filter->hashBuf[index] != CAN_FILTER_HASH_EMPTY)
+        {
+            if(filter->hashBuf[index] == key)
+            {
+                ret = SET;
+                break;
+            }
+            index = (index + 1U) & filter->hashMask;
+        }
     }
-    else
+    
+    for(i = 0U; (RESET == ret) && (i < filter->entryNum); i++)
     {
-        if(SUCC != CAN_IntMask(id, CAN_INT_ERR, MASK, 0, 0, 0, 0))
+        entry = &filter->entryBuf[i];
+        if((entry->idType == idType) && 
+           (((msgId ^ entry->id) & entry->mask) == 0U))
         {
+            ret = SET;
         }
-    }  
+    }
     
-    canEsr1Buf[id] = 0;
+    return ret;
 }
 
 /**
- * @brief      CAN Handler for Error fast interrupt (CAN_INT_ERR_FAST)
+ * @brief      Get the next free frame of the RX ring. It is only called by the
+ *             MB interrupt handlers.
  *
  * @param[in]  id: select the CAN ID
  *
- * @return    none
+ * @return     the free frame, or NULL if the ring is full
  *
  */
-static void CAN_ErrFdHandler(CAN_Id_t id)
+static CAN_RxFrame_t * CAN_RxRingGetFreeFrame(CAN_Id_t id)
 {
-    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
+    CAN_RxRing_t *ring = &canRxRing[id];
+    CAN_RxFrame_t *frame = NULL;
     
-    canEsr1Buf[id] = CANxw->CAN_ESR1;
-    
-    /* clear interrupt status */
-    CANxw->CAN_ESR1 = CAN_INT_MSK_FLAG_ERR_FAST;
-    
-    if(canIsrCbFunc[id].cbf[CAN_INT_ERR_FAST] != NULL)
+    if((ring->head - ring->tail) < ring->frameNum)
     {
-        canIsrCbFunc[id].cbf[CAN_INT_ERR_FAST]();
+        frame = &ring->frameBuf[ring->head & (ring->frameNum - 1U)];
     }
     else
     {
-        if(SUCC != CAN_IntMask(id, CAN_INT_ERR_FAST, MASK, 0, 0, 0, 0))
-        {
-        }
-    }  
+        ring->dropCnt++;
+    }
     
-    canEsr1Buf[id] = 0;
+    return frame;
 }
 
 /**
- * @brief      CAN Handler for pretended networking wakeup interrupt including
- *             CAN_INT_PN_WAKE_MATCH and CAN_INT_PN_WAKE_TIMEOUT
+ * @brief      Publish the frame got by CAN_RxRingGetFreeFrame() to the 
+ *             consumer.
  *
- * @param[in]   id: select the CAN ID
+ * @param[in]  id: select the CAN ID
  *
- * @return    none
+ * @return     none
  *
  */
-static void CAN_PnWakeHandler(CAN_Id_t id)
+static void CAN_RxRingCommit(CAN_Id_t id)
 {
-    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint32_t status;
-    
-    status = CANxw->CAN_WU_MTC; 
-    /* only check enabled interrupts */
-    status = status & (CANxw->CAN_CTRL1_PN & CAN_INT_MSK_FLAG_ALL_PN);
-    /* clear int status */
-    CANxw->CAN_WU_MTC = status;
-    
-    /* wakeup match interrupt */
-    if((status & CAN_INT_MSK_FLAG_PN_WAKEUP_MATCH) != 0U)
-    {
-        if(canIsrCbFunc[id].cbf[CAN_INT_PN_WAKEUP_MATCH] != NULL)
-        {
-            canIsrCbFunc[id].cbf[CAN_INT_PN_WAKEUP_MATCH]();
-        }
-        else
-        {
-            if(SUCC != CAN_IntMask(id, CAN_INT_PN_WAKEUP_MATCH, MASK, 0, 0, 0, 0))
-            {
-            }
-        }            
-    }
-    
-    /* wakeup timeout interrupt */
-    if((status & CAN_INT_MSK_FLAG_PN_WAKEUP_TIMEOUT) != 0U)
-    {
-        if(canIsrCbFunc[id].cbf[CAN_INT_PN_WAKEUP_TIMEOUT] != NULL)
-        {
-            canIsrCbFunc[id].cbf[CAN_INT_PN_WAKEUP_TIMEOUT]();
-        }
-        else
-        {
-            if(SUCC != CAN_IntMask(id, CAN_INT_PN_WAKEUP_TIMEOUT, MASK, 0, 0, 0, 0))
-            {
-            }
-        }            
-    }
+    /* The frame shall be written before it is visible to the consumer */
+    COMMON_DMB();
+    canRxRing[id].head++;
 }
 
 /**
- * @brief      CAN Handler for self wakeup interrupt
+ * @brief      Save a received MB frame into the RX ring and free the MB.
  *
  * @param[in]  id: select the CAN ID
+ * @param[in]  mbIdx: MB index
  *
- * @return    none
+ * @return     SET: the MB is a RX MB and it has been handled by the RX ring
+ *             RESET: the RX ring is not used or the MB is not a full RX MB
  *
  */
-static void CAN_SelfWakeupHandler(CAN_Id_t id)
+static FlagStatus_t CAN_RxRingSaveMb(CAN_Id_t id, uint32_t mbIdx)
 {
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
+    CAN_FdMbRegion_t region;
+    CAN_Mb_t *mbAddr;
+    CAN_RxFrame_t *frame;
+    uint32_t code;
+    FlagStatus_t ret = RESET;
     
-    /* clear interrupt status */
-    CANxw->CAN_ESR1 = CAN_INT_MSK_FLAG_SELF_WAKEUP;
-    
-    if(canIsrCbFunc[id].cbf[CAN_INT_SELF_WAKEUP] != NULL)
+    if(NULL == canRxRing[id].frameBuf)
     {
-        canIsrCbFunc[id].cbf[CAN_INT_SELF_WAKEUP]();
+        /* RX ring is not used */
     }
-    else
+    else if(SUCC == CAN_GetMbAddr(id, (uint8_t)mbIdx, &region, &mbAddr))
     {
-        if(SUCC != CAN_IntMask(id, CAN_INT_SELF_WAKEUP, MASK, 0, 0, 0, 0))
+        /* Lock the mailbox by reading it */
+        code = mbAddr->config.BF.CODE;
+        
+        if(((uint32_t)CAN_MB_RX_FULL == code) || 
+           ((uint32_t)CAN_MB_RX_OVERRUN == code))
+        {
+            frame = CAN_RxRingGetFreeFrame(id);
+            if(frame != NULL)
+            {
+                CAN_ReadMbFrame(mbAddr, canMbAddrTable[id].regionPayload[region],
+                                &frame->msg);
+                frame->timeStamp = (uint16_t)frame->msg.cs;
+                frame->mbIdx = (uint8_t)mbIdx;
+                CAN_RxRingCommit(id);
+            }
+            
+            /* Free the MB for the next frame */
+            mbAddr->config.BF.CODE = (uint32_t)CAN_MB_RX_EMPTY;
+            ret = SET;
+        }
+        
+        /* Unlock the mailbox by reading the free running timer */
+        (void)CANxw->CAN_TIMER;
+    }
+    else
+    {
+        /*nothing to do*/
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief      Save the frame on top of RX FIFO into the RX ring. The frame is 
+ *             popped from RX FIFO when the frame available flag is cleared.
+ *             Frames rejected by the software acceptance filter are dropped.
+ *
+ * @param[in]  id: select the CAN ID
+ *
+ * @return     SET: the frame has been handled by the RX ring
+ *             RESET: the RX ring is not used
+ *
+ */
+static FlagStatus_t CAN_RxRingSaveFifo(CAN_Id_t id)
+{
+    CAN_RxFrame_t *frame;
+    CAN_MsgId_t idType;
+    FlagStatus_t ret = RESET;
+    
+    if(canRxRing[id].frameBuf != NULL)
+    {
+        frame = CAN_RxRingGetFreeFrame(id);
+        if(frame != NULL)
+        {
+            CAN_ReadRxFifo(id, &frame->msg);
+            frame->timeStamp = (uint16_t)frame->msg.cs;
+            frame->mbIdx = CAN_RX_RING_FIFO_IDX;
+            idType = ((frame->msg.cs & CAN_CS_IDE_MASK) != 0U) ? 
+                     CAN_MSG_ID_EXT : CAN_MSG_ID_STD;
+            /* frames passed by the hardware filter superset are dropped here */
+            if(SET == CAN_RxFilterAccept(id, idType, frame->msg.msgId))
+            {
+                CAN_RxRingCommit(id);
+            }
+        }
+        ret = SET;
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief Set TX message buffer.It copys user's buffer into the message buffer 
+ * data area and configure the message buffer as required for transmission.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  mbIdx: MB index
+ * @param[in]  messInfo: message info config
+ * @param[in]  msgId: config message id
+ * @param[in]  msgData: message data
+ * @param[in]  code: code command
+ * @param[in]  localPrio: priority
+ *
+ * @return 
+ *        -SUCC: set tx MB successfully
+ *        -ERR:  fail to tx MB 
+ */
+static ResultStatus_t CAN_SetTxMb(CAN_Id_t id, uint8_t mbIdx,
+                                      const CAN_MessageInfo_t *messInfo, 
+                                      uint32_t msgId, const uint8_t *msgData,
+                                      uint32_t code, uint8_t localPrio)
+{
+    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
+    ResultStatus_t retVal = SUCC;
+    uint32_t dlc;
+    uint32_t dataSize;
+    CAN_FdMbRegion_t region;
+    CAN_Mb_t *mbAddr;
+    
+    if(ERR == CAN_GetMbAddr(id, mbIdx, &region, &mbAddr))
+    {
+        retVal = ERR;
+    }
+    else if(messInfo->dataLen > 64U)
+    {
+        retVal = ERR;
+    }
+    else
+    {
+        if(ERR == CAN_CheckMbId(id,mbIdx))
+        {
+            retVal = ERR;
+        }
+        else
+        {
+            if(CANx->CAN_MCR.FDEN != 0U)
+            {
+                if(messInfo->brsEn == ENABLE)
+                {
+                    CANx->CAN_FDCTRL.FD_RATE = 1U;
+                }
+            }
+        
+            if(messInfo->dataLen > canMbAddrTable[id].regionPayload[region])
+            {
+                retVal = ERR;
+            }
+            else
+            {
+                CAN_ComputeDlcAndDataSize(messInfo->dataLen,&dlc, &dataSize);   
+        
+                /* Copy user's buffer into the message buffer data area, 
+                   add padding if needed */
+                if(msgData != NULL)
+                {
+                    CAN_CopyPayloadToMb(&mbAddr->data[0], msgData, 
+                                        messInfo->dataLen, dataSize, 
+                                        messInfo->fdPadding);
+                }        
+            
+                mbAddr->config.WORDVAL = 0U;
+                mbAddr->id.WORDVAL = 0U;   
+                /* set DLC */
+                mbAddr->config.BF.DLC = dlc;
+            
+                /* Set the ID according the format structure */
+                if (CAN_MSG_ID_EXT == messInfo->idType)
+                {
+                    /* ID [28-0] */
+                    mbAddr->id.WORDVAL = msgId & CAN_ID_EXT_MASK;
+                    mbAddr->id.BF.PRIO = localPrio;
+                    /* Set IDE */
+                    mbAddr->config.BF.IDE = 1U;
+                    /* Clear SRR bit */
+                    mbAddr->config.BF.SRR = 0U;
+                }
+                else
+                {
+                    /* ID[28-18] */
+                    mbAddr->id.BF.ID_STANDARD = msgId;
+                    mbAddr->id.BF.PRIO = localPrio;
+
+                    /* clear IDE  */
+                    mbAddr->config.BF.IDE = 0U;
+                    /* Clear SRR bit */
+                    mbAddr->config.BF.SRR = 0U;
+                }
+                
+                if(SET == messInfo->remoteFlag )
+                {
+                    /* Set RTR bit */
+                    mbAddr->config.BF.RTR = 1U;
+                }
+                
+                /* Set MB CODE */
+                /* Reset the code */
+                mbAddr->config.BF.CODE = 0U;
+                        
+                if (ENABLE == messInfo->fdEn)
+                {
+                    mbAddr->config.BF.EDL = 1U;
+                }
+                        
+                mbAddr->config.BF.BRS = (uint32_t)(messInfo->brsEn);
+                
+#if (1U == CAN_STATS_EN)
+                canStats[id].txStartTime[mbIdx] = 
+                    (uint16_t)((can_reg_w_t *)(canRegWPtr[id]))->CAN_TIMER;
+#endif
+                        
+                /* Set the code */
+                mbAddr->config.BF.CODE = code;           
+            }
+        }
+        
+    }
+    return retVal;
+}
+
+/**
+ * @brief Set Rx message buffer. It copys user's buffer into the message buffer 
+ * data area and configure the message buffer as required for transmission.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  mbIdx: MB index
+ * @param[in]  idType: CAN Message ID type
+ * @param[in]  msgId: config message id
+ * @param[in]  code: code command
+ *
+ * @return  ERR/SUCC
+ *
+ *
+ */
+static ResultStatus_t CAN_SetRxMb(CAN_Id_t id, uint8_t mbIdx,
+                                  CAN_MsgId_t idType, 
+                                  uint32_t msgId, uint32_t code)
+{
+    CAN_FdMbRegion_t region;
+    CAN_Mb_t *mbAddr;
+    ResultStatus_t retVal = SUCC;
+    if(ERR == CAN_GetMbAddr(id, mbIdx, &region, &mbAddr))
+    {
+        retVal = ERR;
+    }  
+    else if(ERR == CAN_CheckMbId(id,mbIdx))
+    {
+        retVal = ERR;
+    }
+    else
+    {
+        mbAddr->config.WORDVAL = 0U;
+        mbAddr->id.WORDVAL = 0U;   
+        
+        /* Set the ID according to the format structure */
+        if (CAN_MSG_ID_EXT == idType)
+        {
+            /* ID [28-0] */
+            mbAddr->id.WORDVAL = msgId & CAN_ID_EXT_MASK;
+            /* Set IDE */
+            mbAddr->config.BF.IDE = 1U;
+            /* Clear SRR bit */
+            mbAddr->config.BF.SRR = 0U;
+        }
+        else
+        {
+            /* ID[28-18] */
+            mbAddr->id.BF.ID_STANDARD = msgId;
+
+            /* clear IDE  */
+            mbAddr->config.BF.IDE = 0U;
+            /* Clear SRR bit */
+            mbAddr->config.BF.SRR = 0U;
+        }
+        
+        if(code != CAN_NOT_USED)
+        {
+            mbAddr->config.BF.CODE = code;
+        }       
+    }
+    return retVal;
+}
+
+
+/**
+ * @brief Clears CAN memory positions that require initialization.
+ *
+ * @param[in]  id: select the CAN ID
+ * 
+ * @return none
+ *
+ */
+static void CAN_ClearRam(CAN_Id_t id)
+{
+    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
+    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
+    uint32_t dataByte;
+    uint32_t ramSize;
+    uint32_t rxImrSize;
+    volatile uint32_t *RAM = &(CANxw->CAN_MB[0].MB0);
+    
+    if((uint32_t)id < (uint32_t)CAN_ID_6)
+    {
+        ramSize = CAN05_RAM_SIZE_IN_WORD;
+        rxImrSize = CAN05_MB_NUM;
+    }
+    else
+    {
+        ramSize = CAN67_RAM_SIZE_IN_WORD;
+        rxImrSize = CAN67_MB_NUM;
+    }
+
+    CANx->CAN_CTRL2.WRMFRZ = 1U;
+    /* Clear MB region */
+    for (dataByte = 0U; dataByte < ramSize; dataByte++)
+    {
+        RAM[dataByte] = 0x0U;
+    }
+
+    RAM = &(CANxw->CAN_RXIMR[0]);
+
+    /* Clear RXIMR region */
+    for (dataByte = 0; dataByte < rxImrSize; dataByte++)
+    {
+        RAM[dataByte] = 0xFFFFFFFFU;
+    }
+    
+    /* init mask */
+    CANxw->CAN_RXMGMSK = 0xFFFFFFFFU;
+    CANxw->CAN_RX14MASK = 0xFFFFFFFFU;
+    CANxw->CAN_RX15MASK = 0xFFFFFFFFU;
+    
+    /* RX FIFO global mask */
+    CANxw->CAN_RXFGMASK = 0xFFFFFFFFU;
+  
+    /* RX FIFO */
+    /*PRQA S 0303 ++*/
+    RAM = (volatile uint32_t*)((uint32_t)canRegPtr[id] + CAN_RAM_RX_FIFO_ADDR);
+    /*PRQA S 0303 --*/
+    for (dataByte = 0U; dataByte < CAN_RAM_RX_FIFO_LEN_IN_WORD; dataByte++)
+    {
+        RAM[dataByte] = 0U;
+    }
+    
+    /* RXMGMASK, RXFGMASK, RX14MSK, RX15MASK */
+    /*PRQA S 0303 ++*/
+    RAM = (volatile uint32_t*)((uint32_t)canRegPtr[id] + CAN_RAM_MSK_ADDR);
+    /*PRQA S 0303 --*/
+    for (dataByte = 0U; dataByte < CAN_RAM_MSK_LEN_IN_WORD; dataByte++)
+    {
+        RAM[dataByte] = 0xFFFFFFFFU;
+    }
+    
+    /* Rx_SMB0, Rx_SMB1 */
+    /*PRQA S 0303 ++*/
+    RAM = (volatile uint32_t*)((uint32_t)canRegPtr[id] + CAN_RAM_RX_SMB_ADDR);
+    /*PRQA S 0303 --*/
+    for (dataByte = 0U; dataByte < CAN_RAM_RX_SMB_LEN_IN_WORD; dataByte++)
+    {
+        RAM[dataByte] = 0U;
+    }
+    
+    /* CAN-FD scratch memory */
+    /*PRQA S 0303 ++*/
+    RAM = (volatile uint32_t*)((uint32_t)canRegPtr[id] + CAN_RAM_FD_SCRATCH_ADDR);    
+    /*PRQA S 0303 --*/
+    for (dataByte = 0U; dataByte < CAN_RAM_FD_SCRATCH_LEN_IN_WORD; dataByte++)
+    {
+        RAM[dataByte] = 0U;
+    }
+    CANx->CAN_CTRL2.WRMFRZ = 0U;
+}
+
+/**
+ * @brief      Get the arbitration key of a frame. The lower key wins the bus
+ *             arbitration.
+ *
+ * @param[in]  frame: points to the frame
+ *
+ * @return     arbitration key
+ *
+ */
+static uint32_t CAN_TxQueueArbKey(const CAN_TxQueueFrame_t *frame)
+{
+    uint32_t msgId;
+    uint32_t key;
+    
+    if(CAN_MSG_ID_EXT == frame->txInfo.idType)
+    {
+        /* base ID, then IDE(recessive), then ID extension */
+        msgId = frame->msgId & CAN_ID_EXT_MASK;
+        key = ((msgId >> CAN_ID_STD_SHIFT) << 19U) | (1UL << 18U) | 
+              (msgId & 0x3FFFFU);
+    }
+    else
+    {
+        key = (frame->msgId & 0x7FFU) << 19U;
+    }
+    
+    /* data frame wins over remote frame */
+    key = (key << 1U) | ((SET == frame->txInfo.remoteFlag) ? 1U : 0U);
+    
+    return key;
+}
+
+/**
+ * @brief      Check if frame a has a higher TX priority than frame b
+ *
+ * @param[in]  queue: points to the TX queue
+ * @param[in]  a: points to frame a
+ * @param[in]  b: points to frame b
+ *
+ * @return     SET: frame a has a higher priority
+ *             RESET: frame a does not have a higher priority
+ *
+ */
+static FlagStatus_t CAN_TxQueueHigherPrio(const CAN_TxQueue_t *queue,
+                                          const CAN_TxQueueFrame_t *a,
+                                          const CAN_TxQueueFrame_t *b)
+{
+    FlagStatus_t ret = RESET;
+    
+    if(CAN_TX_PRI_LOW_NUM_MB_FIRST == queue->prioMode)
+    {
+        /* frames are sent in order */
+        ret = RESET;
+    }
+    else if((CAN_TX_PRI_LOCAL_PRI_EN == queue->prioMode) && 
+            (a->localPrio != b->localPrio))
+    {
+        /* lower local priority value is sent first */
+        ret = (a->localPrio < b->localPrio) ? SET : RESET;
+    }
+    else
+    {
+        ret = (CAN_TxQueueArbKey(a) < CAN_TxQueueArbKey(b)) ? SET : RESET;
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief      Insert a frame into the pending list of the TX queue
+ *
+ * @param[in]  queue: points to the TX queue
+ * @param[in]  frameIdx: index of the frame to be inserted
+ * @param[in]  requeue: SET if the frame is requeued after being aborted, it 
+ *                      is put before the pending frames of the same priority
+ *
+ * @return     none
+ *
+ */
+static void CAN_TxQueueInsert(CAN_TxQueue_t *queue, uint16_t frameIdx,
+                              FlagStatus_t requeue)
+{
+    CAN_TxQueueFrame_t *frame = &queue->frameBuf[frameIdx];
+    CAN_TxQueueFrame_t *cur;
+    uint16_t *link = &queue->pendHead;
+    
+    while(*link != CAN_TX_QUEUE_NONE)
+    {
+        cur = &queue->frameBuf[*link];
+        if(SET == CAN_TxQueueHigherPrio(queue, frame, cur))
+        {
+            break;
+        }
+        if((SET == requeue) && 
+           (RESET == CAN_TxQueueHigherPrio(queue, cur, frame)))
+        {
+            break;
+        }
+        link = &cur->next;
+    }
+    
+    frame->next = *link;
+    *link = frameIdx;
+    
+    queue->status.depth++;
+    if(queue->status.depth > queue->status.maxDepth)
+    {
+        queue->status.maxDepth = queue->status.depth;
+    }
+}
+
+/**
+ * @brief      Put a frame back to the free list of the TX queue
+ *
+ * @param[in]  queue: points to the TX queue
+ * @param[in]  frameIdx: index of the frame
+ *
+ * @return     none
+ *
+ */
+static void CAN_TxQueueFree(CAN_TxQueue_t *queue, uint16_t frameIdx)
+{
+    queue->frameBuf[frameIdx].next = queue->freeHead;
+    queue->freeHead = frameIdx;
+}
+
+/**
+ * @brief      Load pending frames into the free MBs of the TX MB pool. If all
+ *             pool MBs are busy and the first pending frame has a higher 
+ *             priority than the lowest priority frame in the pool, that MB 
+ *             is aborted, and the aborted frame is requeued from its 
+ *             interrupt. It shall be called with interrupts disabled.
+ *
+ * @param[in]  id: select the CAN ID
+ *
+ * @return     none
+ *
+ */
+static void CAN_TxQueueSchedule(CAN_Id_t id)
+{
+    CAN_TxQueue_t *queue = &canTxQueue[id];
+    CAN_TxQueueFrame_t *frame;
+    uint16_t frameIdx;
+    uint32_t slot;
+    uint32_t lowSlot = CAN_TX_QUEUE_MB_MAX;
+    
+    for(slot = 0U; slot < queue->mbNum; slot++)
+    {
+        while((CAN_TX_QUEUE_NONE == queue->mbFrame[slot]) && 
+              (queue->pendHead != CAN_TX_QUEUE_NONE))
+        {
+            frameIdx = queue->pendHead;
+            frame = &queue->frameBuf[frameIdx];
+            queue->pendHead = frame->next;
+            queue->status.depth--;
+            
+            (void)CAN_ClearMbIntStatus(id, (uint32_t)queue->firstMb + slot);
+            if(SUCC == CAN_SetTxMb(id, (uint8_t)(queue->firstMb + slot), 
+                                   &frame->txInfo, frame->msgId, frame->data,
+                                   CAN_TX_DATA_REMOTE, frame->localPrio))
+            {
+                queue->mbFrame[slot] = frameIdx;
+#if (1U == CAN_STATS_EN)
+                canStats[id].txStartTime[queue->firstMb + slot] = 
+                    frame->timeStamp;
+#endif
+            }
+            else
+            {
+                queue->status.dropCnt++;
+                CAN_TxQueueFree(queue, frameIdx);
+            }
+        }
+        
+        /* find the lowest priority frame which can be aborted */
+        if((CAN_TX_QUEUE_NONE != queue->mbFrame[slot]) &&
+           (0U == (queue->abortMask & (1UL << slot))))
+        {
+            if((CAN_TX_QUEUE_MB_MAX == lowSlot) ||
+               (SET == CAN_TxQueueHigherPrio(queue, 
+                                 &queue->frameBuf[queue->mbFrame[lowSlot]],
+                                 &queue->frameBuf[queue->mbFrame[slot]])))
+            {
+                lowSlot = slot;
+            }
+        }
+    }
+    
+#if (1U == CAN_ABORT_EN)
+    if((queue->pendHead != CAN_TX_QUEUE_NONE) && 
+       (lowSlot != CAN_TX_QUEUE_MB_MAX))
+    {
+        if(SET == CAN_TxQueueHigherPrio(queue, 
+                                 &queue->frameBuf[queue->pendHead],
+                                 &queue->frameBuf[queue->mbFrame[lowSlot]]))
+        {
+            queue->abortMask |= (1UL << lowSlot);
+            (void)CAN_SetMbCode(id, (uint32_t)queue->firstMb + lowSlot, 
+                                CAN_MB_TX_ABORT);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief      Handle the interrupt of a TX MB pool MB
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  mbIdx: MB index
+ *
+ * @return     SET: the MB belongs to the TX MB pool and it has been handled
+ *             RESET: the MB does not belong to the TX MB pool
+ *
+ */
+static FlagStatus_t CAN_TxQueueMbHandler(CAN_Id_t id, uint32_t mbIdx)
+{
+    CAN_TxQueue_t *queue = &canTxQueue[id];
+    uint32_t slot = mbIdx - (uint32_t)queue->firstMb;
+    uint32_t code = 0U;
+    uint32_t primask;
+    uint16_t frameIdx;
+    FlagStatus_t ret = RESET;
+    
+    if((queue->frameBuf != NULL) && (mbIdx >= (uint32_t)queue->firstMb) &&
+       (slot < (uint32_t)queue->mbNum))
+    {
+        /* MB interrupt groups may preempt each other */
+        primask = COMMON_GetPRIMASK();
+        COMMON_DISABLE_INTERRUPTS();
+        
+        frameIdx = queue->mbFrame[slot];
+        if(frameIdx != CAN_TX_QUEUE_NONE)
+        {
+            (void)CAN_GetMbCode(id, mbIdx, &code);
+            queue->mbFrame[slot] = CAN_TX_QUEUE_NONE;
+            
+            if((uint32_t)CAN_MB_TX_ABORT == code)
+            {
+                /* aborted before it was sent, send it later */
+                queue->status.abortCnt++;
+                CAN_TxQueueInsert(queue, frameIdx, SET);
+            }
+            else
+            {
+                queue->status.sentCnt++;
+                CAN_TxQueueFree(queue, frameIdx);
+            }
+        }
+        queue->abortMask &= ~(1UL << slot);
+        
+        CAN_TxQueueSchedule(id);
+        
+        COMMON_SetPRIMASK(primask);
+        ret = SET;
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief      Count the bits set in a word
+ *
+ * @param[in]  value: the word
+ *
+ * @return     number of bits set
+ *
+ */
+static uint32_t CAN_FilterBitCount(uint32_t value)
+{
+    uint32_t count = 0U;
+    uint32_t bits = value;
+    
+    while(bits != 0U)
+    {
+        bits &= bits - 1U;
+        count++;
+    }
+    
+    return count;
+}
+
+/**
+ * @brief      Get the ID bits compared by an RX FIFO ID filter format. In
+ *             format C, the entries hold the 8 compared bits.
+ *
+ * @param[in]  format: RX FIFO ID filter format
+ * @param[in]  idType: standard or extended ID
+ *
+ * @return     mask of the compared ID bits
+ *
+ */
+static uint32_t CAN_FilterFullMask(CAN_RxFifoIdFormat_t format, 
+                                   CAN_MsgId_t idType)
+{
+    uint32_t mask;
+    
+    if(CAN_RX_FIFO_ID_FORMAT_C == format)
+    {
+        mask = CAN_FILTER_C_FULL_MASK;
+    }
+    else if(CAN_MSG_ID_STD == idType)
+    {
+        mask = CAN_FILTER_STD_FULL_MASK;
+    }
+    else if(CAN_RX_FIFO_ID_FORMAT_B == format)
+    {
+        mask = CAN_FILTER_B_EXT_MASK;
+    }
+    else
+    {
+        mask = CAN_ID_EXT_MASK;
+    }
+    
+    return mask;
+}
+
+/**
+ * @brief      Get the number of IDs accepted by a filter entry
+ *
+ * @param[in]  format: RX FIFO ID filter format
+ * @param[in]  entry: points to the entry
+ *
+ * @return     number of accepted IDs
+ *
+ */
+static uint64_t CAN_FilterEntryCost(CAN_RxFifoIdFormat_t format,
+                                    const CAN_FilterEntry_t *entry)
+{
+    uint32_t freeBits;
+    uint64_t cost;
+    
+    if(CAN_RX_FIFO_ID_FORMAT_C == format)
+    {
+        /* the 8 compared bits match both standard and extended IDs */
+        freeBits = 8U - CAN_FilterBitCount(entry->mask);
+        cost = ((uint64_t)1U << (3U + freeBits)) + 
+               ((uint64_t)1U << (21U + freeBits));
+    }
+    else if(CAN_MSG_ID_STD == entry->idType)
+    {
+        freeBits = 11U - CAN_FilterBitCount(entry->mask);
+        cost = (uint64_t)1U << freeBits;
+    }
+    else
+    {
+        freeBits = 29U - CAN_FilterBitCount(entry->mask);
+        cost = (uint64_t)1U << freeBits;
+    }
+    
+    return cost;
+}
+
+/**
+ * @brief      Check if two entries can be compared or merged
+ *
+ * @param[in]  format: RX FIFO ID filter format
+ * @param[in]  a: points to entry a
+ * @param[in]  b: points to entry b
+ *
+ * @return     SET: same ID domain
+ *             RESET: different ID domain
+ *
+ */
+static FlagStatus_t CAN_FilterSameDomain(CAN_RxFifoIdFormat_t format,
+                                         const CAN_FilterEntry_t *a,
+                                         const CAN_FilterEntry_t *b)
+{
+    return ((CAN_RX_FIFO_ID_FORMAT_C == format) || (a->idType == b->idType)) ?
+           SET : RESET;
+}
+
+/**
+ * @brief      Check if entry a accepts all IDs accepted by entry b
+ *
+ * @param[in]  format: RX FIFO ID filter format
+ * @param[in]  a: points to entry a
+ * @param[in]  b: points to entry b
+ *
+ * @return     SET: a covers b
+ *             RESET: a does not cover b
+ *
+ */
+static FlagStatus_t CAN_FilterCovers(CAN_RxFifoIdFormat_t format,
+                                     const CAN_FilterEntry_t *a,
+                                     const CAN_FilterEntry_t *b)
+{
+    FlagStatus_t ret = RESET;
+    
+    if((SET == CAN_FilterSameDomain(format, a, b)) && 
+       ((a->mask & ~b->mask) == 0U) && (((a->id ^ b->id) & a->mask) == 0U))
+    {
+        ret = SET;
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief      Remove the entries covered by another entry
+ *
+ * @param[in]  format: RX FIFO ID filter format
+ * @param[in]  entry: points to the entries
+ * @param[in]  num: number of entries
+ *
+ * @return     number of entries left
+ *
+ */
+static uint32_t CAN_FilterRemoveCovered(CAN_RxFifoIdFormat_t format,
+                                        CAN_FilterEntry_t *entry, uint32_t num)
+{
+    uint32_t count = num;
+    uint32_t i = 0U;
+    uint32_t j;
+    FlagStatus_t covered;
+    
+    while(i < count)
+    {
+        covered = RESET;
+        for(j = 0U; j < count; j++)
+        {
+            if((j != i) && (SET == CAN_FilterCovers(format, &entry[j], &entry[i])))
+            {
+                covered = SET;
+                break;
+            }
+        }
+        if(SET == covered)
+        {
+            count--;
+            entry[i] = entry[count];
+        }
+        else
+        {
+            i++;
+        }
+    }
+    
+    return count;
+}
+
+/**
+ * @brief      Merge two entries into one entry accepting both
+ *
+ * @param[in]  a: points to entry a
+ * @param[in]  b: points to entry b
+ * @param[out] merged: points to the merged entry
+ *
+ * @return     none
+ *
+ */
+static void CAN_FilterMerge(const CAN_FilterEntry_t *a, 
+                            const CAN_FilterEntry_t *b,
+                            CAN_FilterEntry_t *merged)
+{
+    merged->mask = a->mask & b->mask & ~(a->id ^ b->id);
+    merged->id = a->id & merged->mask;
+    merged->idType = a->idType;
+}
+
+/**
+ * @brief      Get the number of IDs accepted by both entries
+ *
+ * @param[in]  format: RX FIFO ID filter format
+ * @param[in]  a: points to entry a
+ * @param[in]  b: points to entry b
+ *
+ * @return     number of IDs accepted by both entries
+ *
+ */
+static uint64_t CAN_FilterOverlapCost(CAN_RxFifoIdFormat_t format,
+                                      const CAN_FilterEntry_t *a, 
+                                      const CAN_FilterEntry_t *b)
+{
+    CAN_FilterEntry_t both;
+    uint64_t cost = 0U;
+    
+    if(((a->id ^ b->id) & a->mask & b->mask) == 0U)
+    {
+        both.mask = a->mask | b->mask;
+        both.id = (a->id | b->id) & both.mask;
+        both.idType = a->idType;
+        cost = CAN_FilterEntryCost(format, &both);
+    }
+    
+    return cost;
+}
+
+/**
+ * @brief      Merge the entries until they fit the RX FIFO ID filter table. 
+ *             The pair of entries accepting the fewest extra IDs when merged
+ *             is merged first. Entries with compared bits cleared (partial 
+ *             entries) are put first, to be placed in elements with an 
+ *             individual mask.
+ *
+ * @param[in]  format: RX FIFO ID filter format
+ * @param[in]  entry: points to the entries
+ * @param[in]  num: number of entries
+ * @param[in]  partialMax: max partial entries
+ * @param[in]  totalMax: max entries
+ * @param[out] cost: number of IDs accepted by the entries
+ * @param[out] lossy: SET if the entries accept more IDs than before
+ *
+ * @return     number of entries, 0 if the entries cannot fit
+ *
+ */
+static uint32_t CAN_FilterFit(CAN_RxFifoIdFormat_t format, 
+                              CAN_FilterEntry_t *entry, uint32_t num,
+                              uint32_t partialMax, uint32_t totalMax,
+                              uint64_t *cost, FlagStatus_t *lossy)
+{
+    CAN_FilterEntry_t merged;
+    CAN_FilterEntry_t tmp;
+    uint32_t count;
+    uint32_t partialNum;
+    uint32_t i, j;
+    uint32_t bestI = 0U;
+    uint32_t bestJ = 0U;
+    uint64_t mergedCost;
+    uint64_t extraCost;
+    uint64_t bestCost;
+    uint64_t unionCost;
+    FlagStatus_t found;
+    
+    count = CAN_FilterRemoveCovered(format, entry, num);
+    
+    while(count > 0U)
+    {
+        partialNum = 0U;
+        for(i = 0U; i < count; i++)
+        {
+            if(entry[i].mask != CAN_FilterFullMask(format, entry[i].idType))
+            {
+                /* put partial entries first */
+                tmp = entry[partialNum];
+                entry[partialNum] = entry[i];
+                entry[i] = tmp;
+                partialNum++;
+            }
+        }
+        if((partialNum <= partialMax) && (count <= totalMax))
+        {
+            break;
+        }
+        
+        found = RESET;
+        bestCost = 0U;
+        for(i = 0U; i < count; i++)
+        {
+            for(j = i + 1U; j < count; j++)
+            {
+                if(SET == CAN_FilterSameDomain(format, &entry[i], &entry[j]))
+                {
+                    CAN_FilterMerge(&entry[i], &entry[j], &merged);
+                    mergedCost = CAN_FilterEntryCost(format, &merged);
+                    unionCost = CAN_FilterEntryCost(format, &entry[i]) + 
+                                CAN_FilterEntryCost(format, &entry[j]) -
+                                CAN_FilterOverlapCost(format, &entry[i], 
+                                                      &entry[j]);
+                    extraCost = mergedCost - unionCost;
+                    if((RESET == found) || (extraCost < bestCost))
+                    {
+                        found = SET;
+                        bestCost = extraCost;
+                        bestI = i;
+                        bestJ = j;
+                    }
+                }
+            }
+        }
+        
+        if(RESET == found)
+        {
+            /* one entry of each ID type left and still not fit */
+            count = 0U;
+        }
+        else
+        {
+            if(bestCost != 0U)
+            {
+                *lossy = SET;
+            }
+            CAN_FilterMerge(&entry[bestI], &entry[bestJ], &merged);
+            entry[bestI] = merged;
+            count--;
+            entry[bestJ] = entry[count];
+            count = CAN_FilterRemoveCovered(format, entry, count);
+        }
+    }
+    
+    *cost = 0U;
+    for(i = 0U; i < count; i++)
+    {
+        *cost += CAN_FilterEntryCost(format, &entry[i]);
+    }
+    
+    return count;
+}
+
+/**
+ * @brief      Map the rule entries to the ID bits compared by an RX FIFO ID
+ *             filter format
+ *
+ * @param[in]  format: RX FIFO ID filter format
+ * @param[in]  src: points to the rule entries
+ * @param[out] dst: points to the mapped entries
+ * @param[in]  num: number of entries
+ * @param[out] lossy: SET if some compared bits are lost
+ *
+ * @return     none
+ *
+ */
+static void CAN_FilterMapEntries(CAN_RxFifoIdFormat_t format,
+                                 const CAN_FilterEntry_t *src,
+                                 CAN_FilterEntry_t *dst, uint32_t num,
+                                 FlagStatus_t *lossy)
+{
+    uint32_t shift;
+    uint32_t mask;
+    uint32_t i;
+    
+    for(i = 0U; i < num; i++)
+    {
+        dst[i].idType = src[i].idType;
+        if(CAN_RX_FIFO_ID_FORMAT_C == format)
+        {
+            /* 8 most significant bits of the ID, for both ID types */
+            shift = (CAN_MSG_ID_STD == src[i].idType) ? 3U : 21U;
+            dst[i].mask = (src[i].mask >> shift) & CAN_FILTER_C_FULL_MASK;
+            dst[i].id = (src[i].id >> shift) & dst[i].mask;
+            dst[i].idType = CAN_MSG_ID_STD;
+            *lossy = SET;
+        }
+        else
+        {
+            mask = CAN_FilterFullMask(format, src[i].idType);
+            if((src[i].mask & ~mask) != 0U)
+            {
+                *lossy = SET;
+            }
+            dst[i].mask = src[i].mask & mask;
+            dst[i].id = src[i].id & dst[i].mask;
+        }
+    }
+}
+
+/**
+ * @brief      Encode an entry into an RX FIFO ID filter element and its mask
+ *
+ * @param[in]  format: RX FIFO ID filter format
+ * @param[in]  slot: slot in the element, 0-1 for format B, 0-3 for format C
+ * @param[in]  entry: points to the entry
+ * @param[out] element: points to the element value
+ * @param[out] mask: points to the element mask
+ *
+ * @return     none
+ *
+ */
+static void CAN_FilterEncode(CAN_RxFifoIdFormat_t format, uint32_t slot,
+                             const CAN_FilterEntry_t *entry, 
+                             uint32_t *element, uint32_t *mask)
+{
+    uint32_t shift;
+    
+    if(CAN_RX_FIFO_ID_FORMAT_A == format)
+    {
+        /* the RTR bit is not compared, the IDE bit is compared */
+        if(CAN_MSG_ID_EXT == entry->idType)
+        {
+            *element |= (1UL << 30U) | (entry->id << 1U);
+            *mask |= (1UL << 30U) | (entry->mask << 1U);
+        }
+        else
+        {
+            *element |= entry->id << 19U;
+            *mask |= (1UL << 30U) | (entry->mask << 19U);
+        }
+    }
+    else if(CAN_RX_FIFO_ID_FORMAT_B == format)
+    {
+        shift = (0U == slot) ? 16U : 0U;
+        if(CAN_MSG_ID_EXT == entry->idType)
+        {
+            *element |= ((1UL << 14U) | (entry->id >> 15U)) << shift;
+            *mask |= ((1UL << 14U) | (entry->mask >> 15U)) << shift;
+        }
+        else
+        {
+            *element |= (entry->id << 3U) << shift;
+            *mask |= ((1UL << 14U) | (entry->mask << 3U)) << shift;
+        }
+    }
+    else
+    {
+        shift = 24U - (slot << 3U);
+        *element |= entry->id << shift;
+        *mask |= entry->mask << shift;
+    }
+}
+
+/**
+ * @brief      Split the filter rules into ID/mask entries. ID ranges are split
+ *             into aligned power of 2 blocks. Entries which are adjacent and 
+ *             differ in only one compared bit are merged.
+ *
+ * @param[in]  rules: points to the filter rules
+ * @param[in]  ruleNum: number of rules
+ * @param[out] entry: points to the entries
+ * @param[in]  entryMax: max number of entries
+ *
+ * @return     number of entries, 0xFFFFFFFF if entryMax is exceeded
+ *
+ */
+static uint32_t CAN_FilterSplitRules(const CAN_FilterRuleCfg_t *rules,
+                                     uint32_t ruleNum, CAN_FilterEntry_t *entry,
+                                     uint32_t entryMax)
+{
+    uint32_t count = 0U;
+    uint32_t fullMask;
+    uint32_t low;
+    uint32_t high;
+    uint32_t blockSize;
+    uint32_t i, j;
+    FlagStatus_t merged;
+    
+    for(i = 0U; (i < ruleNum) && (count != 0xFFFFFFFFU); i++)
+    {
+        fullMask = CAN_FilterFullMask(CAN_RX_FIFO_ID_FORMAT_A, rules[i].idType);
+        low = rules[i].id & fullMask;
+        high = low;
+        blockSize = 1U;
+        
+        if(CAN_FILTER_RULE_RANGE == rules[i].rule)
+        {
+            high = rules[i].param & fullMask;
+        }
+        
+        while((low <= high) && (count != 0xFFFFFFFFU))
+        {
+            if(count >= entryMax)
+            {
+                count = 0xFFFFFFFFU;
+            }
+            else if(CAN_FILTER_RULE_MASK == rules[i].rule)
+            {
+                entry[count].mask = rules[i].param & fullMask;
+                entry[count].id = low & entry[count].mask;
+                entry[count].idType = rules[i].idType;
+                count++;
+                low = high + 1U;
+            }
+            else
+            {
+                /* largest aligned block starting at low within the range */
+                blockSize = 1U;
+                while(((low & ((blockSize << 1U) - 1U)) == 0U) && 
+                      ((low + (blockSize << 1U) - 1U) <= high) &&
+                      ((blockSize << 1U) <= (fullMask + 1U)))
+                {
+                    blockSize <<= 1U;
+                }
+                entry[count].mask = fullMask & ~(blockSize - 1U);
+                entry[count].id = low;
+                entry[count].idType = rules[i].idType;
+                count++;
+                low += blockSize;
+            }
+        }
+    }
+    
+    /* merge the adjacent entries */
+    merged = SET;
+    while((SET == merged) && (count != 0xFFFFFFFFU))
+    {
+        merged = RESET;
+        for(i = 0U; i < count; i++)
+        {
+            for(j = i + 1U; j < count; j++)
+            {
+                if((entry[i].idType == entry[j].idType) &&
+                   (entry[i].mask == entry[j].mask) &&
+                   (1U == CAN_FilterBitCount(entry[i].id ^ entry[j].id)))
+                {
+                    entry[i].mask &= ~(entry[i].id ^ entry[j].id);
+                    entry[i].id &= entry[i].mask;
+                    count--;
+                    entry[j] = entry[count];
+                    merged = SET;
+                }
+            }
+        }
+        if(count != 0U)
+        {
+            count = CAN_FilterRemoveCovered(CAN_RX_FIFO_ID_FORMAT_A, entry, 
+                                            count);
+        }
+    }
+    
+    return count;
+}
+
+/**
+ * @brief      Set the software acceptance filter with the rule entries. The 
+ *             single IDs are put into the hash table if there is enough room,
+ *             the others are checked one by one.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  mem: points to the filter memory
+ * @param[in]  num: number of rule entries in mem->entryBuf
+ * @param[out] result: points to the compile result
+ *
+ * @return     none
+ *
+ */
+static void CAN_SwFilterSet(CAN_Id_t id, const CAN_FilterMem_t *mem,
+                            uint32_t num, CAN_FilterResult_t *result)
+{
+    CAN_SwFilter_t *filter = &canSwFilter[id];
+    CAN_FilterEntry_t *entry = mem->entryBuf;
+    CAN_FilterEntry_t tmp;
+    uint32_t listNum = num;
+    uint32_t key;
+    uint32_t index;
+    uint32_t i;
+    
+    filter->hashMask = 0U;
+    
+    if((mem->hashBuf != NULL) && (mem->hashSize > 1U) && 
+       (0U == (mem->hashSize & (mem->hashSize - 1U))))
+    {
+        /* put the single IDs at the end */
+        listNum = 0U;
+        for(i = 0U; i < num; i++)
+        {
+            if(entry[i].mask != CAN_FilterFullMask(CAN_RX_FIFO_ID_FORMAT_A, 
+                                                   entry[i].idType))
+            {
+                tmp = entry[listNum];
+                entry[listNum] = entry[i];
+                entry[i] = tmp;
+                listNum++;
+            }
+        }
+        
+        /* keep the hash table at most half full */
+        if(((num - listNum) << 1U) <= mem->hashSize)
+        {
+            for(i = 0U; i < mem->hashSize; i++)
+            {
+                mem->hashBuf[i] = CAN_FILTER_HASH_EMPTY;
+            }
+            for(i = listNum; i < num; i++)
+            {
+                key = (CAN_MSG_ID_EXT == entry[i].idType) ? 
+                      (entry[i].id | CAN_FILTER_HASH_EXT_FLAG) : entry[i].id;
+                index = CAN_FILTER_HASH(key, mem->hashSize - 1U);
+                while(mem->hashBuf[index] != CAN_FILTER_HASH_EMPTY)
+                {
+                    index = (index + 1U) & (mem->hashSize - 1U);
+                }
+                mem->hashBuf[index] = key;
+            }
+            filter->hashBuf = mem->hashBuf;
+            filter->hashMask = mem->hashSize - 1U;
+        }
+        else
         {
+            listNum = num;
         }
-    }  
+    }
+    
+    filter->entryBuf = entry;
+    filter->entryNum = listNum;
+    result->swEntryNum = listNum;
+    result->swHashNum = num - listNum;
 }
 
 /**
- * @brief      CAN Handler for ECC error interrupt(including CAN_INT_HOST_MEM_ERR,
- *             CAN_INT_CAN_MEM_ERR and CAN_INT_COR_MEM_ERR
+ * @brief      CAN handler for bus off/ bus off done interrupts
  *
  * @param[in]  id: select the CAN ID
  *
  * @return    none
  *
- */
-static void CAN_EccHandler(CAN_Id_t id)
+ */ 
+static void CAN_BusOffHandler(CAN_Id_t id)
 {
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
     uint32_t status;
     
-    status = CANxw->CAN_ERRSR; 
+    status = CANxw->CAN_ESR1; 
     /* only check enabled interrupts */
-    status = status & (CANxw->CAN_MECR & CAN_INT_MSK_FLAG_ALL_ECC);
+    status = status & (canIntMaskStatus1[id] & CAN_INT_MSK_FLAG_ALL_BUSOFF);
     /* clear int status */
-    CANxw->CAN_ERRSR = status;
+    CANxw->CAN_ESR1 = status;
     
-    /* Host Access With Non-Correctable Error Interrupt */
-    if((status & CAN_INT_MSK_FLAG_HOST_MEM_ERR) != 0U)
+    /* bus off interrupt */
+    if((status & CAN_INT_MSK_FLAG_BUS_OFF) != 0U)
     {
-        if(canIsrCbFunc[id].cbf[CAN_INT_HOST_MEM_ERR] != NULL)
+#if (1U == CAN_STATS_EN)
+        canStats[id].stats.busOffCnt++;
+#endif
+        if(canIsrCbFunc[id].cbf[CAN_INT_BUS_OFF] != NULL)
         {
-            canIsrCbFunc[id].cbf[CAN_INT_HOST_MEM_ERR]();
+            canIsrCbFunc[id].cbf[CAN_INT_BUS_OFF]();
         }
         else
         {
-            if(SUCC != CAN_IntMask(id, CAN_INT_HOST_MEM_ERR, MASK, 0, 0, 0, 0))
+            if(SUCC != CAN_IntMask(id, CAN_INT_BUS_OFF, MASK, 0, 0, 0, 0))
             {
             }
         }            
     }
     
-    /* CAN Access With Non-Correctable Error Interrupt */
-    if((status & CAN_INT_MSK_FLAG_CAN_MEM_ERR) != 0U)
+    /* bus off done interrupt */
+    if((status & CAN_INT_MSK_FLAG_BUS_OFF_DONE) != 0U)
     {
-        if(canIsrCbFunc[id].cbf[CAN_INT_CAN_MEM_ERR] != NULL)
+        if(canIsrCbFunc[id].cbf[CAN_INT_BUS_OFF_DONE] != NULL)
         {
-            canIsrCbFunc[id].cbf[CAN_INT_CAN_MEM_ERR]();
+            canIsrCbFunc[id].cbf[CAN_INT_BUS_OFF_DONE]();
         }
         else
         {
-            if(SUCC != CAN_IntMask(id, CAN_INT_CAN_MEM_ERR, MASK, 0, 0, 0, 0))
+            if(SUCC != CAN_IntMask(id, CAN_INT_BUS_OFF_DONE, MASK, 0, 0, 0, 0))
             {
             }
         }            
     }
-    /* Correctable Error Interrupt */
-    if((status & CAN_INT_MSK_FLAG_COR_MEM_ERR) != 0U)
+    
+}
+
+/**
+ * @brief      CAN Handler for TX warning interrupt
+ *
+ * @param[in]  id: select the CAN ID
+ *
+ * @return    none
+ *
+ */ 
+static void CAN_TxWarnHandler(CAN_Id_t id)
+{
+    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
+    
+    /* clear TX warning interrupt status */
+    CANxw->CAN_ESR1 = CAN_INT_MSK_FLAG_TXW;
+    
+    if(canIsrCbFunc[id].cbf[CAN_INT_TXW] != NULL)
     {
-        if(canIsrCbFunc[id].cbf[CAN_INT_COR_MEM_ERR] != NULL)
+        canIsrCbFunc[id].cbf[CAN_INT_TXW]();
+    }
+    else
+    {
+        if(SUCC != CAN_IntMask(id, CAN_INT_TXW, MASK, 0, 0, 0, 0))
         {
-            canIsrCbFunc[id].cbf[CAN_INT_COR_MEM_ERR]();
         }
-        else
-        {
-            if(SUCC != CAN_IntMask(id, CAN_INT_COR_MEM_ERR, MASK, 0, 0, 0, 0))
-            {
-            }
-        }            
-    }
+    }  
 }
 
 /**
- * @brief      CAN Handler for MB0 - MB15 interrupts
+ * @brief      CAN Handler for RX warning interrupt
  *
  * @param[in]  id: select the CAN ID
  *
  * @return    none
  *
  */
-static void CAN05_Mb0To15Handler(CAN_Id_t id)
+static void CAN_RxWarnHandler(CAN_Id_t id)
 {
-    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint32_t totalMbNum = (uint32_t)CANx->CAN_MCR.MAXMB + 1U;
-    uint32_t maxMb;
-    uint32_t status;
-    uint32_t mbId;
     
-    status = CANxw->CAN_IFLAG1;
-    status &= CANxw->CAN_IMASK1;
-    status &= 0xFFFFU;
+    /* clear interrupt status */
+    CANxw->CAN_ESR1 = CAN_INT_MSK_FLAG_RXW;
     
-    maxMb = (totalMbNum > 16U) ? 16U : totalMbNum;
-    for(mbId = 0U; mbId < maxMb; mbId++)
+    if(canIsrCbFunc[id].cbf[CAN_INT_RXW] != NULL)
+    {
+        canIsrCbFunc[id].cbf[CAN_INT_RXW]();
+    }
+    else
     {
-        if((status & (0x00000001UL << mbId)) != 0U)
+        if(SUCC != CAN_IntMask(id, CAN_INT_RXW, MASK, 0, 0, 0, 0))
         {
-            if((CANx->CAN_MCR.RFEN != 0U) && (mbId <= CAN_RXFIFO_OVERFLOW))
-            {
-                /* RX FIFO frame available interrupt */
-                if(CAN_RXFIFO_FRAME_AVAILABLE == mbId)
-                {
-                    if(canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_FRAME] != NULL)
-                    {
-                        canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_FRAME]();
-                    }
-                    else
-                    {
-                        CANxw->CAN_IMASK1 &= ~CAN_INT_MSK_FLAG_RXFIFO_FRAME;
-                    }
-                }
-                /* RX FIFO warning interrupt */
-                if(CAN_RXFIFO_WARNING == mbId)
-                {
-                    if(canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_WARNING] != NULL)
-                    {
-                        canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_WARNING]();
-                    }
-                    else
-                    {
-                        CANxw->CAN_IMASK1 &= ~CAN_INT_MSK_FLAG_RXFIFO_WARNING;
-                    }
-                }
-                /* RX FIFO overflow interrupt */
-                if(CAN_RXFIFO_OVERFLOW == mbId)
-                {
-                    if(canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_OVERFLOW] != NULL)
-                    {
-                        canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_OVERFLOW]();
-                    }
-                    else
-                    {
-                        CANxw->CAN_IMASK1 &= ~CAN_INT_MSK_FLAG_RXFIFO_OVERFLOW;
-                    }
-                }                    
-            }
-            else
-            {
-                if(canIsrCbFunc[id].mbCbf[CAN05_MB_INT_0TO15] != NULL)
-                {
-                    canIsrCbFunc[id].mbCbf[CAN05_MB_INT_0TO15](mbId);
-                }
-                else
-                {
-                    CANxw->CAN_IMASK1 &= ~(0x00000001UL<<mbId);
-                }
-            }
-                
-            /* clear MB interrupt */
-            CANxw->CAN_IFLAG1 = 0x00000001UL<<mbId;                
         }
-    }
+    }  
 }
 
 /**
- * @brief      CAN Handler for MB16 - MB31 interrupts of CAN0-5
+ * @brief      CAN Handler for Error interrupt
  *
  * @param[in]  id: select the CAN ID
  *
  * @return    none
  *
  */
-static void CAN05_Mb16To31Handler(CAN_Id_t id)
+static void CAN_ErrHandler(CAN_Id_t id)
 {
-    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint32_t totalMbNum = (uint32_t)CANx->CAN_MCR.MAXMB + 1U;
-    uint32_t maxMb;
-    uint32_t status;
-    uint32_t mbId;
     
-    status = CANxw->CAN_IFLAG1;
-    status &= CANxw->CAN_IMASK1;
-    status &= 0xFFFF0000U;
+    canEsr1Buf[id] = CANxw->CAN_ESR1;
+    
+    /* clear interrupt status */
+    CANxw->CAN_ESR1 = CAN_INT_MSK_FLAG_ERR;
     
-    maxMb = (totalMbNum > 32U) ? 32U : totalMbNum;
-    for(mbId = 16U; mbId < maxMb; mbId++)
+#if (1U == CAN_STATS_EN)
+    CAN_StatsErr(id, canEsr1Buf[id]);
+#endif
+        
+    if(canIsrCbFunc[id].cbf[CAN_INT_ERR] != NULL)
+    {
+        canIsrCbFunc[id].cbf[CAN_INT_ERR]();
+    }
+    else
     {
-        if((status & (0x00000001UL << mbId)) != 0U)
+        if(SUCC != CAN_IntMask(id, CAN_INT_ERR, MASK, 0, 0, 0, 0))
         {
-            if(canIsrCbFunc[id].mbCbf[CAN05_MB_INT_16TO31] != NULL)
-            {
-                canIsrCbFunc[id].mbCbf[CAN05_MB_INT_16TO31](mbId);
-            }
-            else
-            {
-                CANxw->CAN_IMASK1 &= ~(0x00000001UL<< mbId);
-            }
         }
-                
-        /* clear MB interrupt */
-        CANxw->CAN_IFLAG1 = 0x00000001UL << mbId;                
-    }
+    }  
+    
+    canEsr1Buf[id] = 0;
 }
 
 /**
- * @brief      CAN Handler for MB32 - MB47 interrupts
+ * @brief      CAN Handler for Error fast interrupt (CAN_INT_ERR_FAST)
  *
  * @param[in]  id: select the CAN ID
  *
  * @return    none
  *
  */
-static void CAN05_Mb32To47Handler(CAN_Id_t id)
+static void CAN_ErrFdHandler(CAN_Id_t id)
+{
+    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
+    
+    canEsr1Buf[id] = CANxw->CAN_ESR1;
+    
+    /* clear interrupt status */
+    CANxw->CAN_ESR1 = CAN_INT_MSK_FLAG_ERR_FAST;
+    
+#if (1U == CAN_STATS_EN)
+    CAN_StatsErr(id, canEsr1Buf[id]);
+#endif
+    
+    if(canIsrCbFunc[id].cbf[CAN_INT_ERR_FAST] != NULL)
+    {
+        canIsrCbFunc[id].cbf[CAN_INT_ERR_FAST]();
+    }
+    else
+    {
+        if(SUCC != CAN_IntMask(id, CAN_INT_ERR_FAST, MASK, 0, 0, 0, 0))
+        {
+        }
+    }  
+    
+    canEsr1Buf[id] = 0;
+}
+
+/**
+ * @brief      CAN Handler for pretended networking wakeup interrupt including
+ *             CAN_INT_PN_WAKE_MATCH and CAN_INT_PN_WAKE_TIMEOUT
+ *
+ * @param[in]   id: select the CAN ID
+ *
+ * @return    none
+ *
+ */
+static void CAN_PnWakeHandler(CAN_Id_t id)
 {
-    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint32_t totalMbNum = (uint32_t)CANx->CAN_MCR.MAXMB + 1U;
-    uint32_t maxMb;
     uint32_t status;
-    uint8_t mbId;
     
-    status = CANxw->CAN_IFLAG2;
-    status &= CANxw->CAN_IMASK2;
-    status &= 0xFFFFU;
+    status = CANxw->CAN_WU_MTC; 
+    /* only check enabled interrupts */
+    status = status & (CANxw->CAN_CTRL1_PN & CAN_INT_MSK_FLAG_ALL_PN);
+    /* clear int status */
+    CANxw->CAN_WU_MTC = status;
     
-    maxMb = (totalMbNum > 48U) ? 48U : totalMbNum;
-    for(mbId = 32U; mbId < maxMb; mbId++)
+    /* wakeup match interrupt */
+    if((status & CAN_INT_MSK_FLAG_PN_WAKEUP_MATCH) != 0U)
     {
-        if((status & (0x00000001UL << (mbId -32U))) != 0U)
+        if(canIsrCbFunc[id].cbf[CAN_INT_PN_WAKEUP_MATCH] != NULL)
+        {
+            canIsrCbFunc[id].cbf[CAN_INT_PN_WAKEUP_MATCH]();
+        }
+        else
         {
-            if(canIsrCbFunc[id].mbCbf[CAN05_MB_INT_32TO47] != NULL)
+            if(SUCC != CAN_IntMask(id, CAN_INT_PN_WAKEUP_MATCH, MASK, 0, 0, 0, 0))
             {
-                canIsrCbFunc[id].mbCbf[CAN05_MB_INT_32TO47](mbId);
             }
-            else
+        }            
+    }
+    
+    /* wakeup timeout interrupt */
+    if((status & CAN_INT_MSK_FLAG_PN_WAKEUP_TIMEOUT) != 0U)
+    {
+        if(canIsrCbFunc[id].cbf[CAN_INT_PN_WAKEUP_TIMEOUT] != NULL)
+        {
+            canIsrCbFunc[id].cbf[CAN_INT_PN_WAKEUP_TIMEOUT]();
+        }
+        else
+        {
+            if(SUCC != CAN_IntMask(id, CAN_INT_PN_WAKEUP_TIMEOUT, MASK, 0, 0, 0, 0))
             {
-                CANxw->CAN_IMASK2 &= ~(0x00000001UL<<(mbId -32U));
             }
-        }
-                
-        /* clear MB interrupt */
-        CANxw->CAN_IFLAG2 = 0x00000001UL<<(mbId -32U);
+        }            
     }
 }
 
 /**
- * @brief      CAN Handler for MB48 - MB63 interrupts
+ * @brief      CAN Handler for self wakeup interrupt
  *
  * @param[in]  id: select the CAN ID
  *
  * @return    none
  *
  */
-static void CAN05_Mb48To63Handler(CAN_Id_t id)
+static void CAN_SelfWakeupHandler(CAN_Id_t id)
 {
-    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint32_t totalMbNum = (uint32_t)CANx->CAN_MCR.MAXMB + 1U;
-    uint32_t maxMb;
-    uint32_t status;
-    uint32_t mbId;
     
-    status = CANxw->CAN_IFLAG2;
-    status &= CANxw->CAN_IMASK2;
-    status &= 0xFFFF0000U;
+    /* clear interrupt status */
+    CANxw->CAN_ESR1 = CAN_INT_MSK_FLAG_SELF_WAKEUP;
     
-    maxMb = (totalMbNum > 64U) ? 64U : totalMbNum;
-    for(mbId = 48U; mbId < maxMb; mbId++)
+    if(canIsrCbFunc[id].cbf[CAN_INT_SELF_WAKEUP] != NULL)
+    {
+        canIsrCbFunc[id].cbf[CAN_INT_SELF_WAKEUP]();
+    }
+    else
     {
-        if((status & (0x00000001UL << (mbId - 32U))) != 0U)
+        if(SUCC != CAN_IntMask(id, CAN_INT_SELF_WAKEUP, MASK, 0, 0, 0, 0))
         {
-            if(canIsrCbFunc[id].mbCbf[CAN05_MB_INT_48TO63] != NULL)
-            {
-                canIsrCbFunc[id].mbCbf[CAN05_MB_INT_48TO63](mbId);
-            }
-            else
-            {
-                CANxw->CAN_IMASK2 &= ~(0x00000001UL << (mbId - 32U));
-            }
         }
-                
-        /* clear MB interrupt */
-        CANxw->CAN_IFLAG2 = 0x00000001UL<<(mbId - 32U);
-    }
+    }  
 }
 
-#if (8U == CAN_INSTANCE_NUM)
 /**
- * @brief      CAN Handler for MB0 - MB31 interrupts
+ * @brief      CAN Handler for ECC error interrupt(including CAN_INT_HOST_MEM_ERR,
+ *             CAN_INT_CAN_MEM_ERR and CAN_INT_COR_MEM_ERR
  *
  * @param[in]  id: select the CAN ID
  *
  * @return    none
  *
  */
-static void CAN67_Mb0To31Handler(CAN_Id_t id)
+static void CAN_EccHandler(CAN_Id_t id)
 {
-    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint32_t totalMbNum = (uint32_t)CANx->CAN_MCR.MAXMB + 1U;
-    uint32_t maxMb;
     uint32_t status;
-    uint32_t mbId;
     
-    status = CANxw->CAN_IFLAG1;
-    status &= CANxw->CAN_IMASK1;
+    status = CANxw->CAN_ERRSR; 
+    /* only check enabled interrupts */
+    status = status & (CANxw->CAN_MECR & CAN_INT_MSK_FLAG_ALL_ECC);
+    /* clear int status */
+    CANxw->CAN_ERRSR = status;
     
-    maxMb = (totalMbNum > 32U) ? 32U : totalMbNum;
-    for(mbId = 0U; mbId < maxMb; mbId++)
+    /* Host Access With Non-Correctable Error Interrupt */
+    if((status & CAN_INT_MSK_FLAG_HOST_MEM_ERR) != 0U)
     {
-        if((status & (0x00000001UL << mbId)) != 0U)
+        if(canIsrCbFunc[id].cbf[CAN_INT_HOST_MEM_ERR] != NULL)
+        {
+            canIsrCbFunc[id].cbf[CAN_INT_HOST_MEM_ERR]();
+        }
+        else
         {
-            if((CANx->CAN_MCR.RFEN != 0U) && (mbId <= CAN_RXFIFO_OVERFLOW))
+            if(SUCC != CAN_IntMask(id, CAN_INT_HOST_MEM_ERR, MASK, 0, 0, 0, 0))
             {
-                /* RX FIFO frame available interrupt */
-                if(CAN_RXFIFO_FRAME_AVAILABLE == mbId)
-                {
-                    if(canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_FRAME] != NULL)
-                    {
-                        canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_FRAME]();
-                    }
-                    else
-                    {
-                        CANxw->CAN_IMASK1 &= ~CAN_INT_MSK_FLAG_RXFIFO_FRAME;
-                    }
-                }
-                /* RX FIFO warning interrupt */
-                else if (CAN_RXFIFO_WARNING == mbId)
-                {
-                    if(canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_WARNING] != NULL)
-                    {
-                        canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_WARNING]();
-                    }
-                    else
-                    {
-                        CANxw->CAN_IMASK1 &= ~CAN_INT_MSK_FLAG_RXFIFO_WARNING;
-                    }
-                }
-                /* RX FIFO overflow interrupt */
-                else if (CAN_RXFIFO_OVERFLOW == mbId)
-                {
-                    if(canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_OVERFLOW] != NULL)
-                    {
-                        canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_OVERFLOW]();
-                    }
-                    else
-                    {
-                        CANxw->CAN_IMASK1 &= ~CAN_INT_MSK_FLAG_RXFIFO_OVERFLOW;
-                    }
-                }
-                else
-                {
-                      /*nothing to do*/
-                }
             }
-            else
+        }            
+    }
+    
+    /* CAN Access With Non-Correctable Error Interrupt */
+    if((status & CAN_INT_MSK_FLAG_CAN_MEM_ERR) != 0U)
+    {
+        if(canIsrCbFunc[id].cbf[CAN_INT_CAN_MEM_ERR] != NULL)
+        {
+            canIsrCbFunc[id].cbf[CAN_INT_CAN_MEM_ERR]();
+        }
+        else
+        {
+            if(SUCC != CAN_IntMask(id, CAN_INT_CAN_MEM_ERR, MASK, 0, 0, 0, 0))
             {
-                if(canIsrCbFunc[id].mbCbf[CAN67_MB_INT_0TO31] != NULL)
-                {
-                    canIsrCbFunc[id].mbCbf[CAN67_MB_INT_0TO31](mbId);
-                }
-                else
-                {
-                    CANxw->CAN_IMASK1 &= ~(0x00000001UL << mbId);
-                }
             }
-                
-            /* clear MB interrupt */
-            CANxw->CAN_IFLAG1 = 0x00000001UL << mbId;                
+        }            
+    }
+    /* Correctable Error Interrupt */
+    if((status & CAN_INT_MSK_FLAG_COR_MEM_ERR) != 0U)
+    {
+        if(canIsrCbFunc[id].cbf[CAN_INT_COR_MEM_ERR] != NULL)
+        {
+            canIsrCbFunc[id].cbf[CAN_INT_COR_MEM_ERR]();
         }
+        else
+        {
+            if(SUCC != CAN_IntMask(id, CAN_INT_COR_MEM_ERR, MASK, 0, 0, 0, 0))
+            {
+            }
+        }            
     }
 }
 
 /**
- * @brief      CAN Handler for MB32 - MB63 interrupts of CAN6-7
+ * @brief      Get the IFLAG and IMASK registers of a 32-MB word
  *
- * @param[in]  id: select the CAN ID
+ * @param[in]  CANxw: CAN word register pointer
+ * @param[in]  word: MB word index, MB(word*32) - MB(word*32+31)
+ * @param[out] iflag: points to the IFLAG register
+ * @param[out] imask: points to the IMASK register
  *
  * @return    none
  *
  */
-static void CAN67_Mb32To63Handler(CAN_Id_t id)
+static void CAN_GetMbIntReg(can_reg_w_t * CANxw, uint32_t word,
+                            volatile uint32_t **iflag, 
+                            volatile uint32_t **imask)
 {
-    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
-    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint32_t totalMbNum = (uint32_t)CANx->CAN_MCR.MAXMB + 1U;
-    uint32_t maxMb;
-    uint32_t status;
-    uint32_t mbId;
-    
-    status = CANxw->CAN_IFLAG2;
-    status &= CANxw->CAN_IMASK2;
-    
-    maxMb = (totalMbNum > 64U) ? 64U : totalMbNum;
-    for(mbId = 32U; mbId < maxMb; mbId++)
+    switch(word)
     {
-        if((status & (0x00000001UL << (mbId - 32U))) != 0U)
-        {
-            if(canIsrCbFunc[id].mbCbf[CAN67_MB_INT_32TO63] != NULL)
-            {
-                canIsrCbFunc[id].mbCbf[CAN67_MB_INT_32TO63](mbId);
-            }
-            else
-            {
-                CANxw->CAN_IMASK2 &= ~(0x00000001UL<<(mbId - 32U));
-            }
-        }
-                
-        /* clear MB interrupt */
-        CANxw->CAN_IFLAG2 = 0x00000001UL<<(mbId - 32U);                
+        case 0U:
+            *iflag = &CANxw->CAN_IFLAG1;
+            *imask = &CANxw->CAN_IMASK1;
+            break;
+        case 1U:
+            *iflag = &CANxw->CAN_IFLAG2;
+            *imask = &CANxw->CAN_IMASK2;
+            break;
+        case 2U:
+            *iflag = &CANxw->CAN_IFLAG3;
+            *imask = &CANxw->CAN_IMASK3;
+            break;
+        default:
+            *iflag = &CANxw->CAN_IFLAG4;
+            *imask = &CANxw->CAN_IMASK4;
+            break;
     }
 }
 
 /**
- * @brief      CAN Handler for MB64 - MB95 interrupts for CAN 6-7
+ * @brief      Handle the RX FIFO interrupts
  *
  * @param[in]  id: select the CAN ID
+ * @param[in]  status: pending RX FIFO interrupt flags
  *
  * @return    none
  *
  */
-static void CAN67_Mb64To95Handler(CAN_Id_t id)
+static void CAN_RxFifoIntHandler(CAN_Id_t id, uint32_t status)
 {
-    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint32_t totalMbNum = (uint32_t)CANx->CAN_MCR.MAXMB + 1U;
-    uint32_t maxMb; 
-    uint32_t status;
-    uint8_t mbId;
-    
-    status = CANxw->CAN_IFLAG3;
-    status &= CANxw->CAN_IMASK3;
+    FlagStatus_t fifoHandled;
     
-    maxMb = (totalMbNum > 96U) ? 96U : totalMbNum;
-    for(mbId = 64U; mbId < maxMb; mbId++)
+    /* RX FIFO frame available interrupt */
+    if((status & CAN_INT_MSK_FLAG_RXFIFO_FRAME) != 0U)
     {
-        if((status & (0x00000001UL<<(mbId - 64U))) != 0U)
+#if (1U == CAN_STATS_EN)
+        CAN_StatsFrame(id, CANxw->CAN_MB[0].MB0, RESET);
+#endif
+        fifoHandled = CAN_RxRingSaveFifo(id);
+        if(canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_FRAME] != NULL)
         {
-            if(canIsrCbFunc[id].mbCbf[CAN67_MB_INT_64TO95] != NULL)
-            {
-                canIsrCbFunc[id].mbCbf[CAN67_MB_INT_64TO95](mbId);
-            }
-            else
-            {
-                CANxw->CAN_IMASK3 &= ~(0x00000001UL<<(mbId - 64U));
-            }
+            canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_FRAME]();
+        }
+        else if(RESET == fifoHandled)
+        {
+            CANxw->CAN_IMASK1 &= ~CAN_INT_MSK_FLAG_RXFIFO_FRAME;
+        }
+        else
+        {
+            /* the frame is handled by the driver */
+        }
+    }
+    /* RX FIFO warning interrupt */
+    if((status & CAN_INT_MSK_FLAG_RXFIFO_WARNING) != 0U)
+    {
+        if(canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_WARNING] != NULL)
+        {
+            canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_WARNING]();
+        }
+        else
+        {
+            CANxw->CAN_IMASK1 &= ~CAN_INT_MSK_FLAG_RXFIFO_WARNING;
+        }
+    }
+    /* RX FIFO overflow interrupt */
+    if((status & CAN_INT_MSK_FLAG_RXFIFO_OVERFLOW) != 0U)
+    {
+        if(canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_OVERFLOW] != NULL)
+        {
+            canIsrCbFunc[id].cbf[CAN_INT_RXFIFO_OVERFLOW]();
+        }
+        else
+        {
+            CANxw->CAN_IMASK1 &= ~CAN_INT_MSK_FLAG_RXFIFO_OVERFLOW;
         }
-                
-        /* clear MB interrupt */
-        CANxw->CAN_IFLAG3 = 0x00000001UL<<(mbId - 64U);
     }
+    
+    /* clear RX FIFO interrupts after the frame is read, clearing the frame
+       available flag pops the frame from RX FIFO */
+    CANxw->CAN_IFLAG1 = status;
 }
 
 /**
- * @brief      CAN Handler for MB96 - MB127 interrupts of CAN6-7
+ * @brief      CAN Handler for MB interrupts. It is shared by all MB interrupt
+ *             groups: MB0-15/16-31/32-47/48-63 of CAN0-5 and 
+ *             MB0-31/32-63/64-95/96-127 of CAN6-7. Only the pending and 
+ *             enabled MBs are visited, lowest MB first.
  *
  * @param[in]  id: select the CAN ID
+ * @param[in]  group: MB interrupt group, CAN05_MbInt_t for CAN0-5 and 
+ *                    CAN67_MbInt_t for CAN6-7
  *
  * @return    none
  *
  */
-static void CAN67_Mb96To127Handler(CAN_Id_t id)
+static void CAN_MbIntHandler(CAN_Id_t id, uint32_t group)
 {
     can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
     uint32_t totalMbNum = (uint32_t)CANx->CAN_MCR.MAXMB + 1U;
-    uint32_t maxMb;
+    uint32_t groupSize = CAN_GET_MB_INT_GROUP_SIZE(id);
+    uint32_t firstMb = group * groupSize;
+    uint32_t wordFirstMb = firstMb & ~0x1FU;
+    volatile uint32_t *iflag;
+    volatile uint32_t *imask;
+    uint32_t mbNum;
+    uint32_t validMask;
     uint32_t status;
+    uint32_t fifoStatus = 0U;
+    uint32_t mbBit;
     uint32_t mbId;
+    FlagStatus_t mbHandled;
+#if (1U == CAN_STATS_EN)
+    uint16_t startTime = (uint16_t)CANxw->CAN_TIMER;
+    uint16_t isrTime;
+#endif
     
-    status = CANxw->CAN_IFLAG4;
-    status &= CANxw->CAN_IMASK4;
-    
-    maxMb = (totalMbNum >= 128U) ? 128U : totalMbNum;
-    for(mbId = 96U; mbId < maxMb; mbId++)
+    if(totalMbNum > firstMb)
     {
-        if((status & (0x00000001UL<<(mbId - 96U))) != 0U)
+        mbNum = totalMbNum - firstMb;
+        if(mbNum >= groupSize)
+        {
+            mbNum = groupSize;
+        }
+        validMask = (mbNum >= 32U) ? 0xFFFFFFFFU : ((0x00000001UL << mbNum) - 1U);
+        validMask <<= (firstMb - wordFirstMb);
+        
+        CAN_GetMbIntReg(CANxw, firstMb >> 5U, &iflag, &imask);
+        status = *iflag & *imask & validMask;
+        
+        if((0U == firstMb) && (CANx->CAN_MCR.RFEN != 0U))
+        {
+            /* MB0-7 flags are RX FIFO flags when RX FIFO is enabled */
+            fifoStatus = status & CAN_RXFIFO_INT_MASK;
+            status &= ~CAN_RXFIFO_INT_MASK;
+        }
+        
+        /* clear MB interrupts in one write before they are handled, so that
+           an MB completed again while being handled raises a new interrupt */
+        if(status != 0U)
+        {
+            *iflag = status;
+        }
+        
+        if(fifoStatus != 0U)
+        {
+            CAN_RxFifoIntHandler(id, fifoStatus);
+        }
+        
+        while(status != 0U)
         {
-            if(canIsrCbFunc[id].mbCbf[CAN67_MB_INT_96TO127] != NULL)
+            /* lowest pending MB */
+            mbBit = status & (0U - status);
+            status &= ~mbBit;
+            mbId = wordFirstMb + (31U - COMMON_CountLeadingZeros(mbBit));
+            
+#if (1U == CAN_STATS_EN)
+            CAN_StatsMb(id, mbId);
+#endif
+            mbHandled = CAN_TxQueueMbHandler(id, mbId);
+            if(RESET == mbHandled)
+            {
+                mbHandled = CAN_RxRingSaveMb(id, mbId);
+            }
+            if(canIsrCbFunc[id].mbCbf[group] != NULL)
             {
-                canIsrCbFunc[id].mbCbf[CAN67_MB_INT_96TO127](mbId);
+                canIsrCbFunc[id].mbCbf[group](mbId);
+            }
+            else if(RESET == mbHandled)
+            {
+                *imask &= ~mbBit;
             }
             else
             {
-                CANxw->CAN_IMASK4 &= ~(0x00000001UL<<(mbId - 96U));
+                /* the MB is handled by the driver */
             }
         }
-                
-        /* clear MB interrupt */
-        CANxw->CAN_IFLAG4 = 0x00000001UL<<(mbId - 96U);
     }
-}
+    
+#if (1U == CAN_STATS_EN)
+    isrTime = (uint16_t)CANxw->CAN_TIMER - startTime;
+    canStats[id].stats.isrCnt++;
+    canStats[id].stats.isrTimeSum += isrTime;
+    if(isrTime > canStats[id].stats.isrTimeMax)
+    {
+        canStats[id].stats.isrTimeMax = isrTime;
+    }
 #endif
+}
+
 /** @} end of group CAN_Private_Functions */
 
 /** @defgroup CAN_Public_Functions
@@ -2237,11 +3477,13 @@ ResultStatus_t CAN_Init(CAN_Id_t id, const CAN_Config_t *config)
             }
         }
         
+        /* MB layout depends on FDEN and MBDSRx, rebuild the address table */
+        CAN_BuildMbAddrTable(id);
     }
     
     if(SUCC == retVal)
     {
-        if((config->mbMaxNum > CAN_GetMaxMbNumLimit(id)) || 
+        if((config->mbMaxNum > canMbAddrTable[id].mbNum) || 
            (config->mbMaxNum > CAN_GET_MB_NUM(id)))
         {
             retVal = ERR;
@@ -3649,6 +4891,222 @@ ResultStatus_t CAN_ConfigRxFifo(CAN_Id_t id, CAN_RxFifoIdFormat_t format,
     return retVal;
 }
 
+/**
+ * @brief      Compile acceptance filter rules into the RX FIFO ID filter table
+ *             and individual masks. Each rule is split into ID/mask entries, 
+ *             and for each ID filter format (A: 1, B: 2, C: 4 entries per 
+ *             element) the entries are merged until they fit the table, 
+ *             entries with a partial mask only in the elements with an 
+ *             individual mask. The format accepting the fewest IDs is set in
+ *             hardware. If it accepts more IDs than the rules, the rules are
+ *             kept in a software filter checked by CAN_RxFilterAccept().
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  rules: points to the filter rules
+ * @param[in]  ruleNum: number of rules. 0 rejects all frames.
+ * @param[in]  mem: points to the filter memory
+ * @param[out] result: points to the address where the result will be stored,
+ *                     it can be NULL
+ *
+ * @note       RX FIFO shall be enabled and the RX individual mask type 
+ *             selected. It runs in O(n^3) of the entry number and is meant to
+ *             be called at initialization. The RTR bit is not compared.
+ *
+ * @return     status
+ *             - SUCC -- successful
+ *             - ERR -- some error
+ *
+ */
+ResultStatus_t CAN_CompileRxFilter(CAN_Id_t id, const CAN_FilterRuleCfg_t *rules,
+                                   uint32_t ruleNum, const CAN_FilterMem_t *mem,
+                                   CAN_FilterResult_t *result)
+{
+    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
+    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
+    volatile uint32_t *filterTable = &(CANxw->CAN_MB[6].MB0);
+    const uint32_t globalMask[CAN_FILTER_FORMAT_NUM] = {
+        CAN_FILTER_A_GLOBAL_MASK, CAN_FILTER_B_GLOBAL_MASK, 
+        CAN_FILTER_C_GLOBAL_MASK};
+    CAN_FilterResult_t res;
+    CAN_FilterEntry_t *work;
+    CAN_RxFifoIdFormat_t format;
+    uint32_t freeze =  CANx->CAN_MCR.FRZACK;
+    uint32_t entryNum = 0U;
+    uint32_t elementNum;
+    uint32_t indivNum;
+    uint32_t slotNum;
+    uint32_t fmt;
+    uint32_t hwNum;
+    uint32_t i, j;
+    uint32_t element;
+    uint32_t mask;
+    uint64_t cost;
+    uint64_t bestCost = 0U;
+    FlagStatus_t lossy;
+    ResultStatus_t retVal = SUCC;
+    
+    canSwFilter[id].enable = RESET;
+    
+    res.format = CAN_RX_FIFO_ID_FORMAT_D;
+    res.hwEntryNum = 0U;
+    res.swEntryNum = 0U;
+    res.swHashNum = 0U;
+    res.swFilterEn = RESET;
+    
+    elementNum = ((uint32_t)CANx->CAN_CTRL2.RFFN + 1U) << 3U;
+    indivNum = CAN_GetNoOfRxFIFOIndividualMask(id) + 1U;
+    if(indivNum > elementNum)
+    {
+        indivNum = elementNum;
+    }
+    
+    if((0U == CANx->CAN_MCR.RFEN) || (0U == CANx->CAN_MCR.IRMQ) || 
+       (NULL == mem) || (NULL == mem->entryBuf) || 
+       ((ruleNum != 0U) && (NULL == rules)))
+    {
+        retVal = ERR;
+    }
+    else
+    {
+        entryNum = CAN_FilterSplitRules(rules, ruleNum, mem->entryBuf, 
+                                        mem->entryNum >> 1U);
+        if(0xFFFFFFFFU == entryNum)
+        {
+            retVal = ERR;
+        }
+    }
+    
+    if((SUCC == retVal) && (entryNum != 0U))
+    {
+        /* the second half of entryBuf holds the hardware entries */
+        work = &mem->entryBuf[entryNum];
+        
+        for(fmt = 0U; fmt < CAN_FILTER_FORMAT_NUM; fmt++)
+        {
+            format = (CAN_RxFifoIdFormat_t)fmt;
+            slotNum = 1UL << fmt;
+            lossy = RESET;
+            CAN_FilterMapEntries(format, mem->entryBuf, work, entryNum, &lossy);
+            hwNum = CAN_FilterFit(format, work, entryNum, indivNum * slotNum,
+                                  elementNum * slotNum, &cost, &lossy);
+            if((hwNum != 0U) && 
+               ((CAN_RX_FIFO_ID_FORMAT_D == res.format) || (cost < bestCost)))
+            {
+                bestCost = cost;
+                res.format = format;
+                res.swFilterEn = lossy;
+            }
+        }
+        
+        if(CAN_RX_FIFO_ID_FORMAT_D == res.format)
+        {
+            retVal = ERR;
+        }
+        else
+        {
+            /* redo the selected format */
+            format = res.format;
+            slotNum = 1UL << (uint32_t)format;
+            lossy = RESET;
+            CAN_FilterMapEntries(format, mem->entryBuf, work, entryNum, &lossy);
+            res.hwEntryNum = CAN_FilterFit(format, work, entryNum, 
+                                           indivNum * slotNum, 
+                                           elementNum * slotNum, &cost, &lossy);
+            res.swFilterEn = lossy;
+        }
+    }
+    
+    if((SUCC == retVal) && (0U == freeze))
+    {
+        if(CAN_EnterFreezeMode(id) != SUCC)
+        {
+            retVal = ERR;
+        }
+    }
+    
+    if(SUCC == retVal)
+    {
+        /* clear RX FIFO */
+        CANx->CAN_IFLAG1.BUF0I = 1U;
+        CANx->CAN_MCR.IDAM = (uint32_t)res.format;
+        
+        if(res.format != CAN_RX_FIFO_ID_FORMAT_D)
+        {
+            work = &mem->entryBuf[entryNum];
+            slotNum = 1UL << (uint32_t)res.format;
+            for(i = 0U; i < elementNum; i++)
+            {
+                element = 0U;
+                mask = 0U;
+                for(j = 0U; j < slotNum; j++)
+                {
+                    /* unused slots repeat the first entry */
+                    hwNum = (i * slotNum) + j;
+                    if(hwNum >= res.hwEntryNum)
+                    {
+                        hwNum = 0U;
+                    }
+                    CAN_FilterEncode(res.format, j, &work[hwNum], &element, 
+                                     &mask);
+                }
+                filterTable[i] = element;
+                if(i < indivNum)
+                {
+                    CANxw->CAN_RXIMR[i] = mask;
+                }
+            }
+            CANxw->CAN_RXFGMASK = globalMask[res.format];
+        }
+        
+        if(SET == res.swFilterEn)
+        {
+            CAN_SwFilterSet(id, mem, entryNum, &res);
+            canSwFilter[id].enable = SET;
+        }
+        
+        if (0U == freeze)
+        {
+            if(CAN_ExitFreezeMode(id) != SUCC)
+            {
+                retVal = ERR;
+            }
+        }
+    }
+    
+    if(result != NULL)
+    {
+        *result = res;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief      Check a received frame ID against the software filter set by
+ *             CAN_CompileRxFilter(). The RX ring drops the RX FIFO frames 
+ *             rejected by it.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  idType: standard or extended ID
+ * @param[in]  msgId: the received ID
+ *
+ * @return     SET: the frame is accepted, or no software filter is used
+ *             RESET: the frame is rejected
+ *
+ */
+FlagStatus_t CAN_RxFilterAccept(CAN_Id_t id, CAN_MsgId_t idType, 
+                                uint32_t msgId)
+{
+    FlagStatus_t ret = SET;
+    
+    if(SET == canSwFilter[id].enable)
+    {
+        ret = CAN_SwFilterMatch(&canSwFilter[id], idType, msgId);
+    }
+    
+    return ret;
+}
+
 /**
  * @brief      Get a message buffer field values.
  *
@@ -3669,13 +5127,8 @@ ResultStatus_t CAN_ConfigRxFifo(CAN_Id_t id, CAN_RxFifoIdFormat_t format,
 ResultStatus_t CAN_GetMsgBuff(CAN_Id_t id, uint32_t mbIdx, CAN_MsgBuf_t *msgBuff)
 {
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint8_t i;
-    uint8_t tmpNum;
-    uint8_t tmpIndex;
-    uint8_t payloadSize;
     CAN_FdMbRegion_t region;
     CAN_Mb_t *mbAddr;
-    volatile uint8_t  *mbData;
     ResultStatus_t retVal = SUCC;
     if(ERR == CAN_GetMbAddr(id, (uint8_t)mbIdx, &region, &mbAddr))
     {
@@ -3683,8 +5136,6 @@ ResultStatus_t CAN_GetMsgBuff(CAN_Id_t id, uint32_t mbIdx, CAN_MsgBuf_t *msgBuff
     }    
     else
     {
-        mbData = (volatile uint8_t *)(&mbAddr->data[0]);
-    
         if(ERR == CAN_CheckMbId(id,mbIdx))
         {
             retVal = ERR;
@@ -3696,48 +5147,98 @@ ResultStatus_t CAN_GetMsgBuff(CAN_Id_t id, uint32_t mbIdx, CAN_MsgBuf_t *msgBuff
         /* Lock the mailbox by reading it */
         (void)(mbAddr->config.WORDVAL);
         
+        CAN_ReadMbFrame(mbAddr, canMbAddrTable[id].regionPayload[region], 
+                        msgBuff);
+        
+        /* Unlock the mailbox by reading the free running timer */
+        (void)CANxw->CAN_TIMER;
+    }
+    
+    
+    return retVal;
+}
+
+/**
+ * @brief      Lock a message buffer and get a view of it without copying the
+ *             payload. The data can be read from view->data or with 
+ *             CAN_MB_VIEW_BYTE() until CAN_ReleaseMb() is called, the MB is 
+ *             not updated by the CAN controller while it is locked.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  mbIdx: MB index. The MB should not be occupied by RX FIFO if RX
+ *                    FIFO is enabled, othersise, it will return ERR.
+ *                    For CAN0-5, the maximum mbIdx is 63 if payload size is
+ *                    8-byte. 
+ *                    For CAN6-7, the maximum mbIdx is 127 if payload size is
+ *                    8-byte.
+ * @param[out] view: points to the address where the MB view will be stored 
+ *
+ * @note       Only one MB of a CAN instance can be locked. Accessing another 
+ *             MB, including from the MB interrupts, releases the lock. The 
+ *             code in view->cs shall be checked for a received frame.
+ *
+ * @return     status
+ *             - SUCC -- the MB is locked
+ *             - ERR -- some error
+ *
+ */
+ResultStatus_t CAN_LockMb(CAN_Id_t id, uint32_t mbIdx, CAN_MbView_t *view)
+{
+    CAN_FdMbRegion_t region;
+    CAN_Mb_t *mbAddr;
+    uint8_t payloadSize;
+    ResultStatus_t retVal = SUCC;
+    
+    if(ERR == CAN_GetMbAddr(id, (uint8_t)mbIdx, &region, &mbAddr))
+    {
+        retVal = ERR;
+    }    
+    else if(ERR == CAN_CheckMbId(id,mbIdx))
+    {
+        retVal = ERR;
+    }
+    else
+    {
+        /* Lock the mailbox by reading it */
+        view->cs = mbAddr->config.WORDVAL;
+        
         payloadSize = CAN_ComputePayloadSize((uint8_t)(mbAddr->config.BF.DLC));
-        if(payloadSize > CAN_GetPayloadSize(id,region))
+        if(payloadSize > canMbAddrTable[id].regionPayload[region])
         {
-            payloadSize = CAN_GetPayloadSize(id,region);
+            payloadSize = canMbAddrTable[id].regionPayload[region];
         }
+        view->dataLen = payloadSize;
         
-        msgBuff->dataLen = payloadSize;
-        msgBuff->cs = mbAddr->config.WORDVAL;
         if(mbAddr->config.BF.IDE != 0U)
         {
-            msgBuff->msgId = mbAddr->id.WORDVAL & CAN_ID_EXT_MASK;
+            view->msgId = mbAddr->id.WORDVAL & CAN_ID_EXT_MASK;
         }
         else
         {
-            msgBuff->msgId = mbAddr->id.BF.ID_STANDARD;
-        }
-        
-        tmpNum = payloadSize >> 2U;
-        for (i = 0U ; i < tmpNum; i += 1U)
-        {
-            msgBuff->data[(i<<2U)] = (uint8_t)((mbAddr->data[i] & 0xFF000000U) >> 24U);
-            msgBuff->data[(i<<2U) + 1U] = (uint8_t)((mbAddr->data[i] & 0xFF0000U) >> 
-                                                 16U);
-            msgBuff->data[(i<<2U) + 2U] = (uint8_t)((mbAddr->data[i] & 0xFF00U) >> 8U);
-            msgBuff->data[(i<<2U) + 3U] = (uint8_t)(mbAddr->data[i] & 0xFFU);
-        }
-
-        for ( i = (tmpNum << 2U); i < payloadSize ; i++)
-        {
-            tmpIndex = CAN_SWAP_BYTES_IN_WORD_INDEX(i) & 0x3FU;
-            /* Max allowed value for index is 63 */
-            msgBuff->data[i] = mbData[tmpIndex];
+            view->msgId = mbAddr->id.BF.ID_STANDARD;
         }
-        
-        /* Unlock the mailbox by reading the free running timer */
-        (void)CANxw->CAN_TIMER;
+        view->data = &mbAddr->data[0];
     }
     
-    
     return retVal;
 }
 
+/**
+ * @brief      Release the message buffer locked by CAN_LockMb().
+ *
+ * @param[in]  id: select the CAN ID
+ *
+ * @return     none
+ *
+ */
+void CAN_ReleaseMb(CAN_Id_t id)
+{
+    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
+    
+    /* Unlock the mailbox by reading the free running timer */
+    (void)CANxw->CAN_TIMER;
+}
+
 /**
  * @brief      Read a frame in RX FIFO.
  *
@@ -3752,50 +5253,387 @@ ResultStatus_t CAN_GetMsgBuff(CAN_Id_t id, uint32_t mbIdx, CAN_MsgBuf_t *msgBuff
 void CAN_ReadRxFifo(CAN_Id_t id, CAN_MsgBuf_t *msgBuff)
 {
     can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
-    uint8_t i;
-    uint8_t tmpNum;
-    uint8_t tmpIndex;
-    uint8_t payloadSize;
     /*PRQA S 0303 ++*/
-    volatile CAN_Mb_t *mbAddr = (CAN_Mb_t *)(uint32_t)&(CANxw->CAN_MB[0].MB0);
+    const CAN_Mb_t *mbAddr = (CAN_Mb_t *)(uint32_t)&(CANxw->CAN_MB[0].MB0);
     /*PRQA S 0303 --*/
-    volatile uint8_t  *mbData;
     
-    payloadSize = CAN_ComputePayloadSize((uint8_t)mbAddr->config.BF.DLC);
-    if(payloadSize > CAN_GetPayloadSize(id,CAN_FD_MB_REGION_0))
+    CAN_ReadMbFrame(mbAddr, 
+                    canMbAddrTable[id].regionPayload[CAN_FD_MB_REGION_0],
+                    msgBuff);
+}
+
+/**
+ * @brief      Config the RX ring of a CAN instance. When the RX ring is 
+ *             configured, the MB interrupt handlers copy every received frame
+ *             of the RX MBs and the RX FIFO into the ring and free the MB 
+ *             immediately. The installed MB/RX FIFO call back functions are 
+ *             still called as a notification, and the MB interrupts are not
+ *             masked if there is no call back function. The frames are then
+ *             read with CAN_ReceiveBatch().
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  frameBuf: points to the frame storage of the ring. NULL 
+ *                       disables the RX ring.
+ * @param[in]  frameNum: number of frames in frameBuf, it shall be a power 
+ *                       of 2.
+ *
+ * @note       It shall be called while the MB interrupts are masked.
+ *
+ * @return     status
+ *             - SUCC -- successful
+ *             - ERR -- frameNum is not a power of 2
+ *
+ */
+ResultStatus_t CAN_RxRingConfig(CAN_Id_t id, CAN_RxFrame_t *frameBuf, 
+                                uint32_t frameNum)
+{
+    CAN_RxRing_t *ring = &canRxRing[id];
+    ResultStatus_t retVal = SUCC;
+    
+    if(NULL == frameBuf)
     {
-        payloadSize = CAN_GetPayloadSize(id,CAN_FD_MB_REGION_0);
+        ring->frameBuf = NULL;
+        ring->frameNum = 0U;
+    }
+    else if((0U == frameNum) || ((frameNum & (frameNum - 1U)) != 0U))
+    {
+        retVal = ERR;
+    }
+    else
+    {
+        ring->frameBuf = frameBuf;
+        ring->frameNum = frameNum;
     }
     
-    msgBuff->dataLen = payloadSize;
-    msgBuff->cs = mbAddr->config.WORDVAL;
-    if(mbAddr->config.BF.IDE != 0U)
+    if(SUCC == retVal)
     {
-        msgBuff->msgId = mbAddr->id.WORDVAL & CAN_ID_EXT_MASK;
+        ring->head = 0U;
+        ring->tail = 0U;
+        ring->dropCnt = 0U;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief      Read the received frames out of the RX ring. It shall not be 
+ *             called from different contexts at the same time.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[out] frames: points to the buffer where the frames will be stored
+ * @param[in]  maxNum: the maximum number of frames to be read
+ *
+ * @return     the number of frames read
+ *
+ */
+uint32_t CAN_ReceiveBatch(CAN_Id_t id, CAN_RxFrame_t *frames, uint32_t maxNum)
+{
+    CAN_RxRing_t *ring = &canRxRing[id];
+    uint32_t head = ring->head;
+    uint32_t tail = ring->tail;
+    uint32_t num = 0U;
+    
+    if((ring->frameBuf != NULL) && (frames != NULL))
+    {
+        while((tail != head) && (num < maxNum))
+        {
+            frames[num] = ring->frameBuf[tail & (ring->frameNum - 1U)];
+            tail++;
+            num++;
+        }
+        
+        /* The frames shall be read before they are released to the producer */
+        COMMON_DMB();
+        ring->tail = tail;
+    }
+    
+    return num;
+}
+
+/**
+ * @brief      Get the number of frames dropped because the RX ring was full.
+ *
+ * @param[in]  id: select the CAN ID
+ *
+ * @return     the number of dropped frames
+ *
+ */
+uint32_t CAN_GetRxRingDropCount(CAN_Id_t id)
+{
+    return canRxRing[id].dropCnt;
+}
+
+/**
+ * @brief      Config the TX queue of a CAN instance. Frames sent through 
+ *             CAN_TxQueueSend() are ordered according to the TX priority mode
+ *             selected by CAN_SelectTxPriorityMode(), and loaded into the free
+ *             MBs of the TX MB pool. The pool MBs are refilled from their TX
+ *             complete interrupts, which are unmasked by this function.
+ *             - CAN_TX_PRI_HIGH_PRI_FIRST: ordered by CAN ID
+ *             - CAN_TX_PRI_LOCAL_PRI_EN: ordered by local priority, then CAN ID
+ *             - CAN_TX_PRI_LOW_NUM_MB_FIRST: sent in order
+ *             Frames of the same priority are sent in order. If strict 
+ *             ordering of frames with the same ID is needed across pool MBs, 
+ *             use a pool of one MB.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  config: points to the TX queue configuration. NULL disables 
+ *                     the TX queue.
+ *
+ * @note       The TX priority mode shall be selected before this function.
+ *             The pool MBs shall be inactive and shall not be used by other
+ *             TX/RX functions.
+ *
+ * @return     status
+ *             - SUCC -- successful
+ *             - ERR -- some error
+ *
+ */
+ResultStatus_t CAN_TxQueueConfig(CAN_Id_t id, const CAN_TxQueueConfig_t *config)
+{
+    can_reg_t * CANx = (can_reg_t *)(canRegPtr[id]);
+    CAN_TxQueue_t *queue = &canTxQueue[id];
+    uint32_t index;
+    ResultStatus_t retVal = SUCC;
+    
+    if(NULL == config)
+    {
+        /* TX queue is disabled */
+        queue->frameBuf = NULL;
+    }
+    else if((NULL == config->frameBuf) || (0U == config->frameNum) || 
+            (config->frameNum >= CAN_TX_QUEUE_NONE) || 
+            (0U == config->mbNum) || (config->mbNum > CAN_TX_QUEUE_MB_MAX))
+    {
+        retVal = ERR;
     }
     else
     {
-        msgBuff->msgId = mbAddr->id.BF.ID_STANDARD;
+        for(index = 0U; index < config->mbNum; index++)
+        {
+            if(ERR == CAN_CheckMbId(id, (uint32_t)config->firstMb + index))
+            {
+                retVal = ERR;
+                break;
+            }
+        }
     }
     
-    tmpNum = (payloadSize>> 2U);
-    for (i = 0U ; i < tmpNum; i += 1U)
+    if((SUCC == retVal) && (config != NULL))
     {
-        msgBuff->data[(i<<2U)] = (uint8_t)((mbAddr->data[i] & 0xFF000000U) >> 24U);
-        msgBuff->data[(i<<2U) + 1U] = (uint8_t)((mbAddr->data[i] & 0xFF0000U) >> 
-                                             16U);
-        msgBuff->data[(i<<2U) + 2U] = (uint8_t)((mbAddr->data[i] & 0xFF00U) >> 8U);
-        msgBuff->data[(i<<2U) + 3U] = (uint8_t)(mbAddr->data[i] & 0xFFU);
+        /* detach the queue from the ISR while it is rebuilt */
+        queue->frameBuf = NULL;
+        
+        if(CANx->CAN_CTRL1.LBUF != 0U)
+        {
+            queue->prioMode = CAN_TX_PRI_LOW_NUM_MB_FIRST;
+        }
+        else if(CANx->CAN_MCR.LPRIOEN != 0U)
+        {
+            queue->prioMode = CAN_TX_PRI_LOCAL_PRI_EN;
+        }
+        else
+        {
+            queue->prioMode = CAN_TX_PRI_HIGH_PRI_FIRST;
+        }
+        
+        /* all frames are free */
+        for(index = 0U; index < config->frameNum; index++)
+        {
+            config->frameBuf[index].next = (uint16_t)(index + 1U);
+        }
+        config->frameBuf[config->frameNum - 1U].next = CAN_TX_QUEUE_NONE;
+        
+        queue->frameNum = config->frameNum;
+        queue->freeHead = 0U;
+        queue->pendHead = CAN_TX_QUEUE_NONE;
+        queue->firstMb = config->firstMb;
+        queue->mbNum = config->mbNum;
+        queue->abortMask = 0U;
+        queue->status.depth = 0U;
+        queue->status.maxDepth = 0U;
+        queue->status.sentCnt = 0U;
+        queue->status.dropCnt = 0U;
+        queue->status.abortCnt = 0U;
+        
+        for(index = 0U; index < config->mbNum; index++)
+        {
+            queue->mbFrame[index] = CAN_TX_QUEUE_NONE;
+            (void)CAN_SetMbCode(id, (uint32_t)config->firstMb + index, 
+                                CAN_MB_TX_INACTIVE);
+            (void)CAN_ClearMbIntStatus(id, (uint32_t)config->firstMb + index);
+            (void)CAN_MbIntMask(id, (uint32_t)config->firstMb + index, UNMASK);
+        }
+        
+        queue->frameBuf = config->frameBuf;
     }
     
-    mbData = (volatile uint8_t *)(&mbAddr->data[0]);
-    for (i = (tmpNum << 2U); i < payloadSize; i++)
+    return retVal;
+}
+
+/**
+ * @brief      Put a frame into the TX queue. The frame is loaded into a TX MB
+ *             immediately if one of the pool MBs is free.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[in]  txInfo: TX MB info
+ * @param[in]  msgId: message ID
+ * @param[in]  msgData: data of the message
+ * @param[in]  localPrio: the local priority field for the MB
+ *
+ * @return     status
+ *             - SUCC -- the frame is queued or loaded into a TX MB
+ *             - ERR -- the TX queue is not configured or txInfo is invalid
+ *             - BUSY -- the TX queue is full, the frame is dropped
+ *
+ */
+ResultStatus_t CAN_TxQueueSend(CAN_Id_t id, const CAN_MessageInfo_t *txInfo,
+                               uint32_t msgId, const uint8_t *msgData, 
+                               uint8_t localPrio)
+{
+    CAN_TxQueue_t *queue = &canTxQueue[id];
+    CAN_TxQueueFrame_t *frame;
+    uint16_t frameIdx;
+    uint32_t index;
+    uint32_t primask;
+    ResultStatus_t retVal = SUCC;
+    
+    if((NULL == queue->frameBuf) || (NULL == txInfo) || 
+       (txInfo->dataLen > 64U))
+    {
+        retVal = ERR;
+    }
+    else
     {
-        tmpIndex = CAN_SWAP_BYTES_IN_WORD_INDEX(i) & 0x3FU;
-        /* Max allowed value for index is 63 */
-        msgBuff->data[i] = mbData[tmpIndex];
+        primask = COMMON_GetPRIMASK();
+        COMMON_DISABLE_INTERRUPTS();
+        
+        frameIdx = queue->freeHead;
+        if(CAN_TX_QUEUE_NONE == frameIdx)
+        {
+            queue->status.dropCnt++;
+            retVal = BUSY;
+        }
+        else
+        {
+            frame = &queue->frameBuf[frameIdx];
+            queue->freeHead = frame->next;
+            
+            frame->txInfo = *txInfo;
+            frame->msgId = msgId;
+            frame->localPrio = localPrio;
+#if (1U == CAN_STATS_EN)
+            frame->timeStamp = 
+                (uint16_t)((can_reg_w_t *)(canRegWPtr[id]))->CAN_TIMER;
+#endif
+            if(msgData != NULL)
+            {
+                for(index = 0U; index < txInfo->dataLen; index++)
+                {
+                    frame->data[index] = msgData[index];
+                }
+            }
+            else
+            {
+                frame->txInfo.dataLen = 0U;
+            }
+            
+            CAN_TxQueueInsert(queue, frameIdx, RESET);
+            CAN_TxQueueSchedule(id);
+        }
+        
+        COMMON_SetPRIMASK(primask);
     }
+    
+    return retVal;
+}
+
+/**
+ * @brief      Get the TX queue status.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[out] status: points to the address where the status will be stored
+ *
+ * @return     none
+ *
+ */
+void CAN_GetTxQueueStatus(CAN_Id_t id, CAN_TxQueueStatus_t *status)
+{
+    uint32_t primask;
+    
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    *status = canTxQueue[id].status;
+    COMMON_SetPRIMASK(primask);
+}
+
+#if (1U == CAN_STATS_EN)
+/**
+ * @brief      Get a snapshot of the CAN statistics. Interrupts are disabled
+ *             only while the statistics are copied, so it can be called while
+ *             the CAN traffic goes on. The bus load is the busBitCnt 
+ *             difference of two snapshots divided by their timeStamp 
+ *             difference, if they are less than 65536 bit times apart.
+ *
+ * @param[in]  id: select the CAN ID
+ * @param[out] stats: points to the address where the statistics will be 
+ *                    stored
+ *
+ * @note  This function is available only when CAN_STATS_EN = 1U
+ * @return     none
+ *
+ */
+void CAN_GetStats(CAN_Id_t id, CAN_Stats_t *stats)
+{
+    can_reg_w_t * CANxw = (can_reg_w_t *)(canRegWPtr[id]);
+    uint32_t primask;
+    
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    *stats = canStats[id].stats;
+    stats->timeStamp = (uint16_t)CANxw->CAN_TIMER;
+    COMMON_SetPRIMASK(primask);
+}
+
+/**
+ * @brief      Clear the CAN statistics.
+ *
+ * @param[in]  id: select the CAN ID
+ *
+ * @note  This function is available only when CAN_STATS_EN = 1U
+ * @return     none
+ *
+ */
+void CAN_ClearStats(CAN_Id_t id)
+{
+    CAN_Stats_t *stats = &canStats[id].stats;
+    uint32_t primask;
+    uint32_t i;
+    
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    stats->txFrameCnt = 0U;
+    stats->rxFrameCnt = 0U;
+    stats->txByteCnt = 0U;
+    stats->rxByteCnt = 0U;
+    stats->busBitCnt = 0U;
+    stats->busOffCnt = 0U;
+    stats->errIntCnt = 0U;
+    stats->stuffErrCnt = 0U;
+    stats->formErrCnt = 0U;
+    stats->crcErrCnt = 0U;
+    stats->ackErrCnt = 0U;
+    stats->bitErrCnt = 0U;
+    for(i = 0U; i < CAN_STATS_LATENCY_BIN_NUM; i++)
+    {
+        stats->txLatencyHist[i] = 0U;
+    }
+    stats->isrCnt = 0U;
+    stats->isrTimeSum = 0U;
+    stats->isrTimeMax = 0U;
+    COMMON_SetPRIMASK(primask);
 }
+#endif
 /**
  * @brief     make the MB to inactive status and disable the interrupt of this
  *            MB. The MBs occupied by RX FIFO can not be handle by this function.
@@ -5753,7 +7591,7 @@ void CAN0_Ecc_DriverIRQHandler(void)
  */
 void CAN0_Mb0To15_DriverIRQHandler(void)
 {
-    CAN05_Mb0To15Handler(CAN_ID_0);
+    CAN_MbIntHandler(CAN_ID_0, (uint32_t)CAN05_MB_INT_0TO15);
     COMMON_DSB();
 }
 
@@ -5767,7 +7605,7 @@ void CAN0_Mb0To15_DriverIRQHandler(void)
  */
 void CAN0_Mb16To31_DriverIRQHandler(void)
 {
-    CAN05_Mb16To31Handler(CAN_ID_0);
+    CAN_MbIntHandler(CAN_ID_0, (uint32_t)CAN05_MB_INT_16TO31);
     COMMON_DSB();
 }
 
@@ -5781,7 +7619,7 @@ void CAN0_Mb16To31_DriverIRQHandler(void)
  */
 void CAN0_Mb32To47_DriverIRQHandler(void)
 {
-    CAN05_Mb32To47Handler(CAN_ID_0);
+    CAN_MbIntHandler(CAN_ID_0, (uint32_t)CAN05_MB_INT_32TO47);
     COMMON_DSB();
 }
 
@@ -5795,7 +7633,7 @@ void CAN0_Mb32To47_DriverIRQHandler(void)
  */
 void CAN0_Mb48To63_DriverIRQHandler(void)
 {
-    CAN05_Mb48To63Handler(CAN_ID_0);
+    CAN_MbIntHandler(CAN_ID_0, (uint32_t)CAN05_MB_INT_48TO63);
     COMMON_DSB();
 }
 
@@ -5923,7 +7761,7 @@ void CAN1_Ecc_DriverIRQHandler(void)
  */
 void CAN1_Mb0To15_DriverIRQHandler(void)
 {
-    CAN05_Mb0To15Handler(CAN_ID_1);
+    CAN_MbIntHandler(CAN_ID_1, (uint32_t)CAN05_MB_INT_0TO15);
     COMMON_DSB();
 }
 
@@ -5937,7 +7775,7 @@ void CAN1_Mb0To15_DriverIRQHandler(void)
  */
 void CAN1_Mb16To31_DriverIRQHandler(void)
 {
-    CAN05_Mb16To31Handler(CAN_ID_1);
+    CAN_MbIntHandler(CAN_ID_1, (uint32_t)CAN05_MB_INT_16TO31);
     COMMON_DSB();
 }
 
@@ -5951,7 +7789,7 @@ void CAN1_Mb16To31_DriverIRQHandler(void)
  */
 void CAN1_Mb32To47_DriverIRQHandler(void)
 {
-    CAN05_Mb32To47Handler(CAN_ID_1);
+    CAN_MbIntHandler(CAN_ID_1, (uint32_t)CAN05_MB_INT_32TO47);
     COMMON_DSB();
 }
 
@@ -5965,7 +7803,7 @@ void CAN1_Mb32To47_DriverIRQHandler(void)
  */
 void CAN1_Mb48To63_DriverIRQHandler(void)
 {
-    CAN05_Mb48To63Handler(CAN_ID_1);
+    CAN_MbIntHandler(CAN_ID_1, (uint32_t)CAN05_MB_INT_48TO63);
     COMMON_DSB();
 }
 /**
@@ -6092,7 +7930,7 @@ void CAN2_Ecc_DriverIRQHandler(void)
  */
 void CAN2_Mb0To15_DriverIRQHandler(void)
 {
-    CAN05_Mb0To15Handler(CAN_ID_2);
+    CAN_MbIntHandler(CAN_ID_2, (uint32_t)CAN05_MB_INT_0TO15);
     COMMON_DSB();
 }
 
@@ -6106,7 +7944,7 @@ void CAN2_Mb0To15_DriverIRQHandler(void)
  */
 void CAN2_Mb16To31_DriverIRQHandler(void)
 {
-    CAN05_Mb16To31Handler(CAN_ID_2);
+    CAN_MbIntHandler(CAN_ID_2, (uint32_t)CAN05_MB_INT_16TO31);
     COMMON_DSB();
 }
 
@@ -6120,7 +7958,7 @@ void CAN2_Mb16To31_DriverIRQHandler(void)
  */
 void CAN2_Mb32To47_DriverIRQHandler(void)
 {
-    CAN05_Mb32To47Handler(CAN_ID_2);
+    CAN_MbIntHandler(CAN_ID_2, (uint32_t)CAN05_MB_INT_32TO47);
     COMMON_DSB();
 }
 
@@ -6134,7 +7972,7 @@ void CAN2_Mb32To47_DriverIRQHandler(void)
  */
 void CAN2_Mb48To63_DriverIRQHandler(void)
 {
-    CAN05_Mb48To63Handler(CAN_ID_2);
+    CAN_MbIntHandler(CAN_ID_2, (uint32_t)CAN05_MB_INT_48TO63);
     COMMON_DSB();
 }
 /**
@@ -6261,7 +8099,7 @@ void CAN3_Ecc_DriverIRQHandler(void)
  */
 void CAN3_Mb0To15_DriverIRQHandler(void)
 {
-    CAN05_Mb0To15Handler(CAN_ID_3);
+    CAN_MbIntHandler(CAN_ID_3, (uint32_t)CAN05_MB_INT_0TO15);
     COMMON_DSB();
 }
 
@@ -6275,7 +8113,7 @@ void CAN3_Mb0To15_DriverIRQHandler(void)
  */
 void CAN3_Mb16To31_DriverIRQHandler(void)
 {
-    CAN05_Mb16To31Handler(CAN_ID_3);
+    CAN_MbIntHandler(CAN_ID_3, (uint32_t)CAN05_MB_INT_16TO31);
     COMMON_DSB();
 }
 
@@ -6289,7 +8127,7 @@ void CAN3_Mb16To31_DriverIRQHandler(void)
  */
 void CAN3_Mb32To47_DriverIRQHandler(void)
 {
-    CAN05_Mb32To47Handler(CAN_ID_3);
+    CAN_MbIntHandler(CAN_ID_3, (uint32_t)CAN05_MB_INT_32TO47);
     COMMON_DSB();
 }
 
@@ -6303,7 +8141,7 @@ void CAN3_Mb32To47_DriverIRQHandler(void)
  */
 void CAN3_Mb48To63_DriverIRQHandler(void)
 {
-    CAN05_Mb48To63Handler(CAN_ID_3);
+    CAN_MbIntHandler(CAN_ID_3, (uint32_t)CAN05_MB_INT_48TO63);
     COMMON_DSB();
 }
 #if ((6U == CAN_INSTANCE_NUM) || (8U == CAN_INSTANCE_NUM))
@@ -6431,7 +8269,7 @@ void CAN4_Ecc_DriverIRQHandler(void)
  */
 void CAN4_Mb0To15_DriverIRQHandler(void)
 {
-    CAN05_Mb0To15Handler(CAN_ID_4);
+    CAN_MbIntHandler(CAN_ID_4, (uint32_t)CAN05_MB_INT_0TO15);
     COMMON_DSB();
 }
 
@@ -6445,7 +8283,7 @@ void CAN4_Mb0To15_DriverIRQHandler(void)
  */
 void CAN4_Mb16To31_DriverIRQHandler(void)
 {
-    CAN05_Mb16To31Handler(CAN_ID_4);
+    CAN_MbIntHandler(CAN_ID_4, (uint32_t)CAN05_MB_INT_16TO31);
     COMMON_DSB();
 }
 
@@ -6459,7 +8297,7 @@ void CAN4_Mb16To31_DriverIRQHandler(void)
  */
 void CAN4_Mb32To47_DriverIRQHandler(void)
 {
-    CAN05_Mb32To47Handler(CAN_ID_4);
+    CAN_MbIntHandler(CAN_ID_4, (uint32_t)CAN05_MB_INT_32TO47);
     COMMON_DSB();
 }
 
@@ -6473,7 +8311,7 @@ void CAN4_Mb32To47_DriverIRQHandler(void)
  */
 void CAN4_Mb48To63_DriverIRQHandler(void)
 {
-    CAN05_Mb48To63Handler(CAN_ID_4);
+    CAN_MbIntHandler(CAN_ID_4, (uint32_t)CAN05_MB_INT_48TO63);
     COMMON_DSB();
 }
 
@@ -6601,7 +8439,7 @@ void CAN5_Ecc_DriverIRQHandler(void)
  */
 void CAN5_Mb0To15_DriverIRQHandler(void)
 {
-    CAN05_Mb0To15Handler(CAN_ID_5);
+    CAN_MbIntHandler(CAN_ID_5, (uint32_t)CAN05_MB_INT_0TO15);
     COMMON_DSB();
 }
 
@@ -6615,7 +8453,7 @@ void CAN5_Mb0To15_DriverIRQHandler(void)
  */
 void CAN5_Mb16To31_DriverIRQHandler(void)
 {
-    CAN05_Mb16To31Handler(CAN_ID_5);
+    CAN_MbIntHandler(CAN_ID_5, (uint32_t)CAN05_MB_INT_16TO31);
     COMMON_DSB();
 }
 
@@ -6629,7 +8467,7 @@ void CAN5_Mb16To31_DriverIRQHandler(void)
  */
 void CAN5_Mb32To47_DriverIRQHandler(void)
 {
-    CAN05_Mb32To47Handler(CAN_ID_5);
+    CAN_MbIntHandler(CAN_ID_5, (uint32_t)CAN05_MB_INT_32TO47);
     COMMON_DSB();
 }
 
@@ -6643,7 +8481,7 @@ void CAN5_Mb32To47_DriverIRQHandler(void)
  */
 void CAN5_Mb48To63_DriverIRQHandler(void)
 {
-    CAN05_Mb48To63Handler(CAN_ID_5);
+    CAN_MbIntHandler(CAN_ID_5, (uint32_t)CAN05_MB_INT_48TO63);
     COMMON_DSB();
 }
 #endif
@@ -6773,7 +8611,7 @@ void CAN6_Ecc_DriverIRQHandler(void)
  */
 void CAN6_Mb0To31_DriverIRQHandler(void)
 {
-    CAN67_Mb0To31Handler(CAN_ID_6);
+    CAN_MbIntHandler(CAN_ID_6, (uint32_t)CAN67_MB_INT_0TO31);
     COMMON_DSB();
 }
 
@@ -6787,7 +8625,7 @@ void CAN6_Mb0To31_DriverIRQHandler(void)
  */
 void CAN6_Mb32To63_DriverIRQHandler(void)
 {
-    CAN67_Mb32To63Handler(CAN_ID_6);
+    CAN_MbIntHandler(CAN_ID_6, (uint32_t)CAN67_MB_INT_32TO63);
     COMMON_DSB();
 }
 
@@ -6801,7 +8639,7 @@ void CAN6_Mb32To63_DriverIRQHandler(void)
  */
 void CAN6_Mb64To95_DriverIRQHandler(void)
 {
-    CAN67_Mb64To95Handler(CAN_ID_6);
+    CAN_MbIntHandler(CAN_ID_6, (uint32_t)CAN67_MB_INT_64TO95);
     COMMON_DSB();
 }
 
@@ -6815,7 +8653,7 @@ void CAN6_Mb64To95_DriverIRQHandler(void)
  */
 void CAN6_Mb96To127_DriverIRQHandler(void)
 {
-    CAN67_Mb96To127Handler(CAN_ID_6);
+    CAN_MbIntHandler(CAN_ID_6, (uint32_t)CAN67_MB_INT_96TO127);
     COMMON_DSB();
 }
 
@@ -6943,7 +8781,7 @@ void CAN7_Ecc_DriverIRQHandler(void)
  */
 void CAN7_Mb0To31_DriverIRQHandler(void)
 {
-    CAN67_Mb0To31Handler(CAN_ID_7);
+    CAN_MbIntHandler(CAN_ID_7, (uint32_t)CAN67_MB_INT_0TO31);
     COMMON_DSB();
 }
 
@@ -6957,7 +8795,7 @@ void CAN7_Mb0To31_DriverIRQHandler(void)
  */
 void CAN7_Mb32To63_DriverIRQHandler(void)
 {
-    CAN67_Mb32To63Handler(CAN_ID_7);
+    CAN_MbIntHandler(CAN_ID_7, (uint32_t)CAN67_MB_INT_32TO63);
     COMMON_DSB();
 }
 
@@ -6971,7 +8809,7 @@ void CAN7_Mb32To63_DriverIRQHandler(void)
  */
 void CAN7_Mb64To95_DriverIRQHandler(void)
 {
-    CAN67_Mb64To95Handler(CAN_ID_7);
+    CAN_MbIntHandler(CAN_ID_7, (uint32_t)CAN67_MB_INT_64TO95);
     COMMON_DSB();
 }
 
@@ -6985,7 +8823,7 @@ void CAN7_Mb64To95_DriverIRQHandler(void)
  */
 void CAN7_Mb96To127_DriverIRQHandler(void)
 {
-    CAN67_Mb96To127Handler(CAN_ID_7);
+    CAN_MbIntHandler(CAN_ID_7, (uint32_t)CAN67_MB_INT_96TO127);
     COMMON_DSB();
 }
 #endif
@@ -118,6 +118,13 @@ static dma_reg_w_t * const dmaRegWPtr = (dma_reg_w_t *) DMA_BASE_ADDR;
 
 #define DMA_CHANNEL_NUM             16U                                   /*!< max number of dma channels */
 
+#define DMA_CS_START_MASK           0x00000001U                           /*!< START of channel control reg mask */
+#define DMA_CS_INTE_MASK            0x00000002U                           /*!< INTE of channel control reg mask */
+#define DMA_CS_REQDIS_MASK          0x00000008U                           /*!< REQDIS of channel control reg mask */
+#define DMA_CS_DSIZE_SHIFT          16U                                   /*!< DSIZE of channel control reg shift */
+#define DMA_CS_SSIZE_SHIFT          24U                                   /*!< SSIZE of channel control reg shift */
+#define DMA_OFFSET_HIGH_SHIFT       16U                                   /*!< high half of offset regs shift */
+
 /**  
  *  @brief Calculate whether unsigned number is divided with no remainder
  */
@@ -138,6 +145,15 @@ static dma_reg_w_t * const dmaRegWPtr = (dma_reg_w_t *) DMA_BASE_ADDR;
  *  @{
  */
 
+/**
+ *  @brief DMA chain running state of a channel
+ */
+typedef struct
+{
+    DMA_ChainNode_t * volatile node;            /*!< node being transferred, NULL if idle */
+    FlagStatus_t swTrigger;                     /*!< SET: channel is started by software */
+} DMA_Chain_t;
+
 /** @} end of group DMA_Private_Type*/
 
 
@@ -223,6 +239,9 @@ static isr_cb_t * dmaIsrCb[DMA_CHANNEL_NUM][DMA_INT_ALL]=
     {NULL, NULL}
 };
 
+/*! @brief DMA chain state of each channel */
+static DMA_Chain_t dmaChain[DMA_CHANNEL_NUM];
+
 /** @} end of group DMA_Private_Variables */
 
 /** @defgroup DMA_Global_Variables
@@ -258,6 +277,129 @@ void DMA_Err_DriverIRQHandler(void);
 /** @defgroup DMA_Private_Functions
  *  @{
  */
+/****************************************************************************//**
+ * @brief      Check dma transfer configuration
+ *
+ * @param[in]  config:   Pointer to dma transfer configuration structure.
+ *
+ * @return function execution result
+ *
+ *******************************************************************************/
+static ResultStatus_t DMA_CheckTransferConfig(const DMA_TransferConfig_t * config)
+{
+    ResultStatus_t retFlag = SUCC;
+
+    if ((DMA_GET_UNSIGNED_REMAINDER(config->srcAddr, config->srcTransferSize) 
+        != 0U) || 
+        (DMA_GET_UNSIGNED_REMAINDER(config->destAddr, config->destTransferSize)
+        != 0U))
+    {
+        retFlag = ERR;
+    }
+
+    /*PRQA S 2896 ++*/
+    if ((DMA_GET_SIGNED_REMAINDER(config->minorLoopSrcOffset, config->srcTransferSize) 
+        != 0U) || 
+        (DMA_GET_SIGNED_REMAINDER(config->minorLoopDestOffset, config->destTransferSize)
+        != 0U))
+    {
+        retFlag = ERR;
+    }
+    /*PRQA S 2896 --*/
+
+    /*PRQA S 2896 ++*/
+    if ((DMA_GET_SIGNED_REMAINDER(config->majorLoopSrcOffset, config->srcTransferSize) 
+        != 0U) || 
+        (DMA_GET_SIGNED_REMAINDER(config->majorLoopDestOffset, config->destTransferSize)
+        != 0U))
+    {
+        retFlag = ERR;
+    }
+    /*PRQA S 2896 --*/
+
+    if ((DMA_GET_UNSIGNED_REMAINDER(config->transferByteNum, config->srcTransferSize) 
+        != 0U) || 
+        (DMA_GET_UNSIGNED_REMAINDER(config->transferByteNum, config->destTransferSize)
+        != 0U))
+    {
+        retFlag = ERR;
+    }
+
+    if (0U == config->transferByteNum)
+    {
+        retFlag = ERR;
+    }
+
+    return retFlag;
+}
+
+/****************************************************************************//**
+ * @brief      Load a chain node into the channel registers
+ *
+ * @param[in]  channel: dma channel id
+ * @param[in]  node:    node to load
+ *
+ * @return none
+ *
+ * @note       DMA_CS is written last since it may carry START. For a hardware
+ *             request the node's REQDIS has stopped the channel at done, so
+ *             the request is enabled again only after all registers are
+ *             written.
+ *
+ *******************************************************************************/
+static void DMA_ChainLoad(DMA_Channel_t channel, const DMA_ChainNode_t *node)
+{
+    uint32_t primask;
+
+    dmaRegWPtr->DMA_CH_CONFIG[channel].DMA_SADDR = node->saddr;
+    dmaRegWPtr->DMA_CH_CONFIG[channel].DMA_DADDR = node->daddr;
+    dmaRegWPtr->DMA_CH_CONFIG[channel].DMA_AOFF = node->aoff;
+    dmaRegWPtr->DMA_CH_CONFIG[channel].DMA_MLAOFF = node->mlaoff;
+    dmaRegWPtr->DMA_CH_CONFIG[channel].DMA_NUM = node->num;
+    dmaRegWPtr->DMA_CH_CONFIG[channel].DMA_ITER = node->iter;
+
+    if (SET == dmaChain[channel].swTrigger)
+    {
+        dmaRegWPtr->DMA_CH_CONFIG[channel].DMA_CS = node->cs | DMA_CS_START_MASK;
+    }
+    else
+    {
+        dmaRegWPtr->DMA_CH_CONFIG[channel].DMA_CS = node->cs;
+
+        primask = COMMON_GetPRIMASK();
+        COMMON_DISABLE_INTERRUPTS();
+        dmaRegWPtr->DMA_DMAE |= dmaChannelMask[channel];
+        COMMON_SetPRIMASK(primask);
+    }
+}
+
+/****************************************************************************//**
+ * @brief      Advance the chain of a channel after a node is done
+ *
+ * @param[in]  channel: dma channel id
+ *
+ * @return none
+ *
+ *******************************************************************************/
+static void DMA_ChainNext(DMA_Channel_t channel)
+{
+    DMA_ChainNode_t *done = dmaChain[channel].node;
+    DMA_ChainNode_t *next = done->next;
+
+    dmaChain[channel].node = next;
+
+    /* reload first, the callback runs while the next node is transferring */
+    if (next != NULL)
+    {
+        DMA_ChainLoad(channel, next);
+    }
+
+    if (done->callback != NULL)
+    {
+        done->callback(channel, done);
+    }
+}
+
 /****************************************************************************//**
  * @brief      Dma error interrupt handle
  *
@@ -312,7 +454,11 @@ static void DMA_DoneIntHandler(DMA_Channel_t channel)
         dmaRegWPtr->DMA_GCC = DMA_GCC_WPEN03_MASK | 
                               ((uint32_t)channel << DMA_GCC_CCIS_SHIFT) | (uint32_t)channel;
         
-        if(dmaIsrCb[channel][DMA_INT_DONE] != NULL)
+        if (dmaChain[channel].node != NULL)
+        {
+            DMA_ChainNext(channel);
+        }
+        else if(dmaIsrCb[channel][DMA_INT_DONE] != NULL)
         {
             dmaIsrCb[channel][DMA_INT_DONE]();
         }
@@ -1061,7 +1207,7 @@ void DMA_InstallCallBackFunc(DMA_Channel_t channel, DMA_Int_t intType,
  *******************************************************************************/
 ResultStatus_t DMA_ConfigTransfer(const DMA_TransferConfig_t * config)
 {
-    ResultStatus_t retFlag = SUCC;
+    ResultStatus_t retFlag;
     uint32_t regValue;
     DMA_Channel_t channel = config->channel;
     /*PRQA S 0303 ++*/
@@ -1069,46 +1215,7 @@ ResultStatus_t DMA_ConfigTransfer(const DMA_TransferConfig_t * config)
                                     + ((uint32_t)channel >> 0x2U) * 4U);
     /*PRQA S 0303 --*/
     
-    if ((DMA_GET_UNSIGNED_REMAINDER(config->srcAddr, config->srcTransferSize) 
-        != 0U) || 
-        (DMA_GET_UNSIGNED_REMAINDER(config->destAddr, config->destTransferSize)
-        != 0U))
-    {
-        retFlag = ERR;
-    }
-
-    /*PRQA S 2896 ++*/
-    if ((DMA_GET_SIGNED_REMAINDER(config->minorLoopSrcOffset, config->srcTransferSize) 
-        != 0U) || 
-        (DMA_GET_SIGNED_REMAINDER(config->minorLoopDestOffset, config->destTransferSize)
-        != 0U))
-    {
-        retFlag = ERR;
-    }
-    /*PRQA S 2896 --*/
-
-    /*PRQA S 2896 ++*/
-    if ((DMA_GET_SIGNED_REMAINDER(config->majorLoopSrcOffset, config->srcTransferSize) 
-        != 0U) || 
-        (DMA_GET_SIGNED_REMAINDER(config->majorLoopDestOffset, config->destTransferSize)
-        != 0U))
-    {
-        retFlag = ERR;
-    }
-    /*PRQA S 2896 --*/
-
-    if ((DMA_GET_UNSIGNED_REMAINDER(config->transferByteNum, config->srcTransferSize) 
-        != 0U) || 
-        (DMA_GET_UNSIGNED_REMAINDER(config->transferByteNum, config->destTransferSize)
-        != 0U))
-    {
-        retFlag = ERR;
-    }
-
-    if (0U == config->transferByteNum)
-    {
-        retFlag = ERR;
-    }
+    retFlag = DMA_CheckTransferConfig(config);
 
     if (SUCC == retFlag)
     {
@@ -1157,6 +1264,109 @@ ResultStatus_t DMA_ConfigTransfer(const DMA_TransferConfig_t * config)
     return retFlag;
 }
 
+/****************************************************************************//**
+ * @brief      Dma chain node init Function
+ *
+ * @param[out] node:     Pointer to the chain node to be initialized.
+ * @param[in]  config:   Pointer to dma transfer configuration of this node.
+ * @param[in]  callback: function called when this node is done, can be NULL.
+ *
+ * @return function execution result
+ *
+ *******************************************************************************/
+ResultStatus_t DMA_ChainNodeInit(DMA_ChainNode_t *node, 
+                                 const DMA_TransferConfig_t * config,
+                                 dma_chain_cb_t *callback)
+{
+    ResultStatus_t retFlag;
+
+    retFlag = DMA_CheckTransferConfig(config);
+
+    if (SUCC == retFlag)
+    {
+        node->saddr = config->srcAddr;
+        node->daddr = config->destAddr;
+        node->aoff = (uint32_t)(uint16_t)config->minorLoopSrcOffset | 
+                     ((uint32_t)(uint16_t)config->minorLoopDestOffset << DMA_OFFSET_HIGH_SHIFT);
+        node->mlaoff = (uint32_t)(uint16_t)config->majorLoopSrcOffset | 
+                       ((uint32_t)(uint16_t)config->majorLoopDestOffset << DMA_OFFSET_HIGH_SHIFT);
+        node->num = config->transferByteNum;
+        node->iter = (uint32_t)config->minorLoopNum;
+        /* REQDIS stops the channel at done until the next node is loaded */
+        node->cs = DMA_CS_INTE_MASK | DMA_CS_REQDIS_MASK |
+                   ((uint32_t)config->destTransferSize << DMA_CS_DSIZE_SHIFT) |
+                   ((uint32_t)config->srcTransferSize << DMA_CS_SSIZE_SHIFT);
+        node->callback = callback;
+        node->next = NULL;
+    }
+
+    return retFlag;
+}
+
+/****************************************************************************//**
+ * @brief      Dma chain start Function
+ *
+ * @param[in]  channel: dma channel id
+ * @param[in]  head:    first node of the chain
+ *
+ * @return function execution result
+ *
+ *******************************************************************************/
+ResultStatus_t DMA_ChainStart(DMA_Channel_t channel, DMA_ChainNode_t *head)
+{
+    ResultStatus_t retFlag = SUCC;
+
+    if (NULL == head)
+    {
+        retFlag = ERR;
+    }
+    else if (dmaChain[channel].node != NULL)
+    {
+        retFlag = BUSY;
+    }
+    else
+    {
+        dmaChain[channel].swTrigger = 
+            (0U == dmaMuxRegPtr->DMA_MUX_CH_CFG[channel].ENABLE) ? SET : RESET;
+        dmaChain[channel].node = head;
+        DMA_ChainLoad(channel, head);
+    }
+
+    return retFlag;
+}
+
+/****************************************************************************//**
+ * @brief      Dma chain stop Function
+ *
+ * @param[in]  channel: dma channel id
+ *
+ * @return none
+ *
+ *******************************************************************************/
+void DMA_ChainStop(DMA_Channel_t channel)
+{
+    uint32_t primask;
+
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    dmaRegWPtr->DMA_DMAE &= ~dmaChannelMask[channel];
+    dmaChain[channel].node = NULL;
+    COMMON_SetPRIMASK(primask);
+}
+
+/****************************************************************************//**
+ * @brief      Get dma chain current node Function
+ *
+ * @param[in]  channel: dma channel id
+ *
+ * @return the node being transferred, NULL if no chain is running
+ *
+ *******************************************************************************/
+DMA_ChainNode_t *DMA_ChainGetNode(DMA_Channel_t channel)
+{
+    return dmaChain[channel].node;
+}
+
 /****************************************************************************//**
  * @brief      Dma channel 0 interrupt function
  *
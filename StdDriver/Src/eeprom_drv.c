@@ -0,0 +1,903 @@
+/**************************************************************************************************/
+/**
+ * @file     eeprom_drv.c
+ * @brief    EEPROM emulation module driver file.
+ * @version  V1.0.0
+ * @date     December-2022
+ * @author   Zhixin Semiconductor
+ *
+ * @note
+ * Copyright (C) 2021-2023 Zhixin Semiconductor Ltd. All rights reserved.
+ *
+ **************************************************************************************************/
+
+#include "eeprom_drv.h"
+
+/** @addtogroup  Z20K14XM_Peripheral_Driver
+ *  @{
+ */
+
+/** @defgroup EEPROM
+ *  @brief EEPROM emulation modules
+ *
+ *  The sectors form a ring. Records are appended phrase by phrase to the
+ *  newest (head) sector. Each sector starts with a header phrase holding a
+ *  sequence number, so the sector order is rebuilt after reset and a sector
+ *  is only part of the store once its header is programmed. When less than
+ *  two erased sectors are left, the live records of the oldest sector are
+ *  copied to the head and the oldest sector is erased. A power loss at any
+ *  point leaves either duplicate copies (the newest wins) or a sector without
+ *  valid header, which is erased at next EEPROM_Init().
+ *  @{
+ */
+
+/** @defgroup EEPROM_Private_Type
+ *  @{
+ */
+
+/**
+ *  @brief EEPROM flash operation type definition
+ */
+typedef enum
+{
+    EEPROM_OP_NONE = 0U,    /*!< no operation */
+    EEPROM_OP_ERASE,        /*!< erase a sector with an invalid header */
+    EEPROM_OP_OPEN,         /*!< program the header of the next sector */
+    EEPROM_OP_COPY,         /*!< copy a live record of the oldest sector */
+    EEPROM_OP_RECLAIM,      /*!< erase the compacted oldest sector */
+    EEPROM_OP_WRITE         /*!< program the queued record */
+}EEPROM_Op_t;
+
+/**
+ *  @brief EEPROM emulation control type definition
+ */
+typedef struct
+{
+    EEPROM_Config_t cfg;            /*!< configuration */
+    uint32_t oldest;                /*!< oldest sector of the ring */
+    uint32_t head;                  /*!< sector records are appended to */
+    uint32_t headSeq;               /*!< sequence number of head sector */
+    uint32_t writeAddr;             /*!< next free phrase in head sector */
+    uint32_t erasedNum;             /*!< erased sectors after head sector */
+    uint32_t dirty;                 /*!< sector to be erased */
+    uint32_t cursor;                /*!< compaction position in oldest sector */
+    FlagStatus_t compact;           /*!< compaction is in progress */
+    FlagStatus_t opBusy;            /*!< an async flash command is running */
+    EEPROM_Op_t op;                 /*!< current flash operation */
+    uint32_t opAddr;                /*!< flash address of current operation */
+    uint8_t opBuf[16];              /*!< phrase programmed by current operation */
+    FlagStatus_t pending;           /*!< a write is queued */
+    uint16_t pendId;                /*!< id of the queued write */
+    uint8_t pendBuf[16];            /*!< record of the queued write */
+    eeprom_cb_t pendCb;             /*!< call back of the queued write */
+    ResultStatus_t writeResult;     /*!< result of the last write */
+    uint32_t failCnt;               /*!< consecutive failed flash operations */
+    FlagStatus_t failed;            /*!< stopped after EEPROM_RETRY_MAX failures */
+    FlagStatus_t initDone;          /*!< EEPROM_Init() succeeded */
+}EEPROM_Store_t;
+
+/** @} end of group EEPROM_Private_Type*/
+
+/** @defgroup EEPROM_Private_Defines
+ *  @{
+ */
+
+#define EEPROM_PHRASE_SIZE      16U
+#define EEPROM_CRC_LEN          14U
+#define EEPROM_SECTOR_MAGIC     0x4D504545U     /* "EEPM" */
+#define EEPROM_ADDR_NONE        0xFFFFFFFFU
+#define EEPROM_SECTOR_NONE      0xFFFFFFFFU
+#define EEPROM_ERASED_MIN       2U
+
+/** @} end of group EEPROM_Private_Defines */
+
+/** @defgroup EEPROM_Private_Variables
+ *  @{
+ */
+
+static EEPROM_Store_t eepStore;
+
+static const CRC_Config_t eepCrcConfig =
+{
+    0xFFFFU,                  /* seedValue */
+    0x1021U,                  /* poly: CRC-16/CCITT */
+    CRC_COMPREAD_NO_XOR,      /* complementRead */
+    CRC_MODE_16BIT,           /* dataMode */
+    CRC_READ_NO,              /* readType */
+    CRC_WRITE_NO              /* writeType */
+};
+
+static const FLASH_CmdConfig_t eepFlashWaitConfig =
+{
+    FLASH_CMD_ACT_WAIT,       /* act */
+    NULL                      /* callBack */
+};
+
+/** @} end of group EEPROM_Private_Variables */
+
+/** @defgroup EEPROM_Global_Variables
+ *  @{
+ */
+
+/** @} end of group EEPROM_Global_Variables */
+
+/** @defgroup EEPROM_Private_FunctionDeclaration
+ *  @{
+ */
+
+/** @} end of group EEPROM_Private_FunctionDeclaration */
+
+/** @defgroup EEPROM_Private_Functions
+ *  @{
+ */
+static uint32_t EEPROM_SectorAddr(uint32_t sector)
+{
+    return eepStore.cfg.baseAddr + (sector * eepStore.cfg.sectorSize);
+}
+
+static uint32_t EEPROM_NextSector(uint32_t sector)
+{
+    return (sector + 1U) % eepStore.cfg.sectorNum;
+}
+
+static void EEPROM_ReadPhrase(uint32_t addr, uint8_t buf[])
+{
+    /*PRQA S 0306 ++*/
+    const volatile uint8_t *src = (const volatile uint8_t *)addr;
+    /*PRQA S 0306 --*/
+
+    for(uint32_t i = 0U; i < EEPROM_PHRASE_SIZE; i++)
+    {
+        buf[i] = src[i];
+    }
+}
+
+static FlagStatus_t EEPROM_IsBlank(const uint8_t buf[])
+{
+    FlagStatus_t blank = SET;
+
+    for(uint32_t i = 0U; i < EEPROM_PHRASE_SIZE; i++)
+    {
+        if(0xFFU != buf[i])
+        {
+            blank = RESET;
+            break;
+        }
+    }
+
+    return blank;
+}
+
+static uint16_t EEPROM_CalcCrc(uint8_t buf[])
+{
+    CRC_Init(&eepCrcConfig);
+
+    return CRC_CalcCRC16bit(buf, EEPROM_CRC_LEN, ENABLE, 0xFFFFU);
+}
+
+static void EEPROM_SealPhrase(uint8_t buf[])
+{
+    uint16_t crc = EEPROM_CalcCrc(buf);
+
+    buf[14] = (uint8_t)(crc & 0xFFU);
+    buf[15] = (uint8_t)(crc >> 8U);
+}
+
+static FlagStatus_t EEPROM_CheckPhrase(uint8_t buf[])
+{
+    FlagStatus_t valid = RESET;
+    uint16_t crc = (uint16_t)buf[14] | (uint16_t)((uint16_t)buf[15] << 8U);
+
+    if(crc == EEPROM_CalcCrc(buf))
+    {
+        valid = SET;
+    }
+
+    return valid;
+}
+
+static uint32_t EEPROM_GetU32(const uint8_t buf[])
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8U)
+           | ((uint32_t)buf[2] << 16U) | ((uint32_t)buf[3] << 24U);
+}
+
+static void EEPROM_PutU32(uint8_t buf[], uint32_t val)
+{
+    buf[0] = (uint8_t)(val & 0xFFU);
+    buf[1] = (uint8_t)((val >> 8U) & 0xFFU);
+    buf[2] = (uint8_t)((val >> 16U) & 0xFFU);
+    buf[3] = (uint8_t)(val >> 24U);
+}
+
+static uint16_t EEPROM_RecordId(const uint8_t buf[])
+{
+    return (uint16_t)buf[0] | (uint16_t)((uint16_t)buf[1] << 8U);
+}
+
+/* read the header of a sector, return SET and its sequence if it is valid */
+static FlagStatus_t EEPROM_ReadHeader(uint32_t sector, uint32_t *seq)
+{
+    FlagStatus_t valid = RESET;
+    uint8_t buf[EEPROM_PHRASE_SIZE];
+
+    EEPROM_ReadPhrase(EEPROM_SectorAddr(sector), buf);
+    if((EEPROM_SECTOR_MAGIC == EEPROM_GetU32(buf))
+       && (SET == EEPROM_CheckPhrase(buf)))
+    {
+        *seq = EEPROM_GetU32(&buf[4]);
+        valid = SET;
+    }
+
+    return valid;
+}
+
+static void EEPROM_BuildHeader(uint32_t seq, uint8_t buf[])
+{
+    for(uint32_t i = 0U; i < EEPROM_PHRASE_SIZE; i++)
+    {
+        buf[i] = 0xFFU;
+    }
+    EEPROM_PutU32(buf, EEPROM_SECTOR_MAGIC);
+    EEPROM_PutU32(&buf[4], seq);
+    EEPROM_SealPhrase(buf);
+}
+
+/* erase a sector at init if it is not blank */
+static ResultStatus_t EEPROM_CleanSector(uint32_t sector)
+{
+    ResultStatus_t stat = SUCC;
+    uint32_t addr = EEPROM_SectorAddr(sector);
+
+    if(SUCC != FLASH_VerifySector(addr, &eepFlashWaitConfig))
+    {
+        stat = FLASH_EraseSector(addr, &eepFlashWaitConfig);
+    }
+
+    return stat;
+}
+
+/* erase all sectors and open the first one */
+static ResultStatus_t EEPROM_Format(void)
+{
+    ResultStatus_t stat = SUCC;
+
+    for(uint32_t s = 0U; (s < eepStore.cfg.sectorNum) && (SUCC == stat); s++)
+    {
+        stat = EEPROM_CleanSector(s);
+    }
+
+    if(SUCC == stat)
+    {
+        EEPROM_BuildHeader(1U, eepStore.opBuf);
+        stat = FLASH_ProgramPhrase(EEPROM_SectorAddr(0U), eepStore.opBuf,
+                                   &eepFlashWaitConfig);
+    }
+
+    eepStore.oldest = 0U;
+    eepStore.head = 0U;
+    eepStore.headSeq = 1U;
+    eepStore.writeAddr = EEPROM_SectorAddr(0U) + EEPROM_PHRASE_SIZE;
+    eepStore.erasedNum = eepStore.cfg.sectorNum - 1U;
+
+    return stat;
+}
+
+/* rebuild the RAM index from the sectors oldest .. head */
+static void EEPROM_Replay(uint32_t chainLen)
+{
+    uint8_t buf[EEPROM_PHRASE_SIZE];
+    uint32_t sector = eepStore.oldest;
+    uint32_t start = 0U;
+    uint32_t last = 0U;
+    uint32_t addr;
+    uint16_t id;
+
+    for(uint32_t n = 0U; n < chainLen; n++)
+    {
+        start = EEPROM_SectorAddr(sector);
+        last = start;
+        for(addr = start + EEPROM_PHRASE_SIZE;
+            addr < (start + eepStore.cfg.sectorSize); addr += EEPROM_PHRASE_SIZE)
+        {
+            EEPROM_ReadPhrase(addr, buf);
+            if(RESET == EEPROM_IsBlank(buf))
+            {
+                last = addr;
+                id = EEPROM_RecordId(buf);
+                if((id < eepStore.cfg.indexNum) && (SET == EEPROM_CheckPhrase(buf)))
+                {
+                    eepStore.cfg.index[id] = addr;
+                }
+            }
+        }
+        sector = EEPROM_NextSector(sector);
+    }
+
+    /* append after the last used phrase of head sector. A phrase torn while
+       being programmed may read as blank, skip it */
+    addr = last + EEPROM_PHRASE_SIZE;
+    while((addr < (start + eepStore.cfg.sectorSize))
+          && (SUCC != FLASH_VerifyPhrase(addr, &eepFlashWaitConfig)))
+    {
+        addr += EEPROM_PHRASE_SIZE;
+    }
+    eepStore.writeAddr = addr;
+}
+
+/* find the next live record in the oldest sector from cursor */
+static FlagStatus_t EEPROM_ScanLive(void)
+{
+    FlagStatus_t found = RESET;
+    uint32_t end = EEPROM_SectorAddr(eepStore.oldest) + eepStore.cfg.sectorSize;
+    uint16_t id;
+
+    while((RESET == found) && (eepStore.cursor < end))
+    {
+        EEPROM_ReadPhrase(eepStore.cursor, eepStore.opBuf);
+        id = EEPROM_RecordId(eepStore.opBuf);
+        if((id < eepStore.cfg.indexNum)
+           && (eepStore.cfg.index[id] == eepStore.cursor))
+        {
+            found = SET;
+        }
+        else
+        {
+            eepStore.cursor += EEPROM_PHRASE_SIZE;
+        }
+    }
+
+    return found;
+}
+
+/* select the next flash operation */
+static EEPROM_Op_t EEPROM_Schedule(void)
+{
+    EEPROM_Op_t op = EEPROM_OP_NONE;
+    uint32_t headEnd = EEPROM_SectorAddr(eepStore.head) + eepStore.cfg.sectorSize;
+    ResultStatus_t dropResult = SUCC;
+
+    if(SET == eepStore.failed)
+    {
+        dropResult = ERR;
+    }
+    else if(EEPROM_SECTOR_NONE != eepStore.dirty)
+    {
+        op = EEPROM_OP_ERASE;
+        eepStore.opAddr = EEPROM_SectorAddr(eepStore.dirty);
+    }
+    else if(eepStore.writeAddr >= headEnd)
+    {
+        /* the last erased sector is reserved for compaction */
+        if((eepStore.erasedNum >= EEPROM_ERASED_MIN)
+           || ((SET == eepStore.compact) && (eepStore.erasedNum > 0U)))
+        {
+            op = EEPROM_OP_OPEN;
+            eepStore.opAddr = EEPROM_SectorAddr(EEPROM_NextSector(eepStore.head));
+            EEPROM_BuildHeader(eepStore.headSeq + 1U, eepStore.opBuf);
+        }
+        else
+        {
+            dropResult = ERR;
+        }
+    }
+    else if(SET == eepStore.compact)
+    {
+        if(eepStore.oldest == eepStore.head)
+        {
+            eepStore.compact = RESET;
+        }
+        else if(SET == EEPROM_ScanLive())
+        {
+            op = EEPROM_OP_COPY;
+            eepStore.opAddr = eepStore.writeAddr;
+        }
+        else
+        {
+            op = EEPROM_OP_RECLAIM;
+            eepStore.opAddr = EEPROM_SectorAddr(eepStore.oldest);
+        }
+    }
+    else if(SET == eepStore.pending)
+    {
+        op = EEPROM_OP_WRITE;
+        eepStore.opAddr = eepStore.writeAddr;
+        for(uint32_t i = 0U; i < EEPROM_PHRASE_SIZE; i++)
+        {
+            eepStore.opBuf[i] = eepStore.pendBuf[i];
+        }
+    }
+    else
+    {
+        /* nothing to do */
+    }
+
+    /* no space can be made: the store is full or the flash keeps failing */
+    if((ERR == dropResult) && (SET == eepStore.pending))
+    {
+        eepStore.pending = RESET;
+        eepStore.writeResult = ERR;
+        if(eepStore.pendCb != NULL)
+        {
+            eepStore.pendCb(eepStore.pendId, ERR);
+        }
+    }
+
+    eepStore.op = op;
+
+    return op;
+}
+
+/* update the store after the current flash operation finished */
+static void EEPROM_OpDone(ResultStatus_t result)
+{
+    uint16_t id;
+
+    switch(eepStore.op)
+    {
+    case EEPROM_OP_ERASE:
+        if(SUCC == result)
+        {
+            eepStore.dirty = EEPROM_SECTOR_NONE;
+        }
+        break;
+
+    case EEPROM_OP_OPEN:
+        if(SUCC == result)
+        {
+            eepStore.head = EEPROM_NextSector(eepStore.head);
+            eepStore.headSeq++;
+            eepStore.erasedNum--;
+            eepStore.writeAddr = eepStore.opAddr + EEPROM_PHRASE_SIZE;
+        }
+        else
+        {
+            eepStore.dirty = EEPROM_NextSector(eepStore.head);
+        }
+        break;
+
+    case EEPROM_OP_COPY:
+        if(SUCC == result)
+        {
+            id = EEPROM_RecordId(eepStore.opBuf);
+            eepStore.cfg.index[id] = eepStore.opAddr;
+            eepStore.cursor += EEPROM_PHRASE_SIZE;
+        }
+        eepStore.writeAddr += EEPROM_PHRASE_SIZE;
+        break;
+
+    case EEPROM_OP_RECLAIM:
+        if(SUCC == result)
+        {
+            eepStore.oldest = EEPROM_NextSector(eepStore.oldest);
+            eepStore.erasedNum++;
+            eepStore.cursor = EEPROM_SectorAddr(eepStore.oldest)
+                              + EEPROM_PHRASE_SIZE;
+            if(eepStore.erasedNum >= EEPROM_ERASED_MIN)
+            {
+                eepStore.compact = RESET;
+            }
+        }
+        break;
+
+    case EEPROM_OP_WRITE:
+        if(SUCC == result)
+        {
+            eepStore.cfg.index[eepStore.pendId] = eepStore.opAddr;
+        }
+        eepStore.writeAddr += EEPROM_PHRASE_SIZE;
+        eepStore.pending = RESET;
+        eepStore.writeResult = result;
+        if(eepStore.pendCb != NULL)
+        {
+            eepStore.pendCb(eepStore.pendId, result);
+        }
+        break;
+
+    default:
+        /* do nothing */
+        break;
+    }
+
+    eepStore.op = EEPROM_OP_NONE;
+
+    /* a sector that can not be erased or opened would be retried forever */
+    if(SUCC == result)
+    {
+        eepStore.failCnt = 0U;
+    }
+    else
+    {
+        eepStore.failCnt++;
+        if(eepStore.failCnt >= EEPROM_RETRY_MAX)
+        {
+            eepStore.failed = SET;
+        }
+    }
+
+    if((RESET == eepStore.compact) && (eepStore.erasedNum < EEPROM_ERASED_MIN))
+    {
+        eepStore.compact = SET;
+        eepStore.cursor = EEPROM_SectorAddr(eepStore.oldest) + EEPROM_PHRASE_SIZE;
+    }
+}
+
+/* check the running flash operation and start the next one. If wait is
+   ENABLE, the operation is executed and finished in this call */
+static ResultStatus_t EEPROM_Process(ControlState_t wait)
+{
+    ResultStatus_t stat = SUCC;
+    ResultStatus_t opStat;
+    FLASH_AsyncStatus_t flsStat;
+
+    if(SET == eepStore.opBusy)
+    {
+        FLASH_GetAsyncStatus(&flsStat);
+        if(FLASH_ASYNC_BUSY != flsStat.state)
+        {
+            eepStore.opBusy = RESET;
+            opStat = (FLASH_ASYNC_DONE == flsStat.state) ? SUCC : ERR;
+            EEPROM_OpDone(opStat);
+            stat = opStat;
+        }
+    }
+
+    if((RESET == eepStore.opBusy)
+       && (SET == FLASH_GetStatus(FLASH_STATUS_CCIF_MASK))
+       && (EEPROM_OP_NONE != EEPROM_Schedule()))
+    {
+        if(ENABLE == wait)
+        {
+            if((EEPROM_OP_ERASE == eepStore.op) || (EEPROM_OP_RECLAIM == eepStore.op))
+            {
+                opStat = FLASH_EraseSector(eepStore.opAddr, &eepFlashWaitConfig);
+            }
+            else
+            {
+                opStat = FLASH_ProgramPhrase(eepStore.opAddr, eepStore.opBuf,
+                                             &eepFlashWaitConfig);
+            }
+            if(BUSY != opStat)
+            {
+                EEPROM_OpDone(opStat);
+                stat = opStat;
+            }
+        }
+        else
+        {
+            if((EEPROM_OP_ERASE == eepStore.op) || (EEPROM_OP_RECLAIM == eepStore.op))
+            {
+                opStat = FLASH_EraseAsync(eepStore.opAddr, NULL);
+            }
+            else
+            {
+                opStat = FLASH_ProgramAsync(eepStore.opAddr, EEPROM_PHRASE_SIZE,
+                                            eepStore.opBuf, NULL);
+            }
+            if(SUCC == opStat)
+            {
+                eepStore.opBusy = SET;
+            }
+        }
+    }
+
+    if(SET == eepStore.failed)
+    {
+        stat = ERR;
+    }
+    else if((SUCC == stat)
+            && ((SET == eepStore.opBusy) || (SET == eepStore.pending)
+                || (SET == eepStore.compact)
+                || (EEPROM_SECTOR_NONE != eepStore.dirty)))
+    {
+        stat = BUSY;
+    }
+
+    return stat;
+}
+
+/** @} end of group EEPROM_Private_Functions */
+
+/** @defgroup EEPROM_Public_Functions
+ *  @{
+ */
+
+/**
+ * @brief      Initialize the EEPROM emulation. The sector headers and records
+ *             are scanned once to rebuild the RAM index, sectors left by an
+ *             interrupted erase or sector swap are erased. If no valid sector
+ *             is found, all sectors are erased and the store is formatted.
+ *
+ * @param[in]  config: points to the configuration structure. config->index
+ *                     shall stay valid while the store is used.
+ *
+ * @note       CRC module clock shall be enabled. CRC module is configured by
+ *             this module before each record CRC calculation, other users of
+ *             CRC module shall call CRC_Init() before their own calculation.
+ *             Multi-bit ECC bus error is disabled for the emulation area so
+ *             that records torn by a power loss can be read and discarded.
+ *             The single FLASH_IgnoreBusErrorConfig() window is used for it,
+ *             a window set by the application is replaced.
+ *
+ * @return     - SUCC -- successful
+ *             - ERR -- parameter error or flash command error
+ *
+ */
+ResultStatus_t EEPROM_Init(const EEPROM_Config_t *config)
+{
+    ResultStatus_t stat = SUCC;
+    FlagStatus_t found = RESET;
+    uint32_t chainLen = 1U;
+    uint32_t seq = 0U;
+    uint32_t prevSeq = 0U;
+    uint32_t prev;
+
+    eepStore.initDone = RESET;
+
+    if((NULL == config) || (NULL == config->index)
+       || (config->sectorNum < 3U) || ((config->baseAddr % 16U) != 0U)
+       || (config->sectorSize < (2U * EEPROM_PHRASE_SIZE))
+       || ((config->sectorSize % EEPROM_PHRASE_SIZE) != 0U)
+       || ((uint32_t)config->indexNum >= ((config->sectorNum - 2U)
+               * ((config->sectorSize / EEPROM_PHRASE_SIZE) - 1U))))
+    {
+        stat = ERR;
+    }
+    else
+    {
+        eepStore.cfg = *config;
+        eepStore.dirty = EEPROM_SECTOR_NONE;
+        eepStore.compact = RESET;
+        eepStore.opBusy = RESET;
+        eepStore.op = EEPROM_OP_NONE;
+        eepStore.pending = RESET;
+        eepStore.writeResult = SUCC;
+        eepStore.failCnt = 0U;
+        eepStore.failed = RESET;
+
+        FLASH_IgnoreBusErrorConfig(config->baseAddr, config->baseAddr
+                                   + (config->sectorNum * config->sectorSize)
+                                   - EEPROM_PHRASE_SIZE);
+
+        for(uint32_t i = 0U; i < config->indexNum; i++)
+        {
+            config->index[i] = EEPROM_ADDR_NONE;
+        }
+
+        /* the newest sector is the head */
+        for(uint32_t s = 0U; s < config->sectorNum; s++)
+        {
+            if((SET == EEPROM_ReadHeader(s, &seq))
+               && ((RESET == found) || (seq > eepStore.headSeq)))
+            {
+                eepStore.head = s;
+                eepStore.headSeq = seq;
+                found = SET;
+            }
+        }
+
+        if(RESET == found)
+        {
+            stat = EEPROM_Format();
+        }
+        else
+        {
+            /* walk back while sequence numbers are consecutive */
+            eepStore.oldest = eepStore.head;
+            seq = eepStore.headSeq;
+            while(chainLen < config->sectorNum)
+            {
+                prev = (eepStore.oldest + config->sectorNum - 1U)
+                       % config->sectorNum;
+                if((RESET == EEPROM_ReadHeader(prev, &prevSeq))
+                   || ((prevSeq + 1U) != seq))
+                {
+                    break;
+                }
+                eepStore.oldest = prev;
+                seq = prevSeq;
+                chainLen++;
+            }
+
+            /* sectors outside the ring are left by an interrupted erase or
+               sector opening */
+            eepStore.erasedNum = config->sectorNum - chainLen;
+            prev = eepStore.head;
+            for(uint32_t n = 0U; (n < eepStore.erasedNum) && (SUCC == stat); n++)
+            {
+                prev = EEPROM_NextSector(prev);
+                stat = EEPROM_CleanSector(prev);
+            }
+
+            EEPROM_Replay(chainLen);
+        }
+
+        if(eepStore.erasedNum < EEPROM_ERASED_MIN)
+        {
+            eepStore.compact = SET;
+            eepStore.cursor = EEPROM_SectorAddr(eepStore.oldest)
+                              + EEPROM_PHRASE_SIZE;
+        }
+
+        if(SUCC == stat)
+        {
+            eepStore.initDone = SET;
+        }
+    }
+
+    return stat;
+}
+
+/**
+ * @brief      Read the newest data of a record. The flash address is taken
+ *             from the RAM index, flash is not scanned.
+ *
+ * @param[in]  id: record id
+ * @param[out] data: points to EEPROM_DATA_SIZE bytes where the data will be
+ *                   stored
+ *
+ * @return     - SUCC -- successful
+ *             - ERR -- invalid id or the record has never been written
+ *             - BUSY -- a flash command is executing, try again later
+ *
+ */
+ResultStatus_t EEPROM_Read(uint16_t id, uint8_t data[])
+{
+    ResultStatus_t stat = SUCC;
+    uint8_t buf[EEPROM_PHRASE_SIZE];
+    const uint8_t *src = buf;
+
+    if((RESET == eepStore.initDone) || (id >= eepStore.cfg.indexNum)
+       || (NULL == data))
+    {
+        stat = ERR;
+    }
+    else if((SET == eepStore.pending) && (id == eepStore.pendId))
+    {
+        src = eepStore.pendBuf;
+    }
+    else if(EEPROM_ADDR_NONE == eepStore.cfg.index[id])
+    {
+        stat = ERR;
+    }
+    else if(RESET == FLASH_GetStatus(FLASH_STATUS_CCIF_MASK))
+    {
+        stat = BUSY;
+    }
+    else
+    {
+        EEPROM_ReadPhrase(eepStore.cfg.index[id], buf);
+    }
+
+    if(SUCC == stat)
+    {
+        for(uint32_t i = 0U; i < EEPROM_DATA_SIZE; i++)
+        {
+            data[i] = src[i + 2U];
+        }
+    }
+
+    return stat;
+}
+
+/**
+ * @brief      Write a record and wait until it is programmed. A compaction
+ *             that is needed to get free space is also finished here.
+ *
+ * @param[in]  id: record id
+ * @param[in]  data: points to EEPROM_DATA_SIZE bytes to be written
+ *
+ * @note       if an asynchronous operation is in progress, FLASH command
+ *             complete interrupt shall be able to preempt the caller.
+ *
+ * @return     - SUCC -- successful
+ *             - ERR -- invalid parameter, flash program error or the store
+ *                      is stopped after EEPROM_RETRY_MAX flash errors in a row
+ *
+ */
+ResultStatus_t EEPROM_Write(uint16_t id, const uint8_t data[])
+{
+    ResultStatus_t stat;
+
+    /* finish the queued write first */
+    while(SET == eepStore.pending)
+    {
+        (void)EEPROM_Process(ENABLE);
+    }
+
+    stat = EEPROM_WriteAsync(id, data, NULL);
+    if(SUCC == stat)
+    {
+        while(SET == eepStore.pending)
+        {
+            (void)EEPROM_Process(ENABLE);
+        }
+        stat = eepStore.writeResult;
+    }
+
+    return stat;
+}
+
+/**
+ * @brief      Queue a record to be written by EEPROM_MainFunction(). The
+ *             data is copied, so the buffer can be reused on return. Until it
+ *             is programmed, EEPROM_Read() returns the queued data.
+ *
+ * @param[in]  id: record id
+ * @param[in]  data: points to EEPROM_DATA_SIZE bytes to be written
+ * @param[in]  callBack: called from EEPROM_MainFunction() when the record is
+ *                       programmed. It can be NULL.
+ *
+ * @return     - SUCC -- the write is queued
+ *             - ERR -- invalid parameter or the store is stopped
+ *             - BUSY -- last queued write is not finished
+ *
+ */
+ResultStatus_t EEPROM_WriteAsync(uint16_t id, const uint8_t data[],
+                                 eeprom_cb_t callBack)
+{
+    ResultStatus_t stat = SUCC;
+
+    if((RESET == eepStore.initDone) || (SET == eepStore.failed)
+       || (id >= eepStore.cfg.indexNum) || (NULL == data))
+    {
+        stat = ERR;
+    }
+    else if(SET == eepStore.pending)
+    {
+        stat = BUSY;
+    }
+    else
+    {
+        eepStore.pendBuf[0] = (uint8_t)(id & 0xFFU);
+        eepStore.pendBuf[1] = (uint8_t)(id >> 8U);
+        for(uint32_t i = 0U; i < EEPROM_DATA_SIZE; i++)
+        {
+            eepStore.pendBuf[i + 2U] = data[i];
+        }
+        EEPROM_SealPhrase(eepStore.pendBuf);
+
+        eepStore.pendId = id;
+        eepStore.pendCb = callBack;
+        eepStore.pending = SET;
+    }
+
+    return stat;
+}
+
+/**
+ * @brief      EEPROM emulation background process. It shall be called
+ *             periodically. Each call checks the flash command started by the
+ *             last call and starts at most one new flash command by
+ *             FLASH_ProgramAsync()/FLASH_EraseAsync(): queued write,
+ *             sector swap or one step of the sector compaction.
+ *
+ * @param[in]  none
+ *
+ * @note       FLASH command complete interrupt shall be enabled. This function
+ *             and the write functions shall be called from the same context.
+ *
+ * @return     - SUCC -- no more work pending
+ *             - ERR -- the flash command finished in this call failed, or
+ *                      the store is stopped after EEPROM_RETRY_MAX flash
+ *                      errors in a row. EEPROM_Init() restarts it.
+ *             - BUSY -- work is pending
+ *
+ */
+ResultStatus_t EEPROM_MainFunction(void)
+{
+    ResultStatus_t stat = ERR;
+
+    if(SET == eepStore.initDone)
+    {
+        stat = EEPROM_Process(DISABLE);
+    }
+
+    return stat;
+}
+
+/** @} end of group EEPROM_Public_Functions */
+
+/** @} end of group EEPROM */
+
+/** @} end of group Z20K14XM_Peripheral_Driver */
@@ -48,6 +48,21 @@ typedef enum
     FLASH_CMD_ERSALL = 0x40U,   /*!< Erase all flash and IFR space */
     FLASH_CMD_ERSSCR = 0x42U    /*!< Erase a flash sector */
 }FLASH_Cmd_t;
+
+/**
+ *  @brief FLASH asynchronous operation control type definition
+ */
+typedef struct
+{
+    volatile FLASH_AsyncState_t state;   /*!< operation state */
+    FLASH_Cmd_t cmd;                     /*!< command issued for each step */
+    uint32_t addr;                       /*!< start address */
+    const uint8_t *dataP;                /*!< program source buffer */
+    uint32_t totalLen;                   /*!< bytes to be programmed */
+    volatile uint32_t doneLen;           /*!< bytes already programmed */
+    uint32_t errStatus;                  /*!< FSTAT error flags on failure */
+    flash_async_cb_t callBack;           /*!< completion call back */
+}FLASH_Async_t;
 /** @} end of group FLASH_Private_Type*/
 
 /** @defgroup FLASH_Private_Defines
@@ -61,6 +76,8 @@ typedef enum
                                | FLASH_STATUS_ACCERR_MASK \
                                | FLASH_STATUS_FAIL_MASK)
 
+#define FLASH_ASYNC_ERR_MASK   (FLASH_CMD_ERR_MASK | FLASH_STATUS_PREABT_MASK)
+
 #define FLASH_INT_CCIF_MASK         0x00000080U
 #define FLASH_INT_DFDIF_MASK        0x00010000U
 #define FLASH_INT_SFDIF_MASK        0x00020000U
@@ -90,6 +107,11 @@ static const uint32_t flashInterruptMaskTable[] =
     FLASH_INT_ALL_MASK        /* FLASH_INT_ALL */
 };
 
+static FLASH_Async_t flashAsync =
+{
+    FLASH_ASYNC_IDLE, FLASH_CMD_PGMPHR, 0U, NULL, 0U, 0U, 0U, NULL
+};
+
 /** @} end of group FLASH_Private_Variables */
 
 /** @defgroup FLASH_Global_Variables
@@ -121,13 +143,24 @@ END_FUNCTION_DECLARATION_RAMSECTION
 START_FUNCTION_DECLARATION_RAMSECTION
 static ResultStatus_t FLASH_ExecuteCommandInt(FLASH_Cmd_t cmd)
 END_FUNCTION_DECLARATION_RAMSECTION
+
+START_FUNCTION_DECLARATION_RAMSECTION
+static ResultStatus_t FLASH_AsyncIssue(void)
+END_FUNCTION_DECLARATION_RAMSECTION
+
+START_FUNCTION_DECLARATION_RAMSECTION
+static FlagStatus_t FLASH_AsyncStep(void)
+END_FUNCTION_DECLARATION_RAMSECTION
 /*PRQA S 0605 --*/
 #else
 static ResultStatus_t FLASH_WaitCmdComplete(flash_cb_t callBack);
 static ResultStatus_t FLASH_WaitEraseAllComplete(flash_cb_t callBack);
 static ResultStatus_t FLASH_ExecuteCommand(FLASH_Cmd_t cmd, flash_cb_t callBack);
 static ResultStatus_t FLASH_ExecuteCommandInt(FLASH_Cmd_t cmd);
+static ResultStatus_t FLASH_AsyncIssue(void);
+static FlagStatus_t FLASH_AsyncStep(void);
 #endif
+static ResultStatus_t FLASH_AsyncClaim(void);
 
 /** @} end of group FLASH_Private_FunctionDeclaration */
 
@@ -400,6 +433,98 @@ static ResultStatus_t FLASH_ExecuteCommandInt(FLASH_Cmd_t cmd)
     return stat;
 }
 
+/* claim the flash for an asynchronous operation. The check and the state
+   change are done with interrupts disabled, so that two callers can not
+   both see the flash free */
+static ResultStatus_t FLASH_AsyncClaim(void)
+{
+    ResultStatus_t stat;
+    uint32_t primask;
+
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    if((0U == flsRegPtr->FLASH_FSTAT.CCIF) ||
+       (FLASH_ASYNC_BUSY == flashAsync.state))
+    {
+        stat = BUSY;
+    }
+    else
+    {
+        flashAsync.state = FLASH_ASYNC_BUSY;
+        stat = SUCC;
+    }
+    COMMON_SetPRIMASK(primask);
+
+    return stat;
+}
+
+/* issue the command of the current asynchronous step */
+static ResultStatus_t FLASH_AsyncIssue(void)
+{
+    /*PRQA S 0303 ++*/
+    flash_reg_w_t *pFlashRegW = (flash_reg_w_t *) FLASHC_BASE_ADDR;
+    /*PRQA S 0303 --*/
+    volatile uint8_t *fData = (volatile uint8_t *)&(pFlashRegW->FLASH_FDATA0);
+    uint32_t offset = flashAsync.doneLen;
+
+    pFlashRegW->FLASH_FADDR = flashAsync.addr + offset;
+
+    if(FLASH_CMD_PGMPHR == flashAsync.cmd)
+    {
+        for(uint8_t i = 0U; i < FLASH_PHRASE_SIZE; i++)
+        {
+            fData[i] = flashAsync.dataP[offset + i];
+        }
+    }
+
+    return FLASH_ExecuteCommandInt(flashAsync.cmd);
+}
+
+/* advance the asynchronous operation after a command completed.
+   Return SET when the operation is finished (done or error) */
+static FlagStatus_t FLASH_AsyncStep(void)
+{
+    FlagStatus_t finished = SET;
+    uint32_t fstatVal;
+    /*PRQA S 0303 ++*/
+    flash_reg_w_t *pFlashRegW = (flash_reg_w_t *) FLASHC_BASE_ADDR;
+    /*PRQA S 0303 --*/
+
+    fstatVal = pFlashRegW->FLASH_FSTAT & FLASH_ASYNC_ERR_MASK;
+    if(0U != fstatVal)
+    {
+        flashAsync.errStatus = fstatVal;
+        flashAsync.state = FLASH_ASYNC_ERR;
+    }
+    else
+    {
+        if(FLASH_CMD_PGMPHR == flashAsync.cmd)
+        {
+            flashAsync.doneLen += FLASH_PHRASE_SIZE;
+        }
+
+        if(flashAsync.doneLen < flashAsync.totalLen)
+        {
+            if(SUCC == FLASH_AsyncIssue())
+            {
+                finished = RESET;
+            }
+            else
+            {
+                flashAsync.errStatus = pFlashRegW->FLASH_FSTAT
+                                       & FLASH_ASYNC_ERR_MASK;
+                flashAsync.state = FLASH_ASYNC_ERR;
+            }
+        }
+        else
+        {
+            flashAsync.state = FLASH_ASYNC_DONE;
+        }
+    }
+
+    return finished;
+}
+
 /** @} end of group FLASH_Private_Functions */
 
 /** @defgroup FLASH_Public_Functions
@@ -1104,6 +1229,124 @@ ResultStatus_t FLASH_EraseSector(uint32_t addr, const FLASH_CmdConfig_t *config)
     return stat;
 }
 
+/**
+ * @brief      program flash memory asynchronously. The first phrase is issued
+ *             here, every following phrase is issued from the command complete
+ *             interrupt, so the CPU is free while the flash is busy.
+ *
+ * @param[in] flashAddr: start address of flash memory. It is the start address of 
+ *                   a phrase. This address should be aligned to 4 words(16 bytes)
+ * @param[in] len: length in byte to be programmed.
+ *                 This length should be aligned to 4 words(16 bytes).
+ * @param[in] dataP: points to the source buffer from which data is taken 
+ *                     for program operation. It shall stay valid until the
+ *                     operation is finished.
+ * @param[in]  callBack: called when the operation is finished. It can be NULL,
+ *                       FLASH_GetAsyncStatus() can then be used to poll.
+ *
+ * @note       FLASH command complete interrupt shall be enabled in NVIC. The
+ *             CCIF callback installed by FLASH_InstallCallBackFunc() is not
+ *             called for asynchronous operations. The code executed while the
+ *             operation is in progress must not be placed in the flash block
+ *             being programmed.
+ *
+ * @return     - SUCC -- the operation is started
+ *             - ERR -- parameter error
+ *             - BUSY -- flash is executing last command or an asynchronous
+ *                       operation is in progress.
+ *
+ */
+ResultStatus_t FLASH_ProgramAsync(uint32_t flashAddr, uint32_t len,
+                                  const uint8_t *dataP, flash_async_cb_t callBack)
+{
+    ResultStatus_t stat;
+
+    if(((flashAddr % 16U) != 0U)  || (dataP == NULL) 
+       || (len == 0U) || ((len % 16U) != 0U))
+    {
+        stat = ERR;
+    }
+    else
+    {
+        stat = FLASH_AsyncClaim();
+    }
+
+    if(SUCC == stat)
+    {
+        flashAsync.cmd = FLASH_CMD_PGMPHR;
+        flashAsync.addr = flashAddr;
+        flashAsync.dataP = dataP;
+        flashAsync.totalLen = len;
+        flashAsync.doneLen = 0U;
+        flashAsync.errStatus = 0U;
+        flashAsync.callBack = callBack;
+
+        stat = FLASH_AsyncIssue();
+        if(SUCC != stat)
+        {
+            flashAsync.state = FLASH_ASYNC_IDLE;
+        }
+    }
+
+    return stat;
+}
+
+/**
+ * @brief      Erase a flash sector asynchronously. Completion is reported
+ *             from the command complete interrupt.
+ *
+ * @param[in]  addr: sector start address
+ * @param[in]  callBack: called when the erase is finished. It can be NULL.
+ *
+ * @note       the same restrictions as FLASH_ProgramAsync() apply.
+ *
+ * @return     - SUCC -- the operation is started
+ *             - BUSY -- flash is executing last command or an asynchronous
+ *                       operation is in progress.
+ *
+ */
+ResultStatus_t FLASH_EraseAsync(uint32_t addr, flash_async_cb_t callBack)
+{
+    ResultStatus_t stat;
+
+    stat = FLASH_AsyncClaim();
+    if(SUCC == stat)
+    {
+        flashAsync.cmd = FLASH_CMD_ERSSCR;
+        flashAsync.addr = addr;
+        flashAsync.dataP = NULL;
+        flashAsync.totalLen = 0U;
+        flashAsync.doneLen = 0U;
+        flashAsync.errStatus = 0U;
+        flashAsync.callBack = callBack;
+
+        stat = FLASH_AsyncIssue();
+        if(SUCC != stat)
+        {
+            flashAsync.state = FLASH_ASYNC_IDLE;
+        }
+    }
+
+    return stat;
+}
+
+/**
+ * @brief      Get the status and progress of the last asynchronous operation
+ *
+ * @param[out] status: points to the status structure to be filled
+ *
+ * @return     none
+ *
+ */
+void FLASH_GetAsyncStatus(FLASH_AsyncStatus_t *status)
+{
+    status->state = flashAsync.state;
+    status->totalLen = flashAsync.totalLen;
+    status->doneLen = flashAsync.doneLen;
+    status->errAddr = flashAsync.addr + flashAsync.doneLen;
+    status->errStatus = flashAsync.errStatus;
+}
+
 /**
  * @brief      Flash enters security mode. In this mdoe, debug Port is prevented
  *             to read any AHB-AP memory-map addresses
@@ -1492,10 +1735,26 @@ void FLASH_CmdComplete_DriverIRQHandler(void)
        so disable this interrupt here */
     flsRegPtr->FLASH_FCNFG.CCIE = 0;
     
-    if(flashIsrCbFunc[FLASH_INT_CCIF] != NULL)
+    if(FLASH_ASYNC_BUSY == flashAsync.state)
+    {
+        /* issue the next phrase, report once the operation is finished */
+        if(SET == FLASH_AsyncStep())
+        {
+            if(flashAsync.callBack != NULL)
+            {
+                flashAsync.callBack((FLASH_ASYNC_DONE == flashAsync.state) ?
+                                    SUCC : ERR, flashAsync.errStatus);
+            }
+        }
+    }
+    else if(flashIsrCbFunc[FLASH_INT_CCIF] != NULL)
     {
         flashIsrCbFunc[FLASH_INT_CCIF]();
     }
+    else
+    {
+        /* do nothing */
+    }
     COMMON_DSB();
 }
 
@@ -26,6 +26,48 @@
  *  @{
  */
 
+/**
+ *  @brief I2C master transfer control
+ */
+typedef struct
+{
+    const uint8_t *txData;              /*!< bytes to be written */
+    uint32_t txLen;                     /*!< number of bytes to be written */
+    uint8_t *rxData;                    /*!< memory for the read bytes */
+    uint32_t rxLen;                     /*!< number of bytes to be read */
+    uint32_t cmdCount;                  /*!< commands written to the FIFO */
+    uint32_t rxCount;                   /*!< bytes read from the RX FIFO */
+    uint32_t errorStatus;               /*!< abort causes of the transfer */
+    uint32_t intEnable;                 /*!< interrupt enables to restore */
+    uint32_t fifoWaterMark;             /*!< I2C_RXFIFO_WATER_MARK to restore */
+    i2c_xfer_cb_t *callback;            /*!< transfer done callback */
+    volatile FlagStatus_t busy;         /*!< a transfer is in progress */
+    FlagStatus_t dmaActive;             /*!< the FIFOs are fed by DMA */
+    FlagStatus_t stopSeen;              /*!< STOP detected before RX DMA done */
+    FlagStatus_t rxDmaDone;             /*!< RX DMA done before STOP detected */
+    ControlState_t holdBus;             /*!< HOLD_EN_RXFIFO_FULL to restore */
+    DMA_Channel_t txChannel;            /*!< DMA channel of the command stream */
+    DMA_Channel_t rxChannel;            /*!< DMA channel of the read bytes */
+    DMA_ChainNode_t txNode;             /*!< DMA descriptor of the commands */
+    DMA_ChainNode_t rxNode;             /*!< DMA descriptor of the read bytes */
+} I2C_Xfer_t;
+
+/**
+ *  @brief I2C poll schedule control
+ */
+typedef struct
+{
+    const I2C_PollSchedule_t *schedule; /*!< running schedule, NULL if stopped */
+    uint32_t tick;                      /*!< ticks since start */
+    uint32_t cur;                       /*!< device being polled */
+    uint32_t next;                      /*!< device searched first for a poll */
+    uint32_t timeoutLeft;               /*!< ticks left for the current poll */
+    FlagStatus_t sdaRecovering;         /*!< SDA recovery is running */
+    FlagStatus_t reenabling;            /*!< module disabled for recovery */
+    uint32_t recoverCnt;                /*!< bus recoveries */
+    uint32_t overrunCnt;                /*!< polls skipped */
+} I2C_Sched_t;
+
 /** @} end of group I2C_Private_Type*/
 
 /** @defgroup I2C_Private_Defines
@@ -43,6 +85,15 @@
 #define I2C_FAST_PLUS_SPEED_SCL_LC (0x00000011U)  /*!< Fast Plus Mode I2C Clock SCL Low Count */
 #define I2C_HIGH_SPEED_SCL_HC      (0x00000004U)  /*!< High speed I2C Clock SCL High Count  */
 #define I2C_HIGH_SPEED_SCL_LC      (0x0000000AU)  /*!< High speed I2C Clock SCL Low Count  */
+#define I2C_FIFO_DEPTH             (4U)           /*!< I2C TX/RX FIFO depth */
+#define I2C_CMD_READ               (0x100UL)      /*!< I2C_COMMAND_DATA read command */
+#define I2C_CMD_STOP               (0x200UL)      /*!< I2C_COMMAND_DATA STOP after the byte */
+#define I2C_CMD_RESTART            (0x400UL)      /*!< I2C_COMMAND_DATA RESTART before the byte */
+#define I2C_ERR_STATUS_MASK        (0x0003FFFFUL) /*!< I2C_ERROR_STATUS abort source bits */
+#define I2C_XFER_INT_MASK          (0xC0000014UL) /*!< TX_EMPTY, RX_FULL, STOP_DET, ERROR_ABORT */
+#define I2C_DMA_CMD_MAX            (32767U)       /*!< commands of a DMA transfer */
+#define I2C_SCHED_IDLE             (0xFFFFFFFFUL) /*!< no device is being polled */
+#define I2C_ERR_NACK_MASK          (0x000005C0UL) /*!< address and data NACK abort sources */
 /** @} end of group I2C_Private_Defines */
 
 /** @defgroup I2C_Private_Variables
@@ -108,12 +159,36 @@ static const uint32_t I2C_IntTable[]=
 {
     0U,1U,2U,3U,4U,5U,22U,23U,24U,25U,26U,27U,30U,31U
 };
+/**
+ *  @brief I2C DMA request source tables
+ */
+static const DMA_RequestSource_t i2cDmaTxReqTable[I2C_INSTANCE_NUM] =
+{
+    DMA_REQ_I2C0_TX,
+#if (2U == I2C_INSTANCE_NUM) 
+    DMA_REQ_I2C1_TX
+#endif
+};
+
+static const DMA_RequestSource_t i2cDmaRxReqTable[I2C_INSTANCE_NUM] =
+{
+    DMA_REQ_I2C0_RX,
+#if (2U == I2C_INSTANCE_NUM) 
+    DMA_REQ_I2C1_RX
+#endif
+};
 /** @} end of group I2C_Private_Variables */
 
 /** @defgroup I2C_Global_Variables
  *  @{
  */
 
+/* master transfer control */
+static I2C_Xfer_t i2cXfer[I2C_INSTANCE_NUM];
+
+/* poll schedule control */
+static I2C_Sched_t i2cSched[I2C_INSTANCE_NUM];
+
 /** @} end of group I2C_Global_Variables */
 
 
@@ -121,6 +196,20 @@ static const uint32_t I2C_IntTable[]=
  *  @{
  */
 static void I2C_IntHandler(I2C_Id_t i2cNo);
+static void I2C_XferFifo(I2C_Id_t i2cNo);
+static FlagStatus_t I2C_XferIntHandler(I2C_Id_t i2cNo, uint32_t intStatus);
+static void I2C_XferDmaStop(I2C_Id_t i2cNo);
+static void I2C_XferFinish(I2C_Id_t i2cNo);
+static void I2C_XferDmaDone(DMA_Channel_t channel, const DMA_ChainNode_t *node);
+static ResultStatus_t I2C_WaitDisabled(I2C_Id_t i2cNo);
+static ResultStatus_t I2C_XferPrepare(I2C_Id_t i2cNo, uint32_t slaveAddr,
+                                      const uint8_t txData[], uint32_t txLen,
+                                      uint8_t rxData[], uint32_t rxLen,
+                                      i2c_xfer_cb_t * callback);
+static void I2C_XferCancel(I2C_Id_t i2cNo);
+static void I2C_SchedRecover(I2C_Id_t i2cNo, uint32_t errorStatus);
+static void I2C_SchedNext(I2C_Id_t i2cNo);
+static void I2C_SchedDone(I2C_Id_t i2cNo, uint32_t errorStatus);
 void I2C0_DriverIRQHandler(void);
 #if (I2C_INSTANCE_NUM == 2)
 void I2C1_DriverIRQHandler(void);
@@ -131,6 +220,562 @@ void I2C1_DriverIRQHandler(void);
 /** @defgroup I2C_Private_Functions
  *  @{
  */
+/**
+ * @brief      Drain the RX FIFO and top up the command FIFO
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return none
+ *
+ * Read commands in flight are limited to the RX FIFO depth so received
+ * bytes never overflow it. The RX watermark is moved so that RX_FULL comes
+ * when half of the FIFO (or all the outstanding bytes) is received.
+ */
+static void I2C_XferFifo(I2C_Id_t i2cNo)
+{
+    i2c_reg_t * I2Cx = (i2c_reg_t *)(i2cRegPtr[i2cNo]);
+    i2c_reg_w_t * I2Cxw = (i2c_reg_w_t *)(i2cRegWPtr[i2cNo]);
+    I2C_Xfer_t * xfer = &i2cXfer[i2cNo];
+    uint32_t cmdNum = xfer->txLen + xfer->rxLen;
+    uint32_t readNum;
+    uint32_t num;
+    uint32_t cmd;
+
+    num = I2Cxw->I2C_RX_FIFO_CNT;
+    while(num > 0U)
+    {
+        xfer->rxData[xfer->rxCount] = (uint8_t)I2Cxw->I2C_COMMAND_DATA;
+        xfer->rxCount++;
+        num--;
+    }
+
+    num = I2C_FIFO_DEPTH - I2Cxw->I2C_TX_FIFO_CNT;
+    while((num > 0U) && (xfer->cmdCount < cmdNum))
+    {
+        if(xfer->cmdCount < xfer->txLen)
+        {
+            cmd = xfer->txData[xfer->cmdCount];
+        }
+        else
+        {
+            readNum = xfer->cmdCount - xfer->txLen;
+            if((readNum - xfer->rxCount) >= I2C_FIFO_DEPTH)
+            {
+                break;
+            }
+            cmd = I2C_CMD_READ;
+            if((0U == readNum) && (xfer->txLen != 0U))
+            {
+                cmd |= I2C_CMD_RESTART;
+            }
+        }
+
+        if((xfer->cmdCount + 1U) == cmdNum)
+        {
+            cmd |= I2C_CMD_STOP;
+        }
+
+        I2Cxw->I2C_COMMAND_DATA = cmd;
+        xfer->cmdCount++;
+        num--;
+    }
+
+    if(xfer->cmdCount == cmdNum)
+    {
+        I2Cx->I2C_INT_ENABLE.TX_EMPTY_IE = 0U;
+    }
+
+    if(xfer->cmdCount > xfer->txLen)
+    {
+        num = (xfer->cmdCount - xfer->txLen) - xfer->rxCount;
+        if(num > (I2C_FIFO_DEPTH / 2U))
+        {
+            num = I2C_FIFO_DEPTH / 2U;
+        }
+        if(num > 0U)
+        {
+            I2Cx->I2C_RXFIFO_WATER_MARK.RXFIFO_WATER_MARK = num - 1U;
+        }
+    }
+}
+
+/**
+ * @brief      Stop the DMA feeding of a master transfer
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return none
+ *
+ */
+static void I2C_XferDmaStop(I2C_Id_t i2cNo)
+{
+    I2C_Xfer_t * xfer = &i2cXfer[i2cNo];
+
+    I2C_DmaCmd(i2cNo, DISABLE, DISABLE);
+    DMA_ChainStop(xfer->txChannel);
+    /* the RX channel is only started when there are bytes to read */
+    if(xfer->rxLen != 0U)
+    {
+        DMA_ChainStop(xfer->rxChannel);
+    }
+    I2C_HoldBusCmd(i2cNo, xfer->holdBus);
+    xfer->dmaActive = RESET;
+}
+
+/**
+ * @brief      End the master transfer and report it
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return none
+ *
+ */
+static void I2C_XferFinish(I2C_Id_t i2cNo)
+{
+    i2c_reg_t * I2Cx = (i2c_reg_t *)(i2cRegPtr[i2cNo]);
+    i2c_reg_w_t * I2Cxw = (i2c_reg_w_t *)(i2cRegWPtr[i2cNo]);
+    I2C_Xfer_t * xfer = &i2cXfer[i2cNo];
+
+    if(SET == xfer->dmaActive)
+    {
+        I2C_XferDmaStop(i2cNo);
+    }
+
+    I2Cxw->I2C_INT_ENABLE = (I2Cxw->I2C_INT_ENABLE & ~I2C_XFER_INT_MASK) |
+                            xfer->intEnable;
+    I2Cx->I2C_RXFIFO_WATER_MARK.RXFIFO_WATER_MARK = xfer->fifoWaterMark;
+    xfer->busy = RESET;
+
+    if(xfer->callback != NULL)
+    {
+        xfer->callback(i2cNo, xfer->errorStatus);
+    }
+}
+
+/**
+ * @brief      Service the master transfer in the I2C interrupt
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  intStatus: The pending and enabled interrupts.
+ *
+ * @return     - SET : the interrupts of the transfer are serviced
+ *             - RESET : no transfer is in progress
+ *
+ * The transfer ends at STOP_DET, which the master also generates after an
+ * abort, so a trailing STOP can not be taken for the next transfer. With
+ * DMA the last bytes may still be on their way to memory at STOP_DET, the
+ * later of the two events then ends the transfer.
+ */
+static FlagStatus_t I2C_XferIntHandler(I2C_Id_t i2cNo, uint32_t intStatus)
+{
+    i2c_reg_t * I2Cx = (i2c_reg_t *)(i2cRegPtr[i2cNo]);
+    i2c_reg_w_t * I2Cxw = (i2c_reg_w_t *)(i2cRegWPtr[i2cNo]);
+    I2C_Xfer_t * xfer = &i2cXfer[i2cNo];
+    volatile uint32_t dummyData;
+    FlagStatus_t ret = RESET;
+    FlagStatus_t finish = SET;
+    uint32_t primask;
+
+    if(SET == xfer->busy)
+    {
+        if((intStatus & I2C_IntEnableTable[I2C_INT_ERROR_ABORT]) != 0U)
+        {
+            /* the hardware flushes the command FIFO, stop feeding it */
+            xfer->errorStatus |= I2Cxw->I2C_ERROR_STATUS & I2C_ERR_STATUS_MASK;
+            dummyData = I2Cx->I2C_RD_CLR_ERR_STATUS.CLR_ERR;
+            xfer->cmdCount = xfer->txLen + xfer->rxLen;
+            I2Cx->I2C_INT_ENABLE.TX_EMPTY_IE = 0U;
+            if(SET == xfer->dmaActive)
+            {
+                I2C_XferDmaStop(i2cNo);
+            }
+        }
+
+        if((0U == xfer->errorStatus) && (RESET == xfer->dmaActive))
+        {
+            I2C_XferFifo(i2cNo);
+        }
+
+        if((intStatus & I2C_IntEnableTable[I2C_INT_STOP_DET]) != 0U)
+        {
+            if(SET == xfer->dmaActive)
+            {
+                primask = COMMON_GetPRIMASK();
+                COMMON_DISABLE_INTERRUPTS();
+                if((xfer->rxLen != 0U) && (RESET == xfer->rxDmaDone))
+                {
+                    xfer->stopSeen = SET;
+                    finish = RESET;
+                }
+                COMMON_SetPRIMASK(primask);
+            }
+            else if((0U == xfer->errorStatus) && (xfer->rxCount != xfer->rxLen))
+            {
+                /* STOP before all bytes are read, e.g. by another master */
+                xfer->errorStatus = 
+                    (uint32_t)1U << (uint32_t)I2C_ERR_MASTER_ABRT;
+            }
+            else
+            {
+                /* all bytes are transferred or the transfer is aborted */
+            }
+
+            if(SET == finish)
+            {
+                I2C_XferFinish(i2cNo);
+            }
+        }
+
+        ret = SET;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      RX DMA descriptor done callback of the master transfer
+ *
+ * @param[in]  channel: The DMA RX channel.
+ * @param[in]  node: The finished descriptor.
+ *
+ * @return none
+ *
+ */
+static void I2C_XferDmaDone(DMA_Channel_t channel, const DMA_ChainNode_t *node)
+{
+    FlagStatus_t finish;
+    uint32_t primask;
+    uint32_t i2cNo;
+
+    (void)channel;
+
+    for(i2cNo = 0U; i2cNo < I2C_INSTANCE_NUM; i2cNo++)
+    {
+        if((&i2cXfer[i2cNo].rxNode == node) && (SET == i2cXfer[i2cNo].busy))
+        {
+            primask = COMMON_GetPRIMASK();
+            COMMON_DISABLE_INTERRUPTS();
+            i2cXfer[i2cNo].rxDmaDone = SET;
+            finish = i2cXfer[i2cNo].stopSeen;
+            COMMON_SetPRIMASK(primask);
+
+            if(SET == finish)
+            {
+                I2C_XferFinish((I2C_Id_t)i2cNo);
+            }
+        }
+    }
+}
+
+/**
+ * @brief      Wait until the I2C module is disabled
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     - SUCC : the I2C is disabled
+ *             - ERR : the I2C is still enabled after I2C_TIMEOUT_WAIT_CNT
+ *
+ */
+static ResultStatus_t I2C_WaitDisabled(I2C_Id_t i2cNo)
+{
+    i2c_reg_t * I2Cx = (i2c_reg_t *)(i2cRegPtr[i2cNo]);
+    volatile uint32_t localCnt = 0U;
+    ResultStatus_t ret = SUCC;
+
+    while(1U == I2Cx->I2C_STATUS1.I2C_IS_ENABLE)
+    {
+        if(localCnt > I2C_TIMEOUT_WAIT_CNT)
+        {
+            ret = ERR;
+            break;
+        }
+        else
+        {
+            localCnt++;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Check the parameters and claim the I2C for a master transfer
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  slaveAddr: The slave address.
+ * @param[in]  txData: The bytes to be written.
+ * @param[in]  txLen: The number of bytes to be written.
+ * @param[out] rxData: The memory for the bytes to be read.
+ * @param[in]  rxLen: The number of bytes to be read.
+ * @param[in]  callback: Transfer done callback.
+ *
+ * @return     - SUCC : the I2C is claimed and addressed to the slave
+ *             - BUSY : a transfer is in progress
+ *             - ERR : the parameters are invalid or the I2C can not be
+ *                     disabled to change the slave address
+ *
+ */
+static ResultStatus_t I2C_XferPrepare(I2C_Id_t i2cNo, uint32_t slaveAddr,
+                                      const uint8_t txData[], uint32_t txLen,
+                                      uint8_t rxData[], uint32_t rxLen,
+                                      i2c_xfer_cb_t * callback)
+{
+    i2c_reg_t * I2Cx = (i2c_reg_t *)(i2cRegPtr[i2cNo]);
+    i2c_reg_w_t * I2Cxw = (i2c_reg_w_t *)(i2cRegWPtr[i2cNo]);
+    I2C_Xfer_t * xfer = &i2cXfer[i2cNo];
+    ResultStatus_t ret = SUCC;
+    uint32_t primask;
+
+    if((0U == (txLen + rxLen)) || ((txLen != 0U) && (NULL == txData)) ||
+       ((rxLen != 0U) && (NULL == rxData)))
+    {
+        ret = ERR;
+    }
+    else
+    {
+        primask = COMMON_GetPRIMASK();
+        COMMON_DISABLE_INTERRUPTS();
+        if(SET == xfer->busy)
+        {
+            ret = BUSY;
+        }
+        else
+        {
+            xfer->busy = SET;
+        }
+        COMMON_SetPRIMASK(primask);
+    }
+
+    if(SUCC == ret)
+    {
+        if(I2Cx->I2C_DEST_ADDR.DEST_ADDR != slaveAddr)
+        {
+            /* the target address can only be changed while disabled */
+            I2C_Disable(i2cNo);
+            if(SUCC == I2C_WaitDisabled(i2cNo))
+            {
+                I2C_SetTargetAddr(i2cNo, slaveAddr);
+            }
+            else
+            {
+                xfer->busy = RESET;
+                ret = ERR;
+            }
+            I2C_Enable(i2cNo);
+        }
+    }
+
+    if(SUCC == ret)
+    {
+        I2C_ClearErrorStatusAll(i2cNo);
+
+        xfer->txData = txData;
+        xfer->txLen = txLen;
+        xfer->rxData = rxData;
+        xfer->rxLen = rxLen;
+        xfer->cmdCount = 0U;
+        xfer->rxCount = 0U;
+        xfer->errorStatus = 0U;
+        xfer->callback = callback;
+        xfer->dmaActive = RESET;
+        xfer->stopSeen = RESET;
+        xfer->rxDmaDone = RESET;
+        xfer->intEnable = I2Cxw->I2C_INT_ENABLE & I2C_XFER_INT_MASK;
+        xfer->fifoWaterMark = I2Cx->I2C_RXFIFO_WATER_MARK.RXFIFO_WATER_MARK;
+
+        I2Cxw->I2C_STATUS0 = I2C_IntEnableTable[I2C_INT_STOP_DET] | 
+                             I2C_IntEnableTable[I2C_INT_ERROR_ABORT];
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Drop the master transfer without callback
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return none
+ *
+ */
+static void I2C_XferCancel(I2C_Id_t i2cNo)
+{
+    i2c_reg_t * I2Cx = (i2c_reg_t *)(i2cRegPtr[i2cNo]);
+    i2c_reg_w_t * I2Cxw = (i2c_reg_w_t *)(i2cRegWPtr[i2cNo]);
+    I2C_Xfer_t * xfer = &i2cXfer[i2cNo];
+    uint32_t primask;
+
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    if(SET == xfer->busy)
+    {
+        if(SET == xfer->dmaActive)
+        {
+            I2C_XferDmaStop(i2cNo);
+        }
+        I2Cxw->I2C_INT_ENABLE = (I2Cxw->I2C_INT_ENABLE & ~I2C_XFER_INT_MASK) |
+                                xfer->intEnable;
+        I2Cx->I2C_RXFIFO_WATER_MARK.RXFIFO_WATER_MARK = xfer->fifoWaterMark;
+        xfer->busy = RESET;
+    }
+    COMMON_SetPRIMASK(primask);
+}
+
+/**
+ * @brief      Recover the bus after a failed poll
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  errorStatus: The error status of the poll.
+ *
+ * @return none
+ *
+ * A NACK leaves the bus in a clean state and needs no recovery. A stuck
+ * SDA is released by the SDA recovery, which clears itself when done; any
+ * other abort or a timeout disables the module to flush its state, it is
+ * enabled again by I2C_SchedNext() once the disable has taken effect.
+ */
+static void I2C_SchedRecover(I2C_Id_t i2cNo, uint32_t errorStatus)
+{
+    I2C_Sched_t * sched = &i2cSched[i2cNo];
+
+    if((errorStatus & ((uint32_t)1U << (uint32_t)I2C_ERR_SDA_LOW_TIMEOUT)) != 0U)
+    {
+        I2C_SdaRecover(i2cNo, ENABLE);
+        sched->sdaRecovering = SET;
+        sched->recoverCnt++;
+    }
+    else if((errorStatus & ~I2C_ERR_NACK_MASK) != 0U)
+    {
+        I2C_Disable(i2cNo);
+        sched->reenabling = SET;
+        sched->recoverCnt++;
+    }
+    else
+    {
+        /* NACK only */
+    }
+}
+
+/**
+ * @brief      Start the next pending poll
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return none
+ *
+ * Devices are searched round robin from the one after the last poll, so a
+ * fast device can not starve the others.
+ */
+static void I2C_SchedNext(I2C_Id_t i2cNo)
+{
+    i2c_reg_t * I2Cx = (i2c_reg_t *)(i2cRegPtr[i2cNo]);
+    I2C_Sched_t * sched = &i2cSched[i2cNo];
+    const I2C_PollSchedule_t * schedule = sched->schedule;
+    I2C_PollDevice_t * dev;
+    ResultStatus_t ret;
+    uint32_t count;
+    uint32_t idx;
+
+    if((SET == sched->reenabling) && (0U == I2Cx->I2C_STATUS1.I2C_IS_ENABLE))
+    {
+        I2C_Enable(i2cNo);
+        sched->reenabling = RESET;
+    }
+
+    if((SET == sched->sdaRecovering) && (1U == I2Cx->I2C_CONFIG0.SDA_RECOVER_EN))
+    {
+        /* wait for the SDA recovery */
+    }
+    else if(SET == sched->reenabling)
+    {
+        /* wait for the module to be disabled */
+    }
+    else
+    {
+        sched->sdaRecovering = RESET;
+        idx = sched->next;
+
+        for(count = 0U; (count < schedule->deviceNum) &&
+                        (I2C_SCHED_IDLE == sched->cur); count++)
+        {
+            dev = &schedule->devices[idx];
+
+            if(SET == dev->pending)
+            {
+                sched->cur = idx;
+                sched->timeoutLeft = schedule->timeout;
+                ret = I2C_MasterTransferAsync(i2cNo, dev->slaveAddr,
+                                              dev->txData, dev->txLen,
+                                              dev->rxData, dev->rxLen,
+                                              I2C_SchedDone);
+                if(ret != SUCC)
+                {
+                    /* the bus is used outside the schedule or the module
+                       could not be readdressed, retry later */
+                    sched->cur = I2C_SCHED_IDLE;
+                    break;
+                }
+
+                dev->pending = RESET;
+                sched->next = ((idx + 1U) < schedule->deviceNum) ? (idx + 1U) : 0U;
+            }
+
+            idx = ((idx + 1U) < schedule->deviceNum) ? (idx + 1U) : 0U;
+        }
+    }
+}
+
+/**
+ * @brief      Poll done callback of the schedule
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  errorStatus: The error status of the poll.
+ *
+ * @return none
+ *
+ */
+static void I2C_SchedDone(I2C_Id_t i2cNo, uint32_t errorStatus)
+{
+    I2C_Sched_t * sched = &i2cSched[i2cNo];
+    const I2C_PollSchedule_t * schedule = sched->schedule;
+    I2C_PollDevice_t * dev;
+    uint32_t idx = sched->cur;
+    uint32_t latency;
+
+    sched->cur = I2C_SCHED_IDLE;
+
+    if((schedule != NULL) && (idx != I2C_SCHED_IDLE))
+    {
+        dev = &schedule->devices[idx];
+        latency = sched->tick - dev->pendTick;
+
+        dev->stats.pollCnt++;
+        if(latency < dev->stats.latencyMin)
+        {
+            dev->stats.latencyMin = latency;
+        }
+        if(latency > dev->stats.latencyMax)
+        {
+            dev->stats.latencyMax = latency;
+        }
+
+        if(errorStatus != 0U)
+        {
+            dev->stats.errorCnt++;
+            dev->stats.lastError = errorStatus;
+            I2C_SchedRecover(i2cNo, errorStatus);
+        }
+
+        if(schedule->callback != NULL)
+        {
+            schedule->callback(i2cNo, idx, errorStatus);
+        }
+
+        /* run the polls due at the same tick back-to-back */
+        I2C_SchedNext(i2cNo);
+    }
+}
+
 /**
  * @brief      I2C interrupt handle
  *
@@ -142,6 +787,7 @@ void I2C1_DriverIRQHandler(void);
 static void I2C_IntHandler(I2C_Id_t i2cNo)
 {
     uint32_t intStatus;
+    FlagStatus_t handled;
     i2c_reg_t * I2Cx = (i2c_reg_t *)(i2cRegPtr[i2cNo]);
     i2c_reg_w_t * I2Cxw = (i2c_reg_w_t *)(i2cRegWPtr[i2cNo]);
 
@@ -152,6 +798,9 @@ static void I2C_IntHandler(I2C_Id_t i2cNo)
     /* Clear the interrupt status */
     I2Cxw->I2C_STATUS0 = intStatus;
 
+    /* the master transfer keeps its interrupts enabled until it is done */
+    handled = I2C_XferIntHandler(i2cNo, intStatus);
+
     if((intStatus & I2C_IntEnableTable[I2C_INT_GEN_CALL]) != 0U)
     {
         if(i2cIsrCb[i2cNo][I2C_INT_GEN_CALL]!= NULL)
@@ -183,10 +832,14 @@ static void I2C_IntHandler(I2C_Id_t i2cNo)
             i2cIsrCb[i2cNo][I2C_INT_ERROR_ABORT]();
         }
         /* Disable the interrupt */
-        else
+        else if(RESET == handled)
         {
             I2Cx->I2C_INT_ENABLE.I2C_ERROR_ABORT_IE = 0U;
         }
+        else
+        {
+            /* used by the master transfer */
+        }
     }
     if((intStatus & I2C_IntEnableTable[I2C_INT_ACTIVITY]) != 0U)
     {
@@ -207,10 +860,14 @@ static void I2C_IntHandler(I2C_Id_t i2cNo)
             i2cIsrCb[i2cNo][I2C_INT_STOP_DET]();
         }
         /* Disable the interrupt */
-        else
+        else if(RESET == handled)
         {
             I2Cx->I2C_INT_ENABLE.I2C_STOP_DET_IE = 0U;
         }
+        else
+        {
+            /* used by the master transfer */
+        }
     }
     if((intStatus & I2C_IntEnableTable[I2C_INT_START_DET]) != 0U)
     {
@@ -303,10 +960,14 @@ static void I2C_IntHandler(I2C_Id_t i2cNo)
             i2cIsrCb[i2cNo][I2C_INT_RX_FULL]();
         }
         /* Disable the interrupt */
-        else
+        else if(RESET == handled)
         {
             I2Cx->I2C_INT_ENABLE.RX_FULL_IE = 0U;
         }
+        else
+        {
+            /* used by the master transfer */
+        }
     }
     if((intStatus & I2C_IntEnableTable[I2C_INT_TX_EMPTY]) != 0U)
     {
@@ -315,10 +976,14 @@ static void I2C_IntHandler(I2C_Id_t i2cNo)
             i2cIsrCb[i2cNo][I2C_INT_TX_EMPTY]();
         }
         /* Disable the interrupt */
-        else
+        else if(RESET == handled)
         {
             I2Cx->I2C_INT_ENABLE.TX_EMPTY_IE = 0U;
         }
+        else
+        {
+            /* used by the master transfer */
+        }
     }
     
     COMMON_DSB();
@@ -1348,6 +2013,445 @@ FlagStatus_t I2C_GetStatus(I2C_Id_t i2cNo, I2C_Status_t statusType)
     return (FlagStatus_t)bitStatus;
 }
 
+/**
+ * @brief      Start a master write-then-read transfer driven by interrupt.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  slaveAddr: The slave address.
+ * @param[in]  txData: The bytes to be written, e.g. register address and
+ *                     data.
+ * @param[in]  txLen: The number of bytes to be written, can be 0.
+ * @param[out] rxData: The memory for the bytes to be read.
+ * @param[in]  rxLen: The number of bytes to be read after a RESTART, can
+ *                    be 0.
+ * @param[in]  callback: Called in interrupt when the STOP is detected, can
+ *                       be NULL.
+ *
+ * @return     status
+ *             - SUCC : the transfer is started
+ *             - BUSY : a transfer is in progress
+ *             - ERR : both txLen and rxLen are 0
+ *
+ */
+ResultStatus_t I2C_MasterTransferAsync(I2C_Id_t i2cNo, uint32_t slaveAddr,
+                                       const uint8_t txData[], uint32_t txLen,
+                                       uint8_t rxData[], uint32_t rxLen,
+                                       i2c_xfer_cb_t * callback)
+{
+    i2c_reg_t * I2Cx = (i2c_reg_t *)(i2cRegPtr[i2cNo]);
+    i2c_reg_w_t * I2Cxw = (i2c_reg_w_t *)(i2cRegWPtr[i2cNo]);
+    I2C_Xfer_t * xfer = &i2cXfer[i2cNo];
+    ResultStatus_t ret;
+    uint32_t primask;
+
+    ret = I2C_XferPrepare(i2cNo, slaveAddr, txData, txLen, rxData, rxLen,
+                          callback);
+
+    if(SUCC == ret)
+    {
+        /* refill when half of the command FIFO is sent */
+        I2Cx->I2C_TXFIFO_WATER_MARK.TXFIFO_WATER_MARK = I2C_FIFO_DEPTH / 2U;
+
+        primask = COMMON_GetPRIMASK();
+        COMMON_DISABLE_INTERRUPTS();
+        I2C_XferFifo(i2cNo);
+        I2Cxw->I2C_INT_ENABLE |= I2C_IntEnableTable[I2C_INT_RX_FULL] | 
+                                 I2C_IntEnableTable[I2C_INT_STOP_DET] |
+                                 I2C_IntEnableTable[I2C_INT_ERROR_ABORT];
+        if(xfer->cmdCount < (txLen + rxLen))
+        {
+            I2Cxw->I2C_INT_ENABLE |= I2C_IntEnableTable[I2C_INT_TX_EMPTY];
+        }
+        COMMON_SetPRIMASK(primask);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Select the DMA channels of I2C_MasterDmaTransfer().
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  txChannel: DMA channel writing the command stream.
+ * @param[in]  rxChannel: DMA channel collecting the read bytes.
+ *
+ * @return     status
+ *             - SUCC
+ *             - BUSY : a transfer is in progress
+ *
+ */
+ResultStatus_t I2C_MasterDmaChannelConfig(I2C_Id_t i2cNo, 
+                                          DMA_Channel_t txChannel,
+                                          DMA_Channel_t rxChannel)
+{
+    ResultStatus_t ret = SUCC;
+
+    if(SET == i2cXfer[i2cNo].busy)
+    {
+        ret = BUSY;
+    }
+    else
+    {
+        i2cXfer[i2cNo].txChannel = txChannel;
+        i2cXfer[i2cNo].rxChannel = rxChannel;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Start a master write-then-read transfer moved by DMA.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  slaveAddr: The slave address.
+ * @param[in]  txData: The bytes to be written.
+ * @param[in]  txLen: The number of bytes to be written, can be 0.
+ * @param[out] rxData: The memory for the bytes to be read.
+ * @param[in]  rxLen: The number of bytes to be read after a RESTART, can
+ *                    be 0.
+ * @param[out] cmdBuf: Memory for the command stream, txLen + rxLen words.
+ * @param[in]  callback: Called in interrupt when the transfer is done, can
+ *                       be NULL.
+ *
+ * @return     status
+ *             - SUCC : the transfer is started
+ *             - BUSY : a transfer is in progress
+ *             - ERR : no data, or more than 32767 bytes in total
+ *
+ */
+ResultStatus_t I2C_MasterDmaTransfer(I2C_Id_t i2cNo, uint32_t slaveAddr,
+                                     const uint8_t txData[], uint32_t txLen,
+                                     uint8_t rxData[], uint32_t rxLen,
+                                     uint32_t cmdBuf[], 
+                                     i2c_xfer_cb_t * callback)
+{
+    i2c_reg_t * I2Cx = (i2c_reg_t *)(i2cRegPtr[i2cNo]);
+    i2c_reg_w_t * I2Cxw = (i2c_reg_w_t *)(i2cRegWPtr[i2cNo]);
+    I2C_Xfer_t * xfer = &i2cXfer[i2cNo];
+    DMA_TransferConfig_t dmaConfig;
+    I2C_DmaConfig_t dmaLevel;
+    uint32_t cmdNum = txLen + rxLen;
+    uint32_t idx;
+    ResultStatus_t ret;
+
+    if((NULL == cmdBuf) || (cmdNum > I2C_DMA_CMD_MAX))
+    {
+        ret = ERR;
+    }
+    else
+    {
+        ret = I2C_XferPrepare(i2cNo, slaveAddr, txData, txLen, rxData, rxLen,
+                              callback);
+    }
+
+    if(SUCC == ret)
+    {
+        /* the whole command stream, read commands included, up front */
+        for(idx = 0U; idx < cmdNum; idx++)
+        {
+            if(idx < txLen)
+            {
+                cmdBuf[idx] = txData[idx];
+            }
+            else
+            {
+                cmdBuf[idx] = I2C_CMD_READ;
+                if((idx == txLen) && (txLen != 0U))
+                {
+                    cmdBuf[idx] |= I2C_CMD_RESTART;
+                }
+            }
+        }
+        cmdBuf[cmdNum - 1U] |= I2C_CMD_STOP;
+
+        dmaConfig.majorLoopSrcOffset = 0;
+        dmaConfig.majorLoopDestOffset = 0;
+        dmaConfig.disableRequestAfterDoneCmd = ENABLE;
+
+        dmaConfig.channel = xfer->txChannel;
+        dmaConfig.channelPriority = DMA_GetChannelPriority(xfer->txChannel);
+        dmaConfig.channelPreempt = DMA_GetChannelPreempt(xfer->txChannel);
+        dmaConfig.source = i2cDmaTxReqTable[i2cNo];
+        /*PRQA S 0306 ++*/
+        dmaConfig.srcAddr = (uint32_t)cmdBuf;
+        dmaConfig.destAddr = (uint32_t)&I2Cxw->I2C_COMMAND_DATA;
+        /*PRQA S 0306 --*/
+        dmaConfig.minorLoopSrcOffset = 4;
+        dmaConfig.minorLoopDestOffset = 0;
+        dmaConfig.transferByteNum = 4U;
+        dmaConfig.minorLoopNum = (uint16_t)cmdNum;
+        dmaConfig.srcTransferSize = DMA_TRANSFER_SIZE_4B;
+        dmaConfig.destTransferSize = DMA_TRANSFER_SIZE_4B;
+        ret = DMA_ChainNodeInit(&xfer->txNode, &dmaConfig, NULL);
+
+        if((SUCC == ret) && (rxLen != 0U))
+        {
+            dmaConfig.channel = xfer->rxChannel;
+            dmaConfig.channelPriority = DMA_GetChannelPriority(xfer->rxChannel);
+            dmaConfig.channelPreempt = DMA_GetChannelPreempt(xfer->rxChannel);
+            dmaConfig.source = i2cDmaRxReqTable[i2cNo];
+            /*PRQA S 0306 ++*/
+            dmaConfig.srcAddr = (uint32_t)&I2Cxw->I2C_COMMAND_DATA;
+            dmaConfig.destAddr = (uint32_t)rxData;
+            /*PRQA S 0306 --*/
+            dmaConfig.minorLoopSrcOffset = 0;
+            dmaConfig.minorLoopDestOffset = 1;
+            dmaConfig.transferByteNum = 1U;
+            dmaConfig.minorLoopNum = (uint16_t)rxLen;
+            dmaConfig.srcTransferSize = DMA_TRANSFER_SIZE_1B;
+            dmaConfig.destTransferSize = DMA_TRANSFER_SIZE_1B;
+            ret = DMA_ChainNodeInit(&xfer->rxNode, &dmaConfig, I2C_XferDmaDone);
+        }
+
+        if(SUCC == ret)
+        {
+            /* a TX request per free half FIFO, a RX request per byte */
+            dmaLevel.i2cDmaTransmitReqLevel = I2C_FIFO_DEPTH / 2U;
+            dmaLevel.i2cDmaRecvReqLevel = 0U;
+            I2C_DmaConfig(i2cNo, &dmaLevel);
+            /* a late RX DMA stalls the bus instead of losing bytes,
+               restored when the DMA feeding stops */
+            xfer->holdBus = (0U == I2Cx->I2C_CONFIG1.HOLD_EN_RXFIFO_FULL) ?
+                            DISABLE : ENABLE;
+            I2C_HoldBusCmd(i2cNo, ENABLE);
+
+            xfer->dmaActive = SET;
+
+            if(rxLen != 0U)
+            {
+                DMAMUX_SelChannelSource(xfer->rxChannel, i2cDmaRxReqTable[i2cNo]);
+                DMAMUX_OutputChannelEnable(xfer->rxChannel);
+                ret = DMA_ChainStart(xfer->rxChannel, &xfer->rxNode);
+            }
+        }
+
+        if(SUCC == ret)
+        {
+            DMAMUX_SelChannelSource(xfer->txChannel, i2cDmaTxReqTable[i2cNo]);
+            DMAMUX_OutputChannelEnable(xfer->txChannel);
+            ret = DMA_ChainStart(xfer->txChannel, &xfer->txNode);
+            if((ret != SUCC) && (rxLen != 0U))
+            {
+                DMA_ChainStop(xfer->rxChannel);
+            }
+        }
+
+        if(SUCC == ret)
+        {
+            I2Cxw->I2C_INT_ENABLE |= I2C_IntEnableTable[I2C_INT_STOP_DET] |
+                                     I2C_IntEnableTable[I2C_INT_ERROR_ABORT];
+            I2C_DmaCmd(i2cNo, ENABLE, (rxLen != 0U) ? ENABLE : DISABLE);
+        }
+        else
+        {
+            if(SET == xfer->dmaActive)
+            {
+                I2C_HoldBusCmd(i2cNo, xfer->holdBus);
+            }
+            xfer->dmaActive = RESET;
+            xfer->busy = RESET;
+            ret = ERR;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Get the status of I2C_MasterTransferAsync().
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     - SET : the transfer is in progress
+ *             - RESET : no transfer is in progress
+ *
+ */
+FlagStatus_t I2C_MasterGetTransferStatus(I2C_Id_t i2cNo)
+{
+    return i2cXfer[i2cNo].busy;
+}
+
+/**
+ * @brief      Start the periodic poll schedule of an I2C master.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ * @param[in]  schedule: The poll schedule, it shall be kept until stopped.
+ *
+ * @return     status
+ *             - SUCC : the schedule is started
+ *             - ERR : invalid device, a schedule or a transfer is running
+ *
+ */
+ResultStatus_t I2C_PollScheduleStart(I2C_Id_t i2cNo,
+                                     const I2C_PollSchedule_t * schedule)
+{
+    I2C_Sched_t * sched = &i2cSched[i2cNo];
+    I2C_PollDevice_t * dev;
+    ResultStatus_t ret = SUCC;
+    uint32_t idx;
+
+    if((NULL == schedule->devices) || (0U == schedule->deviceNum) ||
+       (sched->schedule != NULL) || (SET == i2cXfer[i2cNo].busy))
+    {
+        ret = ERR;
+    }
+
+    for(idx = 0U; (idx < schedule->deviceNum) && (SUCC == ret); idx++)
+    {
+        dev = &schedule->devices[idx];
+        if((0U == dev->period) || (0U == (dev->txLen + dev->rxLen)) ||
+           ((dev->txLen != 0U) && (NULL == dev->txData)) ||
+           ((dev->rxLen != 0U) && (NULL == dev->rxData)))
+        {
+            ret = ERR;
+        }
+    }
+
+    if(SUCC == ret)
+    {
+        for(idx = 0U; idx < schedule->deviceNum; idx++)
+        {
+            dev = &schedule->devices[idx];
+            dev->dueTick = dev->phase + 1U;
+            dev->pending = RESET;
+            dev->stats.pollCnt = 0U;
+            dev->stats.errorCnt = 0U;
+            dev->stats.lastError = 0U;
+            dev->stats.latencyMin = 0xFFFFFFFFU;
+            dev->stats.latencyMax = 0U;
+        }
+
+        sched->tick = 0U;
+        sched->cur = I2C_SCHED_IDLE;
+        sched->next = 0U;
+        sched->sdaRecovering = RESET;
+        sched->reenabling = RESET;
+        sched->recoverCnt = 0U;
+        sched->overrunCnt = 0U;
+
+        /* detect SCL/SDA stuck at low */
+        I2C_MstBusRecover(i2cNo, ENABLE);
+        sched->schedule = schedule;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Stop the poll schedule, a running poll is finished.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     none
+ *
+ */
+void I2C_PollScheduleStop(I2C_Id_t i2cNo)
+{
+    I2C_Sched_t * sched = &i2cSched[i2cNo];
+    uint32_t primask;
+
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    sched->schedule = NULL;
+    COMMON_SetPRIMASK(primask);
+
+    I2C_MstBusRecover(i2cNo, DISABLE);
+    if(SET == sched->sdaRecovering)
+    {
+        I2C_SdaRecover(i2cNo, DISABLE);
+        sched->sdaRecovering = RESET;
+    }
+    if(SET == sched->reenabling)
+    {
+        (void)I2C_WaitDisabled(i2cNo);
+        I2C_Enable(i2cNo);
+        sched->reenabling = RESET;
+    }
+}
+
+/**
+ * @brief      Advance the poll schedule by one tick.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     none
+ *
+ */
+void I2C_PollScheduleTick(I2C_Id_t i2cNo)
+{
+    I2C_Sched_t * sched = &i2cSched[i2cNo];
+    const I2C_PollSchedule_t * schedule = sched->schedule;
+    I2C_PollDevice_t * dev;
+    uint32_t idx;
+
+    if(schedule != NULL)
+    {
+        sched->tick++;
+
+        if((sched->cur != I2C_SCHED_IDLE) && (schedule->timeout != 0U))
+        {
+            sched->timeoutLeft--;
+            if(0U == sched->timeoutLeft)
+            {
+                /* no STOP in time, e.g. SCL held low by a slave */
+                I2C_XferCancel(i2cNo);
+                I2C_SchedDone(i2cNo, I2C_POLL_ERR_TIMEOUT);
+            }
+        }
+
+        for(idx = 0U; idx < schedule->deviceNum; idx++)
+        {
+            dev = &schedule->devices[idx];
+
+            if((int32_t)(sched->tick - dev->dueTick) >= 0)
+            {
+                if(SET == dev->pending)
+                {
+                    sched->overrunCnt++;
+                }
+                else
+                {
+                    dev->pending = SET;
+                    dev->pendTick = dev->dueTick;
+                }
+                dev->dueTick += dev->period;
+            }
+        }
+
+        if(I2C_SCHED_IDLE == sched->cur)
+        {
+            I2C_SchedNext(i2cNo);
+        }
+    }
+}
+
+/**
+ * @brief      Get the number of bus recoveries run by the poll schedule.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     The number of recoveries.
+ *
+ */
+uint32_t I2C_PollGetRecoverCount(I2C_Id_t i2cNo)
+{
+    return i2cSched[i2cNo].recoverCnt;
+}
+
+/**
+ * @brief      Get the number of polls skipped as the previous one of the
+ *             same device was still waiting for the bus.
+ *
+ * @param[in]  i2cNo: Select the I2C port, should be I2C0_ID, I2C1_ID.
+ *
+ * @return     The number of skipped polls.
+ *
+ */
+uint32_t I2C_PollGetOverrunCount(I2C_Id_t i2cNo)
+{
+    return i2cSched[i2cNo].overrunCnt;
+}
+
 /** @} end of group I2C_Public_Functions */
 
 /** @} end of group I2C_definitions */
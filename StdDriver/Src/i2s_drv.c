@@ -25,11 +25,32 @@
  *  @{
  */
 
+/**
+ *  @brief I2S stream control
+ */
+typedef struct
+{
+    uint32_t *buffer[2];                    /*!< ping-pong buffers */
+    uint32_t bufLen;                        /*!< samples in each buffer */
+    uint32_t index;                         /*!< next sample of the current buffer */
+    uint32_t curBuf;                        /*!< current buffer */
+    I2S_StreamDir_t dir;                    /*!< stream direction */
+    I2S_TransferMode_t mode;                /*!< data register used */
+    i2s_stream_cb_t *halfCallback;          /*!< buffer[0] done callback */
+    i2s_stream_cb_t *fullCallback;          /*!< buffer[1] done callback */
+    FlagStatus_t active;                    /*!< stream is running */
+    FlagStatus_t dmaActive;                 /*!< stream is moved by DMA */
+    DMA_Channel_t dmaChannel;               /*!< DMA channel */
+    DMA_ChainNode_t node[2];                /*!< DMA nodes of the buffers */
+} I2S_Stream_t;
+
 /** @} end of group I2S_Private_Type*/
 
 /** @defgroup I2S_Private_Defines
  *  @{
  */
+#define I2S_FIFO_DEPTH              (16U)          /*!< FIFO entries of a channel */
+#define I2S_DMA_SAMPLE_MAX          (32767U)       /*!< samples of a DMA node */
 
 /** @} end of group I2S_Private_Defines */
 
@@ -116,6 +137,22 @@ static isr_cb_t * i2sIsrCbFunc[I2S_NUM][I2S_CHANNEL_NUM][I2S_INT_ALL] =
 #endif  
 };
 
+/**
+ *  @brief I2S stream control array
+ */
+static I2S_Stream_t i2sStream[I2S_NUM][I2S_CHANNEL_NUM];
+
+/**
+ *  @brief I2S DMA request array
+ */
+static const DMA_RequestSource_t i2sDmaReqTable[I2S_NUM] =
+{
+    DMA_REQ_I2S0
+#if (defined(DEV_Z20K148M))
+    ,DMA_REQ_I2S1
+#endif
+};
+
 /** @defgroup I2S_Private_FunctionDeclaration
  *  @{
  */
@@ -125,92 +162,298 @@ void I2S0_DriverIRQHandler(void);
 void I2S1_DriverIRQHandler(void);
 #endif
 
+static void I2S_StreamAdvance(I2S_Id_t i2sId, I2S_ChannelId_t channelId);
+static FlagStatus_t I2S_StreamRxHandler(I2S_Id_t i2sId, I2S_ChannelId_t channelId);
+static FlagStatus_t I2S_StreamTxHandler(I2S_Id_t i2sId, I2S_ChannelId_t channelId);
+static void I2S_StreamDmaDone(DMA_Channel_t channel, const DMA_ChainNode_t *node);
+static uint32_t I2S_StreamDataAddr(I2S_Id_t i2sId, I2S_ChannelId_t channelId,
+                                   I2S_StreamDir_t dir, I2S_TransferMode_t mode);
+
 /** @} end of group I2S_Private_FunctionDeclaration */
 
 /**
- * @brief      I2S interrupt handle
+ * @brief      Move the stream to the next sample
  *
- * @param[in]  i2sId:           Select the I2S ID:
- *                                  -I2S_ID_0
- *                                  -I2S_ID_1
+ * @param[in]  i2sId:           Select the I2S ID
+ * @param[in]  channelId:       Select the I2S Channel ID
  *
  * @return none
  *
  */
-void I2S_IntHandler(I2S_Id_t i2sId)
+static void I2S_StreamAdvance(I2S_Id_t i2sId, I2S_ChannelId_t channelId)
 {
-    uint32_t intStatus;
-    i2s_reg_t * I2Sx = (i2s_reg_t *)(i2sRegPtr[i2sId]);
-    i2s_reg_w_t * I2Sxw = (i2s_reg_w_t *)(i2sRegWPtr[i2sId]);
+    I2S_Stream_t * stream = &i2sStream[i2sId][channelId];
+    i2s_stream_cb_t * cbFun;
 
-    uint8_t channelPollNo;
+    stream->index++;
+    if(stream->index >= stream->bufLen)
+    {
+        cbFun = (0U == stream->curBuf) ? stream->halfCallback : stream->fullCallback;
+        stream->index = 0U;
+        stream->curBuf ^= 1U;
 
-    for(channelPollNo = 0; channelPollNo < I2S_CHANNEL_NUM; channelPollNo++)
+        if(cbFun != NULL)
+        {
+            cbFun(i2sId, channelId);
+        }
+    }
+}
+
+/**
+ * @brief      Stream receive handler, drains the samples of the RxFIFO
+ *             full trigger level
+ *
+ * @param[in]  i2sId:           Select the I2S ID
+ * @param[in]  channelId:       Select the I2S Channel ID
+ *
+ * @return     SET if the interrupt is serviced by a stream
+ *
+ */
+static FlagStatus_t I2S_StreamRxHandler(I2S_Id_t i2sId, I2S_ChannelId_t channelId)
+{
+    i2s_reg_t * I2Sx = (i2s_reg_t *)(i2sRegPtr[i2sId]);
+    I2S_Stream_t * stream = &i2sStream[i2sId][channelId];
+    FlagStatus_t handled = RESET;
+    uint32_t num;
+
+    if((SET == stream->active) && (RESET == stream->dmaActive) &&
+       (I2S_STREAM_RX == stream->dir))
     {
-        intStatus = I2S_GetAllStatus(i2sId,(I2S_ChannelId_t)channelPollNo);
-        /* only check enabled interrupts */
-        intStatus = intStatus & i2sIntMaskStatus[i2sId][channelPollNo];
-        /* clear interrupt status */
-        I2Sxw->I2S_CHANNEL_REG[channelPollNo].I2S_CHANNEL_INT_CFG = intStatus;
-
-        /* RxFIFO Full Trigger Level Reaches Interrupt */
-        if((intStatus & I2S_IntMaskTable[I2S_RXFIFO_DATA_AVAILIABLE_INT]) != 0U)
+        num = I2Sx->I2S_CHANNEL_REG[channelId].I2S_CHANNEL_TRIGGER_LEVEL_CFG.RXFIFO_FULL_TRIG_LEV + 1U;
+
+        /* a callback may stop the stream */
+        while((num > 0U) && (SET == stream->active))
         {
-            if(i2sIsrCbFunc[i2sId][channelPollNo][I2S_RXFIFO_DATA_AVAILIABLE_INT] != NULL)
-            {
-                /* call the callback function */
-                i2sIsrCbFunc[i2sId][channelPollNo][I2S_RXFIFO_DATA_AVAILIABLE_INT]();
-            }
-            /* Disable the interrupt if callback function is not setup */
-            else
-            {
-                I2Sx->I2S_CHANNEL_REG[channelPollNo].I2S_CHANNEL_INT_CFG.RXFIFO_AVAILABLE_IE = 0U;
-            }
+            stream->buffer[stream->curBuf][stream->index] =
+                I2S_ReceiveData(i2sId, channelId, stream->mode);
+            I2S_StreamAdvance(i2sId, channelId);
+            num--;
+        }
+        handled = SET;
+    }
+
+    return handled;
+}
+
+/**
+ * @brief      Stream transmit handler, fills the TxFIFO space above the
+ *             empty trigger level
+ *
+ * @param[in]  i2sId:           Select the I2S ID
+ * @param[in]  channelId:       Select the I2S Channel ID
+ *
+ * @return     SET if the interrupt is serviced by a stream
+ *
+ */
+static FlagStatus_t I2S_StreamTxHandler(I2S_Id_t i2sId, I2S_ChannelId_t channelId)
+{
+    i2s_reg_t * I2Sx = (i2s_reg_t *)(i2sRegPtr[i2sId]);
+    I2S_Stream_t * stream = &i2sStream[i2sId][channelId];
+    FlagStatus_t handled = RESET;
+    uint32_t num;
 
+    if((SET == stream->active) && (RESET == stream->dmaActive) &&
+       (I2S_STREAM_TX == stream->dir))
+    {
+        num = I2S_FIFO_DEPTH -
+              I2Sx->I2S_CHANNEL_REG[channelId].I2S_CHANNEL_TRIGGER_LEVEL_CFG.TXFIFO_EMPTY_TRIG_LEV;
+
+        /* a callback may stop the stream */
+        while((num > 0U) && (SET == stream->active))
+        {
+            I2S_TransmitData(i2sId, channelId, stream->mode,
+                             stream->buffer[stream->curBuf][stream->index]);
+            I2S_StreamAdvance(i2sId, channelId);
+            num--;
         }
+        handled = SET;
+    }
+
+    return handled;
+}
+
+/**
+ * @brief      Stream DMA node done callback
+ *
+ * @param[in]  channel:         DMA channel
+ * @param[in]  node:            The node done
+ *
+ * @return none
+ *
+ */
+static void I2S_StreamDmaDone(DMA_Channel_t channel, const DMA_ChainNode_t *node)
+{
+    I2S_Stream_t * stream;
+    i2s_stream_cb_t * cbFun = NULL;
+    I2S_Id_t streamId = I2S_ID_0;
+    I2S_ChannelId_t streamChannel = I2S_CHANNEL0_ID;
+    uint32_t i2sId;
+    uint32_t channelId;
 
-        /* RxFIFO Overrun Interrupt */
-        if((intStatus & I2S_IntMaskTable[I2S_RXFIFO_OVERRUN_INT]) != 0U)
+    (void)channel;
+
+    for(i2sId = 0U; i2sId < I2S_NUM; i2sId++)
+    {
+        for(channelId = 0U; channelId < I2S_CHANNEL_NUM; channelId++)
         {
-            if(i2sIsrCbFunc[i2sId][channelPollNo][I2S_RXFIFO_OVERRUN_INT] != NULL)
+            stream = &i2sStream[i2sId][channelId];
+            if((&stream->node[0] == node) || (&stream->node[1] == node))
             {
-                /* call the callback function */
-                i2sIsrCbFunc[i2sId][channelPollNo][I2S_RXFIFO_OVERRUN_INT]();
+                cbFun = (&stream->node[0] == node) ? stream->halfCallback :
+                                                     stream->fullCallback;
+                streamId = (I2S_Id_t)i2sId;
+                streamChannel = (I2S_ChannelId_t)channelId;
             }
-            /* Disable the interrupt if callback function is not setup */
             else
             {
-                I2Sx->I2S_CHANNEL_REG[channelPollNo].I2S_CHANNEL_INT_CFG.RXFIFO_OVERUN_IE = 0U;
+                /* not this stream */
             }
         }
+    }
+
+    if(cbFun != NULL)
+    {
+        cbFun(streamId, streamChannel);
+    }
+}
+
+/**
+ * @brief      Get the data register address used by a stream
+ *
+ * @param[in]  i2sId:           Select the I2S ID
+ * @param[in]  channelId:       Select the I2S Channel ID
+ * @param[in]  dir:             Stream direction
+ * @param[in]  mode:            Transfer mode
+ *
+ * @return     Register address
+ *
+ */
+static uint32_t I2S_StreamDataAddr(I2S_Id_t i2sId, I2S_ChannelId_t channelId,
+                                   I2S_StreamDir_t dir, I2S_TransferMode_t mode)
+{
+    i2s_reg_w_t * I2Sxw = (i2s_reg_w_t *)(i2sRegWPtr[i2sId]);
+    uint32_t addr;
+
+    /*PRQA S 0306 ++*/
+    if(I2S_CYCLIC_MODE == mode)
+    {
+        addr = (I2S_STREAM_RX == dir) ? (uint32_t)&I2Sxw->I2S_CYCLE_RX_DATA :
+                                        (uint32_t)&I2Sxw->I2S_CYCLE_TX_DATA;
+    }
+    else if(I2S_LEFT_CHANNEL_MODE == mode)
+    {
+        addr = (uint32_t)&I2Sxw->I2S_CHANNEL_REG[channelId].I2S_CHANNEL_LEFT_DATA;
+    }
+    else
+    {
+        addr = (uint32_t)&I2Sxw->I2S_CHANNEL_REG[channelId].I2S_CHANNEL_RIGHT_DATA;
+    }
+    /*PRQA S 0306 --*/
+
+    return addr;
+}
+
+/**
+ * @brief      I2S interrupt handle
+ *
+ * @param[in]  i2sId:           Select the I2S ID:
+ *                                  -I2S_ID_0
+ *                                  -I2S_ID_1
+ *
+ * @return none
+ *
+ */
+void I2S_IntHandler(I2S_Id_t i2sId)
+{
+    uint32_t intStatus;
+    i2s_reg_t * I2Sx = (i2s_reg_t *)(i2sRegPtr[i2sId]);
+    i2s_reg_w_t * I2Sxw = (i2s_reg_w_t *)(i2sRegWPtr[i2sId]);
+
+    uint8_t channelPollNo;
+    FlagStatus_t handled;
 
-        /* TxFIFO Empty Interrupt */
-        if((intStatus & I2S_IntMaskTable[I2S_TXFIFO_EMPTY_INT]) != 0U)
+    for(channelPollNo = 0; channelPollNo < I2S_CHANNEL_NUM; channelPollNo++)
+    {
+        /* skip the channels without enabled interrupts */
+        if(i2sIntMaskStatus[i2sId][channelPollNo] != 0U)
         {
-            if(i2sIsrCbFunc[i2sId][channelPollNo][I2S_TXFIFO_EMPTY_INT] != NULL)
+            intStatus = I2S_GetAllStatus(i2sId,(I2S_ChannelId_t)channelPollNo);
+            /* only check enabled interrupts */
+            intStatus = intStatus & i2sIntMaskStatus[i2sId][channelPollNo];
+            /* clear interrupt status */
+            I2Sxw->I2S_CHANNEL_REG[channelPollNo].I2S_CHANNEL_INT_CFG = intStatus;
+
+            /* RxFIFO Full Trigger Level Reaches Interrupt */
+            if((intStatus & I2S_IntMaskTable[I2S_RXFIFO_DATA_AVAILIABLE_INT]) != 0U)
             {
-                /* call the callback function */
-                i2sIsrCbFunc[i2sId][channelPollNo][I2S_TXFIFO_EMPTY_INT]();
+                handled = I2S_StreamRxHandler(i2sId, (I2S_ChannelId_t)channelPollNo);
+
+                if(i2sIsrCbFunc[i2sId][channelPollNo][I2S_RXFIFO_DATA_AVAILIABLE_INT] != NULL)
+                {
+                    /* call the callback function */
+                    i2sIsrCbFunc[i2sId][channelPollNo][I2S_RXFIFO_DATA_AVAILIABLE_INT]();
+                }
+                /* Disable the interrupt if neither callback function nor stream is setup */
+                else if(RESET == handled)
+                {
+                    I2Sx->I2S_CHANNEL_REG[channelPollNo].I2S_CHANNEL_INT_CFG.RXFIFO_AVAILABLE_IE = 0U;
+                }
+                else
+                {
+                    /* serviced by the stream */
+                }
+
             }
-            /* Disable the interrupt if callback function is not setup */
-            else
+
+            /* RxFIFO Overrun Interrupt */
+            if((intStatus & I2S_IntMaskTable[I2S_RXFIFO_OVERRUN_INT]) != 0U)
             {
-                I2Sx->I2S_CHANNEL_REG[channelPollNo].I2S_CHANNEL_INT_CFG.TXFIFO_EMPTY_IE = 0U;
+                if(i2sIsrCbFunc[i2sId][channelPollNo][I2S_RXFIFO_OVERRUN_INT] != NULL)
+                {
+                    /* call the callback function */
+                    i2sIsrCbFunc[i2sId][channelPollNo][I2S_RXFIFO_OVERRUN_INT]();
+                }
+                /* Disable the interrupt if callback function is not setup */
+                else
+                {
+                    I2Sx->I2S_CHANNEL_REG[channelPollNo].I2S_CHANNEL_INT_CFG.RXFIFO_OVERUN_IE = 0U;
+                }
             }
-        }
 
-        /* TxFIFO Overrun Interrupt */
-        if((intStatus & I2S_IntMaskTable[I2S_TXFIFO_OVERRUN_INT]) != 0U)
-        {
-            if(i2sIsrCbFunc[i2sId][channelPollNo][I2S_TXFIFO_OVERRUN_INT] != NULL)
+            /* TxFIFO Empty Interrupt */
+            if((intStatus & I2S_IntMaskTable[I2S_TXFIFO_EMPTY_INT]) != 0U)
             {
-                /* call the callback function */
-                i2sIsrCbFunc[i2sId][channelPollNo][I2S_TXFIFO_OVERRUN_INT]();
+                handled = I2S_StreamTxHandler(i2sId, (I2S_ChannelId_t)channelPollNo);
+
+                if(i2sIsrCbFunc[i2sId][channelPollNo][I2S_TXFIFO_EMPTY_INT] != NULL)
+                {
+                    /* call the callback function */
+                    i2sIsrCbFunc[i2sId][channelPollNo][I2S_TXFIFO_EMPTY_INT]();
+                }
+                /* Disable the interrupt if neither callback function nor stream is setup */
+                else if(RESET == handled)
+                {
+                    I2Sx->I2S_CHANNEL_REG[channelPollNo].I2S_CHANNEL_INT_CFG.TXFIFO_EMPTY_IE = 0U;
+                }
+                else
+                {
+                    /* serviced by the stream */
+                }
             }
-            /* Disable the interrupt if callback function is not setup */
-            else
+
+            /* TxFIFO Overrun Interrupt */
+            if((intStatus & I2S_IntMaskTable[I2S_TXFIFO_OVERRUN_INT]) != 0U)
             {
-                I2Sx->I2S_CHANNEL_REG[channelPollNo].I2S_CHANNEL_INT_CFG.TXFIFO_OVERUN_IE = 0U;
+                if(i2sIsrCbFunc[i2sId][channelPollNo][I2S_TXFIFO_OVERRUN_INT] != NULL)
+                {
+                    /* call the callback function */
+                    i2sIsrCbFunc[i2sId][channelPollNo][I2S_TXFIFO_OVERRUN_INT]();
+                }
+                /* Disable the interrupt if callback function is not setup */
+                else
+                {
+                    I2Sx->I2S_CHANNEL_REG[channelPollNo].I2S_CHANNEL_INT_CFG.TXFIFO_OVERUN_IE = 0U;
+                }
             }
         }
     }
@@ -1149,6 +1392,185 @@ uint32_t I2S_ReceiveData(I2S_Id_t i2sId, I2S_ChannelId_t channelId,
     }
     return data;
 }
+
+/**
+ * @brief      Start a double-buffered stream on an I2S channel.
+ *
+ * @param[in]  i2sId:               Select the I2S ID:
+ *                                      -I2S_ID_0
+ *                                      -I2S_ID_1
+ *
+ * @param[in]  channelId:           Select the I2S Channel ID:
+ *                                      -Channel0_ID
+ *                                      -Channel1_ID
+ *                                      -Channel2_ID
+ *                                      -Channel3_ID
+ *
+ * @param[in]  config:              Stream configuration.
+ *
+ * @return function execution result
+ *             - SUCC : the stream is started
+ *             - ERR : invalid configuration, the channel is streaming, or
+ *                     DMA is requested and the I2S DMA request is in use
+ *
+ */
+ResultStatus_t I2S_StreamStart(I2S_Id_t i2sId, I2S_ChannelId_t channelId,
+                               const I2S_StreamConfig_t *config)
+{
+    I2S_Stream_t * stream = &i2sStream[i2sId][channelId];
+    DMA_TransferConfig_t dmaConfig;
+    ResultStatus_t res = SUCC;
+    uint32_t dataAddr;
+    uint32_t bufNo;
+    uint8_t channelPollNo;
+
+    if((NULL == config->buffer[0]) || (NULL == config->buffer[1]) ||
+       (0U == config->bufLen) || (SET == stream->active))
+    {
+        res = ERR;
+    }
+    else if(ENABLE == config->dmaEnable)
+    {
+        if(config->bufLen > I2S_DMA_SAMPLE_MAX)
+        {
+            res = ERR;
+        }
+
+        /* one DMA request per I2S */
+        for(channelPollNo = 0U; channelPollNo < I2S_CHANNEL_NUM; channelPollNo++)
+        {
+            if(SET == i2sStream[i2sId][channelPollNo].dmaActive)
+            {
+                res = ERR;
+            }
+        }
+    }
+    else
+    {
+        /* streamed by FIFO interrupts */
+    }
+
+    if(SUCC == res)
+    {
+        stream->buffer[0] = config->buffer[0];
+        stream->buffer[1] = config->buffer[1];
+        stream->bufLen = config->bufLen;
+        stream->index = 0U;
+        stream->curBuf = 0U;
+        stream->dir = config->dir;
+        stream->mode = config->mode;
+        stream->halfCallback = config->halfCallback;
+        stream->fullCallback = config->fullCallback;
+        stream->dmaChannel = config->dmaChannel;
+        stream->dmaActive = RESET;
+
+        if(ENABLE == config->dmaEnable)
+        {
+            dataAddr = I2S_StreamDataAddr(i2sId, channelId, config->dir, config->mode);
+
+            dmaConfig.channel = config->dmaChannel;
+            dmaConfig.channelPriority = DMA_GetChannelPriority(config->dmaChannel);
+            dmaConfig.channelPreempt = DMA_GetChannelPreempt(config->dmaChannel);
+            dmaConfig.source = i2sDmaReqTable[i2sId];
+            dmaConfig.majorLoopSrcOffset = 0;
+            dmaConfig.majorLoopDestOffset = 0;
+            dmaConfig.transferByteNum = 4U;
+            dmaConfig.minorLoopNum = (uint16_t)config->bufLen;
+            dmaConfig.srcTransferSize = DMA_TRANSFER_SIZE_4B;
+            dmaConfig.destTransferSize = DMA_TRANSFER_SIZE_4B;
+            dmaConfig.disableRequestAfterDoneCmd = ENABLE;
+
+            for(bufNo = 0U; (bufNo < 2U) && (SUCC == res); bufNo++)
+            {
+                if(I2S_STREAM_RX == config->dir)
+                {
+                    dmaConfig.srcAddr = dataAddr;
+                    dmaConfig.destAddr = (uint32_t)config->buffer[bufNo];
+                    dmaConfig.minorLoopSrcOffset = 0;
+                    dmaConfig.minorLoopDestOffset = 4;
+                }
+                else
+                {
+                    dmaConfig.srcAddr = (uint32_t)config->buffer[bufNo];
+                    dmaConfig.destAddr = dataAddr;
+                    dmaConfig.minorLoopSrcOffset = 4;
+                    dmaConfig.minorLoopDestOffset = 0;
+                }
+                res = DMA_ChainNodeInit(&stream->node[bufNo], &dmaConfig, I2S_StreamDmaDone);
+            }
+
+            if(SUCC == res)
+            {
+                /* ping-pong: the chain loops through both buffers */
+                stream->node[0].next = &stream->node[1];
+                stream->node[1].next = &stream->node[0];
+
+                DMAMUX_SelChannelSource(config->dmaChannel, i2sDmaReqTable[i2sId]);
+                DMAMUX_OutputChannelEnable(config->dmaChannel);
+                res = DMA_ChainStart(config->dmaChannel, &stream->node[0]);
+                if(SUCC == res)
+                {
+                    stream->dmaActive = SET;
+                    stream->active = SET;
+                }
+                else
+                {
+                    DMAMUX_OutputChannelDisable(config->dmaChannel);
+                    res = ERR;
+                }
+            }
+        }
+        else
+        {
+            stream->active = SET;
+            I2S_IntMask(i2sId, channelId, (I2S_STREAM_RX == config->dir) ?
+                        I2S_RXFIFO_DATA_AVAILIABLE_INT : I2S_TXFIFO_EMPTY_INT, UNMASK);
+        }
+    }
+
+    return res;
+}
+
+/**
+ * @brief      Stop the stream of an I2S channel.
+ *
+ * @param[in]  i2sId:               Select the I2S ID:
+ *                                      -I2S_ID_0
+ *                                      -I2S_ID_1
+ *
+ * @param[in]  channelId:           Select the I2S Channel ID:
+ *                                      -Channel0_ID
+ *                                      -Channel1_ID
+ *                                      -Channel2_ID
+ *                                      -Channel3_ID
+ *
+ * @return     none
+ *
+ */
+void I2S_StreamStop(I2S_Id_t i2sId, I2S_ChannelId_t channelId)
+{
+    I2S_Stream_t * stream = &i2sStream[i2sId][channelId];
+    uint32_t primask;
+
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    if(SET == stream->active)
+    {
+        if(SET == stream->dmaActive)
+        {
+            DMA_ChainStop(stream->dmaChannel);
+            DMAMUX_OutputChannelDisable(stream->dmaChannel);
+            stream->dmaActive = RESET;
+        }
+        else
+        {
+            I2S_IntMask(i2sId, channelId, (I2S_STREAM_RX == stream->dir) ?
+                        I2S_RXFIFO_DATA_AVAILIABLE_INT : I2S_TXFIFO_EMPTY_INT, MASK);
+        }
+        stream->active = RESET;
+    }
+    COMMON_SetPRIMASK(primask);
+}
 /** @} end of group I2S_Public_Functions */
 
 /** @} end of group I2S_definitions */
@@ -25,6 +25,36 @@
  *  @{
  */
 
+/**
+ *  @brief SPI block transfer control
+ */
+typedef struct
+{
+    const uint8_t *txData;              /*!< frames to be sent, NULL sends 0 */
+    uint8_t *rxData;                    /*!< received frames, NULL discards */
+    uint32_t frameNum;                  /*!< frames of the transfer */
+    uint32_t txCount;                   /*!< frames written to the TX FIFO */
+    uint32_t rxCount;                   /*!< frames read from the RX FIFO */
+    uint32_t frameBytes;                /*!< buffer bytes per frame: 1, 2, 4 */
+    uint32_t rxFifoThr;                 /*!< RX FIFO threshold to restore */
+    spi_xfer_cb_t *callback;            /*!< transfer done callback */
+    volatile FlagStatus_t busy;         /*!< a transfer is in progress */
+    FlagStatus_t dmaActive;             /*!< the transfer is moved by DMA */
+    SPI_XferDmaConfig_t dma;            /*!< DMA offload configuration */
+    DMA_ChainNode_t txNode;             /*!< DMA descriptor feeding TX FIFO */
+    DMA_ChainNode_t rxNode;             /*!< DMA descriptor draining RX FIFO */
+} SPI_Xfer_t;
+
+/**
+ *  @brief SPI transaction queue
+ */
+typedef struct
+{
+    SPI_Transaction_t *head;            /*!< running transaction */
+    SPI_Transaction_t *tail;            /*!< last queued transaction */
+    volatile FlagStatus_t running;      /*!< the head transaction is on the SPI */
+} SPI_Queue_t;
+
 /** @} end of group SPI_Private_Types */
 
 /** @defgroup SPI_Private_Defines
@@ -33,6 +63,20 @@
 
 #define SPI_NUM     (4U)
 
+#define SPI_FIFO_DEPTH          (4U)
+#define SPI_FLR_LVL_MASK        (0x7U)
+#define SPI_FLR_RXTFL_SHIFT     (16U)
+#define SPI_DMA_FRAME_MAX       (32767U)
+
+#define SPI_CTRLR0_SCPH_SHIFT   (6U)
+#define SPI_CTRLR0_SCPOL_SHIFT  (7U)
+#define SPI_CTRLR0_DFS_SHIFT    (16U)
+#define SPI_CTRLR0_FRAME_MASK   ((1UL << SPI_CTRLR0_SCPH_SHIFT) | \
+                                 (1UL << SPI_CTRLR0_SCPOL_SHIFT) | \
+                                 (0x1FUL << SPI_CTRLR0_DFS_SHIFT))
+#define SPI_SSENR_EN            (1UL)
+#define SPI_SSENR_SER_SHIFT     (16U)
+
 /** @} end of group SPI_Private_Defines */
 
 /** @defgroup SPI_Private_Variables
@@ -82,12 +126,43 @@ static const uint32_t spiIntMaskTable[ ] =
     0x0000001FU    /*!< All the interrupt */
 };
 
+/**
+ *  @brief SPI DMA request source tables
+ */
+static const DMA_RequestSource_t spiDmaTxReqTable[SPI_NUM] =
+{
+    DMA_REQ_SPI0_TX,
+    DMA_REQ_SPI1_TX,
+    DMA_REQ_SPI2_TX,
+    DMA_REQ_SPI3_TX
+};
+
+static const DMA_RequestSource_t spiDmaRxReqTable[SPI_NUM] =
+{
+    DMA_REQ_SPI0_RX,
+    DMA_REQ_SPI1_RX,
+    DMA_REQ_SPI2_RX,
+    DMA_REQ_SPI3_RX
+};
+
+/**
+ *  @brief DMA source/destination for transfers without TX/RX buffer
+ */
+static const uint32_t spiXferTxDummy = 0U;
+static uint32_t spiXferRxDummy;
+
 /** @} end of group SPI_Private_Variables */
 
 /** @defgroup SPI_Global_Variables
  *  @{
  */
 
+/* block transfer control */
+static SPI_Xfer_t spiXfer[SPI_NUM];
+
+/* transaction queue */
+static SPI_Queue_t spiQueue[SPI_NUM];
+
 /** @} end of group SPI_Global_Variables */
 
 /** @defgroup SPI_Private_FunctionDeclaration
@@ -113,6 +188,23 @@ static const uint32_t spiIntMaskTable[ ] =
  void SPI3_Rxf_DriverIRQHandler(void);
  void SPI3_Rxo_DriverIRQHandler(void);
  void SPI3_Rxu_DriverIRQHandler(void);
+static uint32_t SPI_XferLoad(const SPI_Xfer_t * xfer, uint32_t index);
+static void SPI_XferStore(const SPI_Xfer_t * xfer, uint32_t index, 
+                          uint32_t data);
+static void SPI_XferFifo(SPI_Id_t spiId);
+static void SPI_XferSetRxThr(SPI_Id_t spiId);
+static void SPI_XferFinish(SPI_Id_t spiId);
+static FlagStatus_t SPI_XferRxfHandler(SPI_Id_t spiId);
+static void SPI_XferDmaDone(DMA_Channel_t channel, const DMA_ChainNode_t *node);
+static ResultStatus_t SPI_XferDmaStart(SPI_Id_t spiId);
+static ResultStatus_t SPI_XferPrepare(SPI_Id_t spiId, const uint8_t txData[],
+                                      uint8_t rxData[], uint32_t frameNum,
+                                      spi_xfer_cb_t * callback);
+static FlagStatus_t SPI_XferUseDma(SPI_Id_t spiId);
+static void SPI_QueueApplyDevice(SPI_Id_t spiId, 
+                                 const SPI_DeviceProfile_t * device);
+static void SPI_QueueStart(SPI_Id_t spiId);
+static void SPI_QueueXferDone(SPI_Id_t spiId);
 
 /** @} end of group SPI_Private_FunctionDeclaration */
 
@@ -120,6 +212,561 @@ static const uint32_t spiIntMaskTable[ ] =
  *  @{
  */
 
+/**
+ * @brief  Get a frame to be sent.
+ *
+ * @param  xfer: the transfer.
+ * @param  index: index of the frame.
+ *
+ * @return The frame.
+ *
+ */
+static uint32_t SPI_XferLoad(const SPI_Xfer_t * xfer, uint32_t index)
+{
+    uint32_t data = 0U;
+
+    if(xfer->txData != NULL)
+    {
+        /*PRQA S 0310, 3305 ++*/
+        if(1U == xfer->frameBytes)
+        {
+            data = xfer->txData[index];
+        }
+        else if(2U == xfer->frameBytes)
+        {
+            data = ((const uint16_t *)xfer->txData)[index];
+        }
+        else
+        {
+            data = ((const uint32_t *)xfer->txData)[index];
+        }
+        /*PRQA S 0310, 3305 --*/
+    }
+
+    return data;
+}
+
+/**
+ * @brief  Store a received frame.
+ *
+ * @param  xfer: the transfer.
+ * @param  index: index of the frame.
+ * @param  data: the frame.
+ *
+ * @return None.
+ *
+ */
+static void SPI_XferStore(const SPI_Xfer_t * xfer, uint32_t index, 
+                          uint32_t data)
+{
+    if(xfer->rxData != NULL)
+    {
+        /*PRQA S 0310, 3305 ++*/
+        if(1U == xfer->frameBytes)
+        {
+            xfer->rxData[index] = (uint8_t)data;
+        }
+        else if(2U == xfer->frameBytes)
+        {
+            ((uint16_t *)xfer->rxData)[index] = (uint16_t)data;
+        }
+        else
+        {
+            ((uint32_t *)xfer->rxData)[index] = data;
+        }
+        /*PRQA S 0310, 3305 --*/
+    }
+}
+
+/**
+ * @brief  Drain the RX FIFO and top up the TX FIFO.
+ *
+ * @param  spiId: the SPI id.
+ *
+ * @return None.
+ *
+ * Frames written but not read yet never exceed the FIFO depth, so the RX
+ * FIFO can not overflow however late the next service is.
+ */
+static void SPI_XferFifo(SPI_Id_t spiId)
+{
+    spi_reg_w_t * SPIxw = (spi_reg_w_t *)(spiRegWPtr[spiId]);
+    SPI_Xfer_t * xfer = &spiXfer[spiId];
+    uint32_t level;
+    uint32_t room;
+    uint32_t num;
+
+    level = SPIxw->SPI_FLR;
+
+    /* RX level first, the TX level read together only gets lower */
+    num = (level >> SPI_FLR_RXTFL_SHIFT) & SPI_FLR_LVL_MASK;
+    while(num > 0U)
+    {
+        SPI_XferStore(xfer, xfer->rxCount, SPIxw->SPI_DR_LOW);
+        xfer->rxCount++;
+        num--;
+    }
+
+    room = SPI_FIFO_DEPTH - (level & SPI_FLR_LVL_MASK);
+    num = SPI_FIFO_DEPTH - (xfer->txCount - xfer->rxCount);
+    if(num > room)
+    {
+        num = room;
+    }
+    if(num > (xfer->frameNum - xfer->txCount))
+    {
+        num = xfer->frameNum - xfer->txCount;
+    }
+
+    while(num > 0U)
+    {
+        SPIxw->SPI_DR_LOW = SPI_XferLoad(xfer, xfer->txCount);
+        xfer->txCount++;
+        num--;
+    }
+}
+
+/**
+ * @brief  Set the RX FIFO threshold for the next RXF interrupt.
+ *
+ * @param  spiId: the SPI id.
+ *
+ * @return None.
+ *
+ * The interrupt comes when half of the FIFO is received so that the other
+ * half keeps the bus busy while it is serviced.
+ */
+static void SPI_XferSetRxThr(SPI_Id_t spiId)
+{
+    spi_reg_t * SPIx = (spi_reg_t *)(spiRegPtr[spiId]);
+    SPI_Xfer_t * xfer = &spiXfer[spiId];
+    uint32_t thr;
+
+    thr = xfer->txCount - xfer->rxCount;
+    if(thr > (SPI_FIFO_DEPTH / 2U))
+    {
+        thr = SPI_FIFO_DEPTH / 2U;
+    }
+
+    SPIx->SPI_FTLR.RFT = thr - 1U;
+}
+
+/**
+ * @brief  End the transfer and report it.
+ *
+ * @param  spiId: the SPI id.
+ *
+ * @return None.
+ *
+ */
+static void SPI_XferFinish(SPI_Id_t spiId)
+{
+    spi_reg_t * SPIx = (spi_reg_t *)(spiRegPtr[spiId]);
+    SPI_Xfer_t * xfer = &spiXfer[spiId];
+
+    if(SET == xfer->dmaActive)
+    {
+        SPI_DmaCmd(spiId, DISABLE, DISABLE);
+        xfer->dmaActive = RESET;
+    }
+    else
+    {
+        SPIx->SPI_IER.RXFIE = 0U;
+        SPIx->SPI_FTLR.RFT = xfer->rxFifoThr;
+    }
+
+    xfer->busy = RESET;
+
+    if(xfer->callback != NULL)
+    {
+        xfer->callback(spiId);
+    }
+
+    /* a transfer out of the queue may have held back the queue head */
+    if(xfer->callback != SPI_QueueXferDone)
+    {
+        SPI_QueueStart(spiId);
+    }
+}
+
+/**
+ * @brief  Service an interrupt driven transfer on RXF.
+ *
+ * @param  spiId: the SPI id.
+ *
+ * @return SET: the interrupt is used by the transfer
+ *         RESET: no interrupt driven transfer is in progress
+ *
+ */
+static FlagStatus_t SPI_XferRxfHandler(SPI_Id_t spiId)
+{
+    SPI_Xfer_t * xfer = &spiXfer[spiId];
+    FlagStatus_t ret = RESET;
+
+    if((SET == xfer->busy) && (RESET == xfer->dmaActive))
+    {
+        SPI_XferFifo(spiId);
+
+        if(xfer->rxCount == xfer->frameNum)
+        {
+            SPI_XferFinish(spiId);
+        }
+        else
+        {
+            SPI_XferSetRxThr(spiId);
+        }
+
+        ret = SET;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  DMA RX descriptor done callback.
+ *
+ * @param  channel: the DMA RX channel.
+ * @param  node: the finished descriptor.
+ *
+ * @return None.
+ *
+ */
+static void SPI_XferDmaDone(DMA_Channel_t channel, const DMA_ChainNode_t *node)
+{
+    uint32_t spiId;
+
+    (void)channel;
+
+    for(spiId = 0U; spiId < SPI_NUM; spiId++)
+    {
+        if((&spiXfer[spiId].rxNode == node) && (SET == spiXfer[spiId].busy))
+        {
+            /* all frames are received, so the TX side is done as well */
+            DMA_ChainStop(spiXfer[spiId].dma.txChannel);
+            SPI_XferFinish((SPI_Id_t)spiId);
+        }
+    }
+}
+
+/**
+ * @brief  Start the DMA channels of a transfer.
+ *
+ * @param  spiId: the SPI id.
+ *
+ * @return SUCC: the DMA is started
+ *         ERR: the buffers are not aligned to the frames
+ *
+ */
+static ResultStatus_t SPI_XferDmaStart(SPI_Id_t spiId)
+{
+    spi_reg_w_t * SPIxw = (spi_reg_w_t *)(spiRegWPtr[spiId]);
+    SPI_Xfer_t * xfer = &spiXfer[spiId];
+    DMA_TransferConfig_t dmaConfig;
+    SPI_DmaLvl_t dmaLvl;
+    ResultStatus_t ret;
+
+    /* a TX request per free half FIFO, a RX request per received frame */
+    dmaLvl.dmaTransReqLevel = SPI_FIFO_DEPTH / 2U;
+    dmaLvl.dmaRecvReqLevel = 0U;
+    SPI_DmaConfig(spiId, &dmaLvl);
+
+    dmaConfig.transferByteNum = xfer->frameBytes;
+    dmaConfig.minorLoopNum = (uint16_t)xfer->frameNum;
+    dmaConfig.srcTransferSize = (1U == xfer->frameBytes) ? DMA_TRANSFER_SIZE_1B :
+                                ((2U == xfer->frameBytes) ? DMA_TRANSFER_SIZE_2B : 
+                                                            DMA_TRANSFER_SIZE_4B);
+    dmaConfig.destTransferSize = dmaConfig.srcTransferSize;
+    dmaConfig.majorLoopSrcOffset = 0;
+    dmaConfig.majorLoopDestOffset = 0;
+    dmaConfig.disableRequestAfterDoneCmd = ENABLE;
+
+    dmaConfig.channel = xfer->dma.rxChannel;
+    dmaConfig.channelPriority = DMA_GetChannelPriority(xfer->dma.rxChannel);
+    dmaConfig.channelPreempt = DMA_GetChannelPreempt(xfer->dma.rxChannel);
+    dmaConfig.source = spiDmaRxReqTable[spiId];
+    /*PRQA S 0306 ++*/
+    dmaConfig.srcAddr = (uint32_t)&SPIxw->SPI_DR_LOW;
+    dmaConfig.destAddr = (NULL == xfer->rxData) ? (uint32_t)&spiXferRxDummy : 
+                                                  (uint32_t)xfer->rxData;
+    /*PRQA S 0306 --*/
+    dmaConfig.minorLoopSrcOffset = 0;
+    dmaConfig.minorLoopDestOffset = (NULL == xfer->rxData) ? 0 : 
+                                    (int16_t)xfer->frameBytes;
+    ret = DMA_ChainNodeInit(&xfer->rxNode, &dmaConfig, SPI_XferDmaDone);
+
+    dmaConfig.channel = xfer->dma.txChannel;
+    dmaConfig.channelPriority = DMA_GetChannelPriority(xfer->dma.txChannel);
+    dmaConfig.channelPreempt = DMA_GetChannelPreempt(xfer->dma.txChannel);
+    dmaConfig.source = spiDmaTxReqTable[spiId];
+    /*PRQA S 0306 ++*/
+    dmaConfig.srcAddr = (NULL == xfer->txData) ? (uint32_t)&spiXferTxDummy : 
+                                                 (uint32_t)xfer->txData;
+    dmaConfig.destAddr = (uint32_t)&SPIxw->SPI_DR_LOW;
+    /*PRQA S 0306 --*/
+    dmaConfig.minorLoopSrcOffset = (NULL == xfer->txData) ? 0 : 
+                                   (int16_t)xfer->frameBytes;
+    dmaConfig.minorLoopDestOffset = 0;
+    if(SUCC == ret)
+    {
+        ret = DMA_ChainNodeInit(&xfer->txNode, &dmaConfig, NULL);
+    }
+
+    if(SUCC == ret)
+    {
+        DMAMUX_SelChannelSource(xfer->dma.rxChannel, spiDmaRxReqTable[spiId]);
+        DMAMUX_OutputChannelEnable(xfer->dma.rxChannel);
+        DMAMUX_SelChannelSource(xfer->dma.txChannel, spiDmaTxReqTable[spiId]);
+        DMAMUX_OutputChannelEnable(xfer->dma.txChannel);
+
+        xfer->dmaActive = SET;
+        ret = DMA_ChainStart(xfer->dma.rxChannel, &xfer->rxNode);
+        if(SUCC == ret)
+        {
+            ret = DMA_ChainStart(xfer->dma.txChannel, &xfer->txNode);
+            if(ret != SUCC)
+            {
+                DMA_ChainStop(xfer->dma.rxChannel);
+            }
+        }
+    }
+
+    if(SUCC == ret)
+    {
+        /* the SPI raises the requests from here on */
+        SPI_DmaCmd(spiId, ENABLE, ENABLE);
+    }
+    else
+    {
+        xfer->dmaActive = RESET;
+        ret = ERR;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Check the parameters and claim the SPI for a transfer.
+ *
+ * @param  spiId: the SPI id.
+ * @param  txData: frames to be sent.
+ * @param  rxData: memory for the received frames.
+ * @param  frameNum: the number of frames.
+ * @param  callback: transfer done callback.
+ *
+ * @return SUCC: the SPI is claimed
+ *         BUSY: a transfer is in progress
+ *         ERR: the parameters are invalid
+ *
+ */
+static ResultStatus_t SPI_XferPrepare(SPI_Id_t spiId, const uint8_t txData[],
+                                      uint8_t rxData[], uint32_t frameNum,
+                                      spi_xfer_cb_t * callback)
+{
+    spi_reg_t * SPIx = (spi_reg_t *)(spiRegPtr[spiId]);
+    SPI_Xfer_t * xfer = &spiXfer[spiId];
+    ResultStatus_t ret = SUCC;
+    uint32_t frameSize;
+    uint32_t primask;
+
+    if((0U == frameNum) || (SPIx->SPI_CTRLR0.TMOD != (uint32_t)SPI_TMOD_TR))
+    {
+        ret = ERR;
+    }
+    else
+    {
+        primask = COMMON_GetPRIMASK();
+        COMMON_DISABLE_INTERRUPTS();
+        if(SET == xfer->busy)
+        {
+            ret = BUSY;
+        }
+        else
+        {
+            xfer->busy = SET;
+        }
+        COMMON_SetPRIMASK(primask);
+    }
+
+    if(SUCC == ret)
+    {
+        frameSize = SPIx->SPI_CTRLR0.DFS_32 + 1U;
+
+        xfer->txData = txData;
+        xfer->rxData = rxData;
+        xfer->frameNum = frameNum;
+        xfer->txCount = 0U;
+        xfer->rxCount = 0U;
+        xfer->frameBytes = (frameSize <= 8U) ? 1U : ((frameSize <= 16U) ? 2U : 4U);
+        xfer->callback = callback;
+        xfer->dmaActive = RESET;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Check if the prepared transfer is offloaded to DMA.
+ *
+ * @param  spiId: the SPI id.
+ *
+ * @return SET: use DMA
+ *         RESET: use the CPU
+ *
+ */
+static FlagStatus_t SPI_XferUseDma(SPI_Id_t spiId)
+{
+    const SPI_Xfer_t * xfer = &spiXfer[spiId];
+
+    return ((ENABLE == xfer->dma.dmaEnable) && 
+            (xfer->frameNum >= xfer->dma.dmaThreshold) &&
+            (xfer->frameNum <= SPI_DMA_FRAME_MAX)) ? SET : RESET;
+}
+
+/**
+ * @brief  Switch the SPI to a device profile.
+ *
+ * @param  spiId: the SPI id.
+ * @param  device: the device profile.
+ *
+ * @return None.
+ *
+ * CTRLR0 and BAUDR can only be written while the SPI is disabled, so the
+ * SPI is disabled only when one of them changes. It shall only be called
+ * when no transfer is in progress.
+ */
+static void SPI_QueueApplyDevice(SPI_Id_t spiId, 
+                                 const SPI_DeviceProfile_t * device)
+{
+    spi_reg_w_t * SPIxw = (spi_reg_w_t *)(spiRegWPtr[spiId]);
+    uint32_t ctrl = SPIxw->SPI_CTRLR0;
+    uint32_t newCtrl;
+    uint32_t ssenr;
+
+    newCtrl = (ctrl & ~SPI_CTRLR0_FRAME_MASK) |
+              ((uint32_t)device->clkPhase << SPI_CTRLR0_SCPH_SHIFT) |
+              ((uint32_t)device->clkPolarity << SPI_CTRLR0_SCPOL_SHIFT) |
+              ((device->dataSize - 1U) << SPI_CTRLR0_DFS_SHIFT);
+
+    if((newCtrl != ctrl) || (SPIxw->SPI_BAUDR != device->clkDivider))
+    {
+        SPIxw->SPI_SSENR &= ~SPI_SSENR_EN;
+        SPIxw->SPI_CTRLR0 = newCtrl;
+        SPIxw->SPI_BAUDR = device->clkDivider;
+    }
+
+    ssenr = ((uint32_t)device->chipSelect << SPI_SSENR_SER_SHIFT) | SPI_SSENR_EN;
+    if(SPIxw->SPI_SSENR != ssenr)
+    {
+        SPIxw->SPI_SSENR = ssenr;
+    }
+}
+
+/**
+ * @brief  Start the transaction at the queue head.
+ *
+ * @param  spiId: the SPI id.
+ *
+ * @return None.
+ *
+ * Nothing is done if the queue is empty, its head is already running or
+ * the SPI is used by a transfer out of the queue; the queue is then started
+ * when that transfer finishes. A transaction failing to start is reported
+ * with ERR and the next one is tried.
+ */
+static void SPI_QueueStart(SPI_Id_t spiId)
+{
+    SPI_Queue_t * queue = &spiQueue[spiId];
+    SPI_Transaction_t * trans;
+    FlagStatus_t done = RESET;
+    ResultStatus_t ret;
+    uint32_t primask;
+
+    while(RESET == done)
+    {
+        ret = SUCC;
+
+        primask = COMMON_GetPRIMASK();
+        COMMON_DISABLE_INTERRUPTS();
+        trans = queue->head;
+        if((NULL == trans) || (SET == queue->running) ||
+           (SET == spiXfer[spiId].busy))
+        {
+            done = SET;
+        }
+        else
+        {
+            /* the SPI is idle and cannot be claimed by others meanwhile */
+            SPI_QueueApplyDevice(spiId, trans->device);
+            ret = SPI_TransferAsync(spiId, trans->txData, trans->rxData,
+                                    trans->frameNum, SPI_QueueXferDone);
+            if(SUCC == ret)
+            {
+                queue->running = SET;
+                done = SET;
+            }
+            else
+            {
+                queue->head = trans->next;
+                if(NULL == queue->head)
+                {
+                    queue->tail = NULL;
+                }
+            }
+        }
+        COMMON_SetPRIMASK(primask);
+
+        if(ret != SUCC)
+        {
+            trans->status = ERR;
+            if(trans->callback != NULL)
+            {
+                trans->callback(spiId, trans);
+            }
+        }
+    }
+}
+
+/**
+ * @brief  Transfer done callback of the queue.
+ *
+ * @param  spiId: the SPI id.
+ *
+ * @return None.
+ *
+ */
+static void SPI_QueueXferDone(SPI_Id_t spiId)
+{
+    SPI_Queue_t * queue = &spiQueue[spiId];
+    SPI_Transaction_t * trans;
+    uint32_t primask;
+
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    trans = queue->head;
+    if(trans != NULL)
+    {
+        queue->head = trans->next;
+        if(NULL == queue->head)
+        {
+            queue->tail = NULL;
+        }
+    }
+    queue->running = RESET;
+    COMMON_SetPRIMASK(primask);
+
+    if(trans != NULL)
+    {
+        trans->status = SUCC;
+        if(trans->callback != NULL)
+        {
+            trans->callback(spiId, trans);
+        }
+    }
+
+    /* no-op if the callback already started the next one */
+    SPI_QueueStart(spiId);
+}
+
 /**
  * @brief  SPI txe interrupt handler.
  *
@@ -197,6 +844,7 @@ static void SPI_Txo_Handler(SPI_Id_t spiId)
 static void SPI_Rxf_Handler(SPI_Id_t spiId)
 {
     uint32_t intStatus;
+    FlagStatus_t handled;
     spi_reg_t * SPIx = (spi_reg_t *)(spiRegPtr[spiId]);
     spi_reg_w_t * SPIxw = (spi_reg_w_t *)(spiRegWPtr[spiId]);
 
@@ -205,15 +853,21 @@ static void SPI_Rxf_Handler(SPI_Id_t spiId)
 
     if((intStatus & spiIntMaskTable[SPI_INT_RXF]) != 0U)
     {
+        handled = SPI_XferRxfHandler(spiId);
+        
         if(spiIsrCb[spiId][SPI_INT_RXF] != NULL)
         {
             spiIsrCb[spiId][SPI_INT_RXF]();
         }
         /* Mask this interrupt */
-        else
+        else if(RESET == handled)
         {
             SPIx->SPI_IER.RXFIE = 0U;
         }
+        else
+        {
+            /* the block transfer masks it when done */
+        }
     }
     COMMON_DSB();
 }
@@ -928,6 +1582,261 @@ void SPI_InstallCallbackFunc(SPI_Id_t spiId, SPI_Int_t intId, isr_cb_t * cbFun)
     spiIsrCb[spiId][intId] = cbFun;
 }
 
+/**
+ * @brief      Config the DMA offload of SPI_TransferBlocking() and 
+ *             SPI_TransferAsync().
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ * @param[in]  config:  Pointer to the DMA offload configuration.
+ *
+ * @return     status
+ *             - SUCC
+ *             - BUSY : a transfer is in progress
+ *
+ */
+ResultStatus_t SPI_TransferDmaConfig(SPI_Id_t spiNo, 
+                                     const SPI_XferDmaConfig_t * config)
+{
+    ResultStatus_t ret = SUCC;
+
+    if(SET == spiXfer[spiNo].busy)
+    {
+        ret = BUSY;
+    }
+    else
+    {
+        spiXfer[spiNo].dma = *config;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Full-duplex transfer of a buffer, wait until it is done.
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ * @param[in]  txData:  Frames to be sent, NULL to send 0.
+ * @param[out] rxData:  Memory for the received frames, NULL to discard them.
+ * @param[in]  frameNum:  The number of frames.
+ *
+ * @return     status
+ *             - SUCC
+ *             - BUSY : an async transfer is in progress
+ *             - ERR : frameNum is 0, the SPI is not in SPI_TMOD_TR mode or
+ *                     the DMA transfer is not done within
+ *                     SPI_TIMEOUT_WAIT_CNT. The DMA channels are then
+ *                     stopped and the received frames are incomplete.
+ *
+ */
+ResultStatus_t SPI_TransferBlocking(SPI_Id_t spiNo, const uint8_t txData[],
+                                    uint8_t rxData[], uint32_t frameNum)
+{
+    SPI_Xfer_t * xfer = &spiXfer[spiNo];
+    volatile uint32_t localCnt = 0U;
+    ResultStatus_t ret;
+    uint32_t primask;
+
+    ret = SPI_XferPrepare(spiNo, txData, rxData, frameNum, NULL);
+
+    if((SUCC == ret) && (SET == SPI_XferUseDma(spiNo)))
+    {
+        ret = SPI_XferDmaStart(spiNo);
+        if(SUCC == ret)
+        {
+            /* released by the DMA RX done interrupt */
+            while((SET == xfer->busy) && (localCnt <= SPI_TIMEOUT_WAIT_CNT))
+            {
+                localCnt++;
+            }
+
+            primask = COMMON_GetPRIMASK();
+            COMMON_DISABLE_INTERRUPTS();
+            if(SET == xfer->busy)
+            {
+                /* the DMA RX done interrupt did not come */
+                SPI_DmaCmd(spiNo, DISABLE, DISABLE);
+                DMA_ChainStop(xfer->dma.txChannel);
+                DMA_ChainStop(xfer->dma.rxChannel);
+                xfer->dmaActive = RESET;
+                xfer->busy = RESET;
+                ret = ERR;
+            }
+            COMMON_SetPRIMASK(primask);
+        }
+        else
+        {
+            xfer->busy = RESET;
+        }
+    }
+    else if(SUCC == ret)
+    {
+        while(xfer->rxCount < xfer->frameNum)
+        {
+            SPI_XferFifo(spiNo);
+        }
+        xfer->busy = RESET;
+    }
+    else
+    {
+        /* parameter error or busy */
+    }
+
+    if(ret != BUSY)
+    {
+        /* start the queue head held back by this transfer */
+        SPI_QueueStart(spiNo);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Start a full-duplex transfer of a buffer in background.
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ * @param[in]  txData:  Frames to be sent, NULL to send 0.
+ * @param[out] rxData:  Memory for the received frames, NULL to discard them.
+ * @param[in]  frameNum:  The number of frames.
+ * @param[in]  callback:  Called in interrupt when the transfer is done, 
+ *                        can be NULL.
+ *
+ * @return     status
+ *             - SUCC
+ *             - BUSY : a transfer is in progress
+ *             - ERR : frameNum is 0 or the SPI is not in SPI_TMOD_TR mode
+ *
+ */
+ResultStatus_t SPI_TransferAsync(SPI_Id_t spiNo, const uint8_t txData[],
+                                 uint8_t rxData[], uint32_t frameNum,
+                                 spi_xfer_cb_t * callback)
+{
+    spi_reg_t * SPIx = (spi_reg_t *)(spiRegPtr[spiNo]);
+    SPI_Xfer_t * xfer = &spiXfer[spiNo];
+    ResultStatus_t ret;
+
+    ret = SPI_XferPrepare(spiNo, txData, rxData, frameNum, callback);
+
+    if((SUCC == ret) && (SET == SPI_XferUseDma(spiNo)))
+    {
+        ret = SPI_XferDmaStart(spiNo);
+        if(ret != SUCC)
+        {
+            xfer->busy = RESET;
+        }
+    }
+    else if(SUCC == ret)
+    {
+        xfer->rxFifoThr = SPIx->SPI_FTLR.RFT;
+        SPI_XferFifo(spiNo);
+        SPI_XferSetRxThr(spiNo);
+        SPIx->SPI_IER.RXFIE = 1U;
+    }
+    else
+    {
+        /* parameter error or busy */
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Get the status of SPI_TransferAsync().
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ *
+ * @return     SET : the transfer is in progress
+ *             RESET : no transfer is in progress
+ *
+ */
+FlagStatus_t SPI_GetTransferStatus(SPI_Id_t spiNo)
+{
+    return spiXfer[spiNo].busy;
+}
+
+/**
+ * @brief      Queue a transaction to a slave device.
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ * @param[in]  trans:  The transaction, it shall be kept until its callback.
+ *
+ * @return     status
+ *             - SUCC : the transaction is queued
+ *             - ERR : no device, frameNum is 0 or dataSize is out of range
+ *
+ */
+ResultStatus_t SPI_QueueSubmit(SPI_Id_t spiNo, SPI_Transaction_t * trans)
+{
+    SPI_Queue_t * queue = &spiQueue[spiNo];
+    ResultStatus_t ret = SUCC;
+    uint32_t primask;
+
+    if((NULL == trans->device) || (0U == trans->frameNum) ||
+       (trans->device->dataSize < 4U) || (trans->device->dataSize > 32U))
+    {
+        ret = ERR;
+    }
+    else
+    {
+        trans->next = NULL;
+
+        primask = COMMON_GetPRIMASK();
+        COMMON_DISABLE_INTERRUPTS();
+        if(NULL == queue->head)
+        {
+            queue->head = trans;
+        }
+        else
+        {
+            queue->tail->next = trans;
+        }
+        queue->tail = trans;
+        COMMON_SetPRIMASK(primask);
+
+        /* no-op if a transfer is running, the next one is then started by
+           its done interrupt */
+        SPI_QueueStart(spiNo);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Drop the queued transactions not started yet.
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ *
+ * @return     none
+ *
+ */
+void SPI_QueueFlush(SPI_Id_t spiNo)
+{
+    SPI_Queue_t * queue = &spiQueue[spiNo];
+    uint32_t primask;
+
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    if(queue->head != NULL)
+    {
+        queue->head->next = NULL;
+        queue->tail = queue->head;
+    }
+    COMMON_SetPRIMASK(primask);
+}
+
+/**
+ * @brief      Get the status of the transaction queue.
+ *
+ * @param[in]  spiNo:  Select the SPI id, should be SPI_ID_0, SPI_ID_1, SPI_ID_2,SPI_ID_3.
+ *
+ * @return     SET : a transaction is running or queued
+ *             RESET : the queue is empty
+ *
+ */
+FlagStatus_t SPI_QueueGetStatus(SPI_Id_t spiNo)
+{
+    return (spiQueue[spiNo].head != NULL) ? SET : RESET;
+}
+
 /** @} end of group SPI_Public_Functions */
 
 /** @} end of group SPI */
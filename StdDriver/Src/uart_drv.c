@@ -27,6 +27,71 @@
  *  @{
  */
 
+/**
+ *  @brief UART byte ring control. For the TX ring UART_Write() is the only
+ *         producer and the interrupt handler is the only consumer, the RX
+ *         ring works the other way round.
+ */
+typedef struct
+{
+    uint8_t *buf;                   /*!< ring storage, NULL if not used */
+    uint32_t size;                  /*!< size of the storage, power of 2 */
+    volatile uint32_t head;         /*!< write count, updated by producer */
+    volatile uint32_t tail;         /*!< read count, updated by consumer */
+} UART_Ring_t;
+
+/**
+ *  @brief UART buffered mode control
+ */
+typedef struct
+{
+    UART_Ring_t txRing;             /*!< TX ring */
+    UART_Ring_t rxRing;             /*!< RX ring */
+    uint32_t rxDropCnt;             /*!< bytes dropped when RX ring is full */
+} UART_Buffered_t;
+
+/**
+ *  @brief UART DMA streaming control. The RX write position is taken from the
+ *         rest minor loop count of the RX channel.
+ */
+typedef struct
+{
+    uint8_t *rxBuf;                 /*!< circular RX buffer, NULL if not used */
+    uint32_t rxSize;                /*!< size of rxBuf */
+    uint32_t readPos;               /*!< next position read by UART_DmaRead() */
+    uint32_t idlePos;               /*!< write position at the last idle */
+    uart_dma_rx_cb_t *rxCallback;   /*!< packet callback */
+    DMA_Channel_t rxChannel;        /*!< RX DMA channel */
+    DMA_Channel_t txChannel;        /*!< TX DMA channel */
+    ControlState_t txEnable;        /*!< DMA TX is enabled */
+} UART_Dma_t;
+
+/**
+ *  @brief UART LIN master schedule control. The schedule tick and the UART
+ *         interrupt run at the same priority, so they do not preempt each
+ *         other.
+ */
+typedef struct
+{
+    const UART_LinSchedule_t *table;   /*!< running table, NULL if stopped */
+    const UART_LinSchedule_t *pending; /*!< table taking over at next slot */
+    uint32_t nextSlot;                 /*!< slot started at next boundary */
+    uint32_t curSlot;                  /*!< slot in progress */
+    uint32_t ticksLeft;                /*!< ticks to the next boundary */
+    FlagStatus_t busy;                 /*!< frame of curSlot in progress */
+    UART_LinScheduleStats_t stats;     /*!< statistics */
+} UART_LinSched_t;
+
+/**
+ *  @brief UART LIN slave node control
+ */
+typedef struct
+{
+    const UART_LinSlaveTable_t *table;  /*!< response table, NULL if stopped */
+    UART_LinSlaveEntry_t *cur;          /*!< entry of the response in progress */
+    uint8_t entryIdx[64];               /*!< table index of each 6-bit ID */
+} UART_LinSlave_t;
+
 /** @}end of group UART_Private_Type*/
 
 /** @defgroup UART_Private_Defines
@@ -45,6 +110,11 @@
 #define UART_INTSTA_IID_HEADER_DONE   0x0DU
 #define UART_INTSTA_IID_RSP_DONE      0x0EU
 
+#define UART_LIN_ID_NUM              64U
+#define UART_LIN_ID_MASK             0x3FU
+#define UART_LIN_ENTRY_NONE          0xFFU
+#define UART_LIN_EXACT_FILTER_NUM    16U
+
 #define UART_LIN_SEND_BREAK_MIN      13U
 #define UART_LIN_SEND_BREAK_THR      11U
 
@@ -63,6 +133,10 @@
 #define UART_LSI_BI       (1U << 4U)
 #define UART_LSI_RFE      (1U << 7U)
 
+#define UART_LIN_HEADER_ERR_FLAG         (UART_LIN_SYNC_FIELD_ERR | \
+                                          UART_LIN_PID_ERR | \
+                                          UART_LIN_TO_ERR)
+
 #define UART_LIN_HEADER_DONE_INT_FLAG     (UART_LIN_HEADER_DONE_FLG | \
                                            UART_LIN_SYNC_FIELD_ERR | \
                                            UART_LIN_PID_ERR| \
@@ -81,6 +155,63 @@
 #define UART_ENABLE_FIFO         1U
 #define UART_RESET_RX_FIFO      (1U << 1U)
 #define UART_RESET_TX_FIFO      (1U << 2U)
+#define UART_FCR_TET_SHIFT       4U
+#define UART_FCR_RT_SHIFT        6U
+#define UART_FCR_LVL_MASK        0x03U
+
+#define UART_LSR_DR              1U
+
+#define UART_DMA_RX_SIZE_MAX     32768U
+
+/**
+ *  @brief DMA TX request source of each UART
+ */
+static const DMA_RequestSource_t uartDmaTxReqTable[UART_NUM]=
+{
+    DMA_REQ_UART0_TX,
+    DMA_REQ_UART1_TX,
+    DMA_REQ_UART2_TX,
+    DMA_REQ_UART3_TX,
+    DMA_REQ_UART4_TX,
+    DMA_REQ_UART5_TX,
+};
+
+/**
+ *  @brief DMA RX request source of each UART
+ */
+static const DMA_RequestSource_t uartDmaRxReqTable[UART_NUM]=
+{
+    DMA_REQ_UART0_RX,
+    DMA_REQ_UART1_RX,
+    DMA_REQ_UART2_RX,
+    DMA_REQ_UART3_RX,
+    DMA_REQ_UART4_RX,
+    DMA_REQ_UART5_RX,
+};
+
+/**
+ *  @brief Number of bytes the TX FIFO can take when the TX empty interrupt
+ *         is asserted, indexed by UART_TxFIFOLvl_t. The FIFO is 16 bytes.
+ */
+static const uint8_t uartTxFifoRoomTable[]=
+{
+    16U,       /*!< UART_TX_FIFO_EMPTY */
+    14U,       /*!< UART_TX_FIFO_CHAR_2 */
+    12U,       /*!< UART_TX_FIFO_QUARTER */
+    8U,        /*!< UART_TX_FIFO_HALF */
+};
+
+/**
+ *  @brief Number of bytes the RX FIFO holds at least when the RX data 
+ *         available interrupt is asserted, indexed by UART_RxFIFOLvl_t.
+ */
+static const uint8_t uartRxFifoLevelTable[]=
+{
+    1U,        /*!< UART_RX_FIFO_CHAR_1 */
+    4U,        /*!< UART_RX_FIFO_QUARTER */
+    8U,        /*!< UART_RX_FIFO_HALF */
+    14U,       /*!< UART_RX_FIFO_LESS_2 */
+};
 
 static const uint32_t uartInterruptMaskTable[]=
 {
@@ -185,12 +316,33 @@ static uint32_t uartLineStatusBuf[UART_NUM] =
 /* FIFO Control register buff */
 static uint32_t uartFifoControlBuf[UART_NUM] = {0U,0U,0U,0U,0U,0U};
 
+/* Buffered mode control */
+static UART_Buffered_t uartBuffered[UART_NUM];
+
+/* DMA streaming control */
+static UART_Dma_t uartDma[UART_NUM];
+
+/* LIN master schedule control */
+static UART_LinSched_t uartLinSched[UART_NUM];
+
+/* LIN slave node control */
+static UART_LinSlave_t uartLinSlave[UART_NUM];
+
 /** @}end of group UART_Global_Variables */
 
 /** @defgroup UART_Private_FunctionDeclaration
  *  @{
  */
 static void UART_IntHandler(UART_ID_t uartId);
+static FlagStatus_t UART_BufferedRxHandler(UART_ID_t uartId, uint32_t burst);
+static FlagStatus_t UART_BufferedTxHandler(UART_ID_t uartId);
+static uint32_t UART_DmaRxPos(UART_ID_t uartId);
+static FlagStatus_t UART_DmaRxIdleHandler(UART_ID_t uartId);
+static void UART_LinSchedSlotEnd(UART_ID_t uartId, UART_LinSlotStatus_t status);
+static FlagStatus_t UART_LinSchedHeaderDone(UART_ID_t uartId);
+static FlagStatus_t UART_LinSchedRspDone(UART_ID_t uartId);
+static FlagStatus_t UART_LinSlaveHeaderDone(UART_ID_t uartId);
+static FlagStatus_t UART_LinSlaveRspDone(UART_ID_t uartId);
 void UART0_DriverIRQHandler(void);
 void UART1_DriverIRQHandler(void);
 void UART2_DriverIRQHandler(void);
@@ -205,251 +357,1317 @@ void UART5_DriverIRQHandler(void);
  */
 
 /**
- * @brief      Handle UART interrupt.
+ * @brief      Move received bytes from the RX FIFO into the RX ring.
  *
  * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
  *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  burst: number of bytes known to be in the RX FIFO. They are
+ *                    read without checking the line status, the rest is read
+ *                    until the FIFO is empty.
  *
- * @return     none
+ * @return     SET: buffered RX is used and the FIFO has been drained
+ *             RESET: buffered RX is not used
  *
  */
-static void UART_IntHandler(UART_ID_t uartId)
+static FlagStatus_t UART_BufferedRxHandler(UART_ID_t uartId, uint32_t burst)
 {
-    uint32_t intId;
-    volatile uint32_t dummyData;
-
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
     uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    UART_Ring_t *ring = &uartBuffered[uartId].rxRing;
+    FlagStatus_t ret = RESET;
+    uint32_t head = ring->head;
+    uint32_t count = 0U;
+    uint8_t data;
     
-    uartLineStatusBuf[uartId] = UARTxw->UART_LSR;    
-    
-    if(UARTx->UART_DLH_IER.UART_IER.HEADER_DONE_INT_EN == 1U)
+    if(ring->buf != NULL)
     {
-        /* LIN header done interrupt */
-        if((UART_LIN_HEADER_DONE_FLG  & uartLineStatusBuf[uartId]) != 0U)
+        while((count < burst) || 
+              ((UARTxw->UART_LSR & UART_LSR_DR) != 0U))
         {
-            if(uartIsrCb[uartId][UART_INT_HEADER_DONE] != NULL)
+            data = (uint8_t)UARTxw->UART_RBR_THR_DLL.UART_RBR;
+            
+            if((head - ring->tail) < ring->size)
             {
-                /* call the callback function */
-                uartIsrCb[uartId][UART_INT_HEADER_DONE]();
+                ring->buf[head & (ring->size - 1U)] = data;
+                head++;
             }
-            /* Disable the interrupt if callback function is not setup */
             else
             {
-                UARTx->UART_DLH_IER.UART_IER.HEADER_DONE_INT_EN = 0U;
-            }   
+                uartBuffered[uartId].rxDropCnt++;
+            }
+            
+            count++;
         }
+        
+        /* The data shall be written before it is visible to the consumer */
+        COMMON_DMB();
+        ring->head = head;
+        ret = SET;
     }
     
-    if(UARTx->UART_DLH_IER.UART_IER.RSP_DONE_INT_EN == 1U)
+    return ret;
+}
+
+/**
+ * @brief      Move bytes from the TX ring into the TX FIFO, up to the room
+ *             given by the TX empty trigger level. The TX empty interrupt is
+ *             masked when the ring is empty.
+ *
+ * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     SET: buffered TX is used
+ *             RESET: buffered TX is not used
+ *
+ */
+static FlagStatus_t UART_BufferedTxHandler(UART_ID_t uartId)
+{
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    UART_Ring_t *ring = &uartBuffered[uartId].txRing;
+    FlagStatus_t ret = RESET;
+    uint32_t head = ring->head;
+    uint32_t tail = ring->tail;
+    uint32_t room = 1U;
+    
+    if(ring->buf != NULL)
     {
-        /* LIN respnse done interrupt*/
-        if((UART_LIN_RSP_DONE_FLAG & uartLineStatusBuf[uartId]) != 0U)
+        if((uartFifoControlBuf[uartId] & UART_ENABLE_FIFO) != 0U)
         {
-            if(uartIsrCb[uartId][UART_INT_RSP_DONE] != NULL)
-            {
-                /* call the callback function */
-                uartIsrCb[uartId][UART_INT_RSP_DONE]();
-            }
-            /* Disable the interrupt if callback function is not setup */
-            else
-            {
-                UARTx->UART_DLH_IER.UART_IER.RSP_DONE_INT_EN = 0U;
-            }  
+            room = uartTxFifoRoomTable[(uartFifoControlBuf[uartId] >> 
+                                        UART_FCR_TET_SHIFT) & UART_FCR_LVL_MASK];
         }
-    }
-    
-    if(UARTx->UART_DLH_IER.UART_IER.ELSI == 1U)
-    {
-        /* UART line status interrupt */
-        if((UART_LSI_INT_FLAG & uartLineStatusBuf[uartId]) != 0U)
+        
+        while((tail != head) && (room > 0U))
         {
-            if(uartIsrCb[uartId][UART_INT_LSI] != NULL)
-            {
-                /* call the callback function */
-                uartIsrCb[uartId][UART_INT_LSI]();
-            }
-            /* Disable the interrupt if callback function is not setup */
-            else
-            {
-                UARTx->UART_DLH_IER.UART_IER.ELSI = 0U;
-            } 
+            UARTxw->UART_RBR_THR_DLL.UART_THR = 
+                (uint32_t)ring->buf[tail & (ring->size - 1U)];
+            tail++;
+            room--;
         }
-    }
-    
-    if( UARTx->UART_DLH_IER.UART_IER.ASYNC_INT_EN == 1U)
-    {
-        /* UART_LIN async interrupt */
-        if((UART_LIN_ASYNC_INT_FLAG & uartLineStatusBuf[uartId]) != 0U )
+        
+        ring->tail = tail;
+        
+        if(tail == head)
         {
-            if(uartIsrCb[uartId][UART_INT_ASYNC] != NULL)
-            {
-                /* call the callback function */
-                uartIsrCb[uartId][UART_INT_ASYNC]();
-            }
-            /* Disable the interrupt if callback function is not setup */
-            else
-            {
-                UARTx->UART_DLH_IER.UART_IER.ASYNC_INT_EN = 0U;
-            }
-        }    
-    }
-    
-    /* Get the BF related pointer */
-    intId = UARTx->UART_IIR_FCR.UART_IIR.IID;  
-    
-    switch(intId)
-    {
-        case UART_INTSTA_IID_RBFI:
-            if(uartIsrCb[uartId][UART_INT_RBFI] != NULL)
-            {
-                /* call the callback function */
-                uartIsrCb[uartId][UART_INT_RBFI]();
-            }
-            /* Disable the interrupt if callback function is not setup */
-            else
-            {
-                UARTx->UART_DLH_IER.UART_IER.ERBFI = 0U;
-            }
-            break;
-            
-        /* Transmit holding register empty interrupt */
-        case UART_INTSTA_IID_TBEI:
-            if(uartIsrCb[uartId][UART_INT_TBEI] != NULL)
-            {
-                /* call the callback function */
-                uartIsrCb[uartId][UART_INT_TBEI]();
-            }
-            /* Disable the interrupt if callback function is not setup */
-            else
-            {
-                UARTx->UART_DLH_IER.UART_IER.ETBEI = 0U;
-            }
-            break;
-
-        /* Busy detect indication */
-        case UART_INTSTA_IID_BYDET:  
-            /* Clear it by reading the UART status register */
-            dummyData = UARTxw->UART_USR;
-            if(uartIsrCb[uartId][UART_INT_BYDET] != NULL)
-            {
-                /* call the callback function */
-                uartIsrCb[uartId][UART_INT_BYDET]();
-            }
-            /* Disable the interrupt if callback function is not setup */
-            else
-            {
-                UARTx->UART_DLH_IER.UART_IER.ERBFI = 0U;
-            }            
-            break;
-
-        /* Character timeout indication */
-        case UART_INTSTA_IID_RCVRTO:
-            if(uartIsrCb[uartId][UART_INT_RCVRTO] != NULL)
-            {
-                /* call the callback function */
-                uartIsrCb[uartId][UART_INT_RCVRTO]();
-            }
-            /* Disable the interrupt if callback function is not setup */
-            else
-            {
-                UARTx->UART_DLH_IER.UART_IER.ERBFI = 0U;
-            }
-             /* Clear it by reading the UART receive register */
-            dummyData = UARTxw ->UART_RBR_THR_DLL.UART_RBR;
-            break;
-            
-        case UART_INTSTA_IID_MODEM:
-            /* Clear it by reading the UART status register */
-            dummyData = UARTxw->UART_MSR;
-            if(uartIsrCb[uartId][UART_INT_MODEM] != NULL)
-            {
-                /* call the callback function */
-                uartIsrCb[uartId][UART_INT_MODEM]();
-            }
-            /* Disable the interrupt if callback function is not setup */
-            else
-            {
-                UARTx->UART_DLH_IER.UART_IER.EDSSI = 0U;
-            }             
-            break;
-            
-        default:
-            /*nothing to do*/
-            break;
+            UARTxw->UART_DLH_IER.UART_IER &= 
+                (~(uartInterruptMaskTable[UART_INT_TBEI]));
+        }
+        
+        ret = SET;
     }
     
-    uartLineStatusBuf[uartId] = 0;
-
-    COMMON_DSB();
+    return ret;
 }
-/** @} end of group UART_Private_Functions */
 
-/** @defgroup UART_Public_Functions
- *  @{
- */
 /**
- * @brief      install call back function
+ * @brief      Get the position in the DMA RX buffer the next byte is written to.
  *
  * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  intType: select the interrupt
- * @param[in]  cbFun: pointer to callback function
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
  *
- * @return     none
+ * @return     the write position
  *
  */
-void UART_InstallCallBackFunc(UART_ID_t uartId, UART_Int_t intType,
-                              isr_cb_t * cbFun)
+static uint32_t UART_DmaRxPos(UART_ID_t uartId)
 {
-    uartIsrCb[uartId][intType] = cbFun;
+    uint32_t pos;
+    
+    pos = uartDma[uartId].rxSize - 
+          (uint32_t)DMA_GetRestMinorLoopNum(uartDma[uartId].rxChannel);
+    
+    /* the rest count reads 0 right at the wrap around */
+    if(pos >= uartDma[uartId].rxSize)
+    {
+        pos = 0U;
+    }
+    
+    return pos;
 }
 
 /**
- * @brief      Get line status buffer in interrupt call back functions. The line 
- *             status will be stored into line status buffer in UART_IRQHandler.
- *             If the call back functions which are installed through 
- *             UART_InstallCallBackFunc()  needs to get the line status, please 
- *             use this function instead of UART_GetAllLineStatus or 
- *             UART_GetLineStatus.
+ * @brief      Report the packet ended by an idle line in DMA RX mode.
  *
  * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
  *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
  *
- * @return     linestatus
+ * @return     SET: DMA RX is used and the idle has been handled
+ *             RESET: DMA RX is not used
  *
  */
-uint32_t UART_GetLineStatusBufForCbf(UART_ID_t uartId)
-{        
-    return uartLineStatusBuf[uartId];
-}
-
-/**
+static FlagStatus_t UART_DmaRxIdleHandler(UART_ID_t uartId)
+{
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    UART_Dma_t *dma = &uartDma[uartId];
+    FlagStatus_t ret = RESET;
+    volatile uint32_t dummyData;
+    uint32_t pos;
+    uint32_t len;
+    
+    if(dma->rxBuf != NULL)
+    {
+        /* The DMA empties the FIFO, only clear the timeout by reading RBR 
+           when no data is left for the DMA */
+        if((UARTxw->UART_LSR & UART_LSR_DR) == 0U)
+        {
+            dummyData = UARTxw->UART_RBR_THR_DLL.UART_RBR;
+        }
+        
+        pos = UART_DmaRxPos(uartId);
+        len = (pos >= dma->idlePos) ? (pos - dma->idlePos) : 
+                                      ((dma->rxSize - dma->idlePos) + pos);
+        dma->idlePos = pos;
+        
+        if((len != 0U) && (dma->rxCallback != NULL))
+        {
+            dma->rxCallback(uartId, len);
+        }
+        
+        ret = SET;
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief      End the slot in progress of the LIN schedule.
+ *
+ * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  status: result of the slot
+ *
+ * @return     none
+ *
+ */
+static void UART_LinSchedSlotEnd(UART_ID_t uartId, UART_LinSlotStatus_t status)
+{
+    UART_LinSched_t *sched = &uartLinSched[uartId];
+    
+    sched->busy = RESET;
+    
+    switch(status)
+    {
+        case UART_LIN_SLOT_HEADER_ERR:
+            sched->stats.headerErrCnt++;
+            break;
+            
+        case UART_LIN_SLOT_RSP_ERR:
+            sched->stats.rspErrCnt++;
+            break;
+            
+        case UART_LIN_SLOT_NO_RSP:
+            sched->stats.noRspCnt++;
+            break;
+            
+        default:
+            /*nothing to do*/
+            break;
+    }
+    
+    if(sched->table->callback != NULL)
+    {
+        sched->table->callback(uartId, sched->curSlot, status);
+    }
+}
+
+/**
+ * @brief      Continue the slot in progress of the LIN schedule after its 
+ *             header is sent.
+ *
+ * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     SET: the header belongs to the LIN schedule
+ *             RESET: the LIN schedule is not running
+ *
+ */
+static FlagStatus_t UART_LinSchedHeaderDone(UART_ID_t uartId)
+{
+    UART_LinSched_t *sched = &uartLinSched[uartId];
+    const UART_LinSlot_t *slot;
+    UART_LinResponse_t rsp;
+    FlagStatus_t ret = RESET;
+    ResultStatus_t result = SUCC;
+    
+    if((sched->table != NULL) && (SET == sched->busy))
+    {
+        slot = &sched->table->slots[sched->curSlot];
+        
+        if((UART_LIN_HEADER_ERR_FLAG & uartLineStatusBuf[uartId]) != 0U)
+        {
+            UART_LinSchedSlotEnd(uartId, UART_LIN_SLOT_HEADER_ERR);
+        }
+        else if(UART_LIN_SLOT_TX == slot->dir)
+        {
+            rsp.checkType = slot->checkType;
+            rsp.len = slot->len;
+            for(uint32_t count = 0U; count < rsp.len; count++)
+            {
+                rsp.data[count] = slot->data[count];
+            }
+            result = UART_LinSendResponse(uartId, &rsp);
+        }
+        else if(UART_LIN_SLOT_RX == slot->dir)
+        {
+            result = UART_LinStartReceiveResponse(uartId, slot->checkType, 
+                                                  slot->len);
+        }
+        else
+        {
+            UART_LinSchedSlotEnd(uartId, UART_LIN_SLOT_OK);
+        }
+        
+        if(result != SUCC)
+        {
+            UART_LinSchedSlotEnd(uartId, UART_LIN_SLOT_RSP_ERR);
+        }
+        
+        ret = SET;
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief      Finish the slot in progress of the LIN schedule after its 
+ *             response is done.
+ *
+ * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     SET: the response belongs to the LIN schedule
+ *             RESET: the LIN schedule is not running
+ *
+ */
+static FlagStatus_t UART_LinSchedRspDone(UART_ID_t uartId)
+{
+    UART_LinSched_t *sched = &uartLinSched[uartId];
+    const UART_LinSlot_t *slot;
+    FlagStatus_t ret = RESET;
+    
+    if((sched->table != NULL) && (SET == sched->busy))
+    {
+        slot = &sched->table->slots[sched->curSlot];
+        
+        if((UART_LIN_TO_ERR & uartLineStatusBuf[uartId]) != 0U)
+        {
+            UART_LinSchedSlotEnd(uartId, UART_LIN_SLOT_NO_RSP);
+        }
+        else if((UART_LIN_CHECKSUM_ERR & uartLineStatusBuf[uartId]) != 0U)
+        {
+            UART_LinSchedSlotEnd(uartId, UART_LIN_SLOT_RSP_ERR);
+        }
+        else
+        {
+            if(UART_LIN_SLOT_RX == slot->dir)
+            {
+                UART_LinReadResponse(uartId, slot->len, slot->data);
+            }
+            UART_LinSchedSlotEnd(uartId, UART_LIN_SLOT_OK);
+        }
+        
+        ret = SET;
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief      Answer a received header in LIN slave mode.
+ *
+ * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     SET: the header belongs to the LIN slave node
+ *             RESET: the LIN slave node is not running
+ *
+ */
+static FlagStatus_t UART_LinSlaveHeaderDone(UART_ID_t uartId)
+{
+    UART_LinSlave_t *slave = &uartLinSlave[uartId];
+    UART_LinSlaveEntry_t *entry = NULL;
+    FlagStatus_t ret = RESET;
+    ResultStatus_t result = ERR;
+    uint32_t idx;
+    
+    if(slave->table != NULL)
+    {
+        if((UART_LIN_HEADER_ERR_FLAG & uartLineStatusBuf[uartId]) == 0U)
+        {
+            idx = slave->entryIdx[UART_LinGetId(uartId) & UART_LIN_ID_MASK];
+            if(idx != UART_LIN_ENTRY_NONE)
+            {
+                entry = &slave->table->entries[idx];
+            }
+        }
+        
+        if(NULL == entry)
+        {
+            /* header error, or ID passed by the vague filter only */
+            (void)UART_LinStartReceiveHeader(uartId);
+        }
+        else
+        {
+            slave->cur = entry;
+            
+            if(UART_LIN_RSP_PUBLISH == entry->dir)
+            {
+                result = UART_LinSendResponse(uartId, &entry->rsp);
+            }
+            else
+            {
+                result = UART_LinStartReceiveResponse(uartId, 
+                                                      entry->rsp.checkType,
+                                                      entry->rsp.len);
+            }
+            
+            if(result != SUCC)
+            {
+                slave->cur = NULL;
+                (void)UART_LinStartReceiveHeader(uartId);
+                if(slave->table->callback != NULL)
+                {
+                    slave->table->callback(uartId, entry->id, 
+                                           UART_LIN_SLOT_RSP_ERR);
+                }
+            }
+        }
+        
+        ret = SET;
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief      Finish a response in LIN slave mode and wait for the next 
+ *             header.
+ *
+ * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     SET: the response belongs to the LIN slave node
+ *             RESET: the LIN slave node is not running
+ *
+ */
+static FlagStatus_t UART_LinSlaveRspDone(UART_ID_t uartId)
+{
+    UART_LinSlave_t *slave = &uartLinSlave[uartId];
+    UART_LinSlaveEntry_t *entry = slave->cur;
+    UART_LinSlotStatus_t status = UART_LIN_SLOT_OK;
+    FlagStatus_t ret = RESET;
+    
+    if((slave->table != NULL) && (entry != NULL))
+    {
+        if((UART_LIN_TO_ERR & uartLineStatusBuf[uartId]) != 0U)
+        {
+            status = UART_LIN_SLOT_NO_RSP;
+        }
+        else if((UART_LIN_CHECKSUM_ERR & uartLineStatusBuf[uartId]) != 0U)
+        {
+            status = UART_LIN_SLOT_RSP_ERR;
+        }
+        else if(UART_LIN_RSP_SUBSCRIBE == entry->dir)
+        {
+            UART_LinReadResponse(uartId, entry->rsp.len, entry->rsp.data);
+        }
+        else
+        {
+            /* published response is sent */
+        }
+        
+        slave->cur = NULL;
+        (void)UART_LinStartReceiveHeader(uartId);
+        
+        if(slave->table->callback != NULL)
+        {
+            slave->table->callback(uartId, entry->id, status);
+        }
+        
+        ret = SET;
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief      Handle UART interrupt.
+ *
+ * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     none
+ *
+ */
+static void UART_IntHandler(UART_ID_t uartId)
+{
+    uint32_t intId;
+    uint32_t rxBurst = 1U;
+    FlagStatus_t handled;
+    volatile uint32_t dummyData;
+
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    
+    uartLineStatusBuf[uartId] = UARTxw->UART_LSR;    
+    
+    if(UARTx->UART_DLH_IER.UART_IER.HEADER_DONE_INT_EN == 1U)
+    {
+        /* LIN header done interrupt */
+        if((UART_LIN_HEADER_DONE_FLG  & uartLineStatusBuf[uartId]) != 0U)
+        {
+            handled = UART_LinSchedHeaderDone(uartId);
+            if(RESET == handled)
+            {
+                handled = UART_LinSlaveHeaderDone(uartId);
+            }
+            
+            if(uartIsrCb[uartId][UART_INT_HEADER_DONE] != NULL)
+            {
+                /* call the callback function */
+                uartIsrCb[uartId][UART_INT_HEADER_DONE]();
+            }
+            /* Disable the interrupt if callback function is not setup */
+            else if(RESET == handled)
+            {
+                UARTx->UART_DLH_IER.UART_IER.HEADER_DONE_INT_EN = 0U;
+            }   
+            else
+            {
+                /* the LIN engines keep the interrupt enabled */
+            }
+        }
+    }
+    
+    if(UARTx->UART_DLH_IER.UART_IER.RSP_DONE_INT_EN == 1U)
+    {
+        /* LIN respnse done interrupt*/
+        if((UART_LIN_RSP_DONE_FLAG & uartLineStatusBuf[uartId]) != 0U)
+        {
+            handled = UART_LinSchedRspDone(uartId);
+            if(RESET == handled)
+            {
+                handled = UART_LinSlaveRspDone(uartId);
+            }
+            
+            if(uartIsrCb[uartId][UART_INT_RSP_DONE] != NULL)
+            {
+                /* call the callback function */
+                uartIsrCb[uartId][UART_INT_RSP_DONE]();
+            }
+            /* Disable the interrupt if callback function is not setup */
+            else if(RESET == handled)
+            {
+                UARTx->UART_DLH_IER.UART_IER.RSP_DONE_INT_EN = 0U;
+            }  
+            else
+            {
+                /* the LIN engines keep the interrupt enabled */
+            }
+        }
+    }
+    
+    if(UARTx->UART_DLH_IER.UART_IER.ELSI == 1U)
+    {
+        /* UART line status interrupt */
+        if((UART_LSI_INT_FLAG & uartLineStatusBuf[uartId]) != 0U)
+        {
+            if(uartIsrCb[uartId][UART_INT_LSI] != NULL)
+            {
+                /* call the callback function */
+                uartIsrCb[uartId][UART_INT_LSI]();
+            }
+            /* Disable the interrupt if callback function is not setup */
+            else
+            {
+                UARTx->UART_DLH_IER.UART_IER.ELSI = 0U;
+            } 
+        }
+    }
+    
+    if( UARTx->UART_DLH_IER.UART_IER.ASYNC_INT_EN == 1U)
+    {
+        /* UART_LIN async interrupt */
+        if((UART_LIN_ASYNC_INT_FLAG & uartLineStatusBuf[uartId]) != 0U )
+        {
+            if(uartIsrCb[uartId][UART_INT_ASYNC] != NULL)
+            {
+                /* call the callback function */
+                uartIsrCb[uartId][UART_INT_ASYNC]();
+            }
+            /* Disable the interrupt if callback function is not setup */
+            else
+            {
+                UARTx->UART_DLH_IER.UART_IER.ASYNC_INT_EN = 0U;
+            }
+        }    
+    }
+    
+    /* Get the BF related pointer */
+    intId = UARTx->UART_IIR_FCR.UART_IIR.IID;  
+    
+    switch(intId)
+    {
+        case UART_INTSTA_IID_RBFI:
+            if((uartFifoControlBuf[uartId] & UART_ENABLE_FIFO) != 0U)
+            {
+                rxBurst = uartRxFifoLevelTable[(uartFifoControlBuf[uartId] >> 
+                                                UART_FCR_RT_SHIFT) & UART_FCR_LVL_MASK];
+            }
+            
+            if(uartDma[uartId].rxBuf != NULL)
+            {
+                /* the RX DMA channel drains the FIFO */
+                handled = SET;
+            }
+            else
+            {
+                handled = UART_BufferedRxHandler(uartId, rxBurst);
+            }
+            
+            if(uartIsrCb[uartId][UART_INT_RBFI] != NULL)
+            {
+                /* call the callback function */
+                uartIsrCb[uartId][UART_INT_RBFI]();
+            }
+            /* Disable the interrupt if callback function is not setup */
+            else if(RESET == handled)
+            {
+                UARTx->UART_DLH_IER.UART_IER.ERBFI = 0U;
+            }
+            else
+            {
+                /* buffered RX keeps the interrupt enabled */
+            }
+            break;
+            
+        /* Transmit holding register empty interrupt */
+        case UART_INTSTA_IID_TBEI:
+            handled = UART_BufferedTxHandler(uartId);
+            
+            if(uartIsrCb[uartId][UART_INT_TBEI] != NULL)
+            {
+                /* call the callback function */
+                uartIsrCb[uartId][UART_INT_TBEI]();
+            }
+            /* Disable the interrupt if callback function is not setup */
+            else if(RESET == handled)
+            {
+                UARTx->UART_DLH_IER.UART_IER.ETBEI = 0U;
+            }
+            else
+            {
+                /* buffered TX masks the interrupt when the ring is empty */
+            }
+            break;
+
+        /* Busy detect indication */
+        case UART_INTSTA_IID_BYDET:  
+            /* Clear it by reading the UART status register */
+            dummyData = UARTxw->UART_USR;
+            if(uartIsrCb[uartId][UART_INT_BYDET] != NULL)
+            {
+                /* call the callback function */
+                uartIsrCb[uartId][UART_INT_BYDET]();
+            }
+            /* Disable the interrupt if callback function is not setup */
+            else
+            {
+                UARTx->UART_DLH_IER.UART_IER.ERBFI = 0U;
+            }            
+            break;
+
+        /* Character timeout indication */
+        case UART_INTSTA_IID_RCVRTO:
+            /* Buffered RX clears it by draining the RX FIFO, in DMA RX mode
+               it reports an idle line */
+            handled = UART_DmaRxIdleHandler(uartId);
+            
+            if(RESET == handled)
+            {
+                handled = UART_BufferedRxHandler(uartId, 0U);
+            }
+            
+            if(uartIsrCb[uartId][UART_INT_RCVRTO] != NULL)
+            {
+                /* call the callback function */
+                uartIsrCb[uartId][UART_INT_RCVRTO]();
+            }
+            /* Disable the interrupt if callback function is not setup */
+            else if(RESET == handled)
+            {
+                UARTx->UART_DLH_IER.UART_IER.ERBFI = 0U;
+            }
+            else
+            {
+                /* buffered RX keeps the interrupt enabled */
+            }
+            
+            if(RESET == handled)
+            {
+                /* Clear it by reading the UART receive register */
+                dummyData = UARTxw ->UART_RBR_THR_DLL.UART_RBR;
+            }
+            break;
+            
+        case UART_INTSTA_IID_MODEM:
+            /* Clear it by reading the UART status register */
+            dummyData = UARTxw->UART_MSR;
+            if(uartIsrCb[uartId][UART_INT_MODEM] != NULL)
+            {
+                /* call the callback function */
+                uartIsrCb[uartId][UART_INT_MODEM]();
+            }
+            /* Disable the interrupt if callback function is not setup */
+            else
+            {
+                UARTx->UART_DLH_IER.UART_IER.EDSSI = 0U;
+            }             
+            break;
+            
+        default:
+            /*nothing to do*/
+            break;
+    }
+    
+    uartLineStatusBuf[uartId] = 0;
+
+    COMMON_DSB();
+}
+/** @} end of group UART_Private_Functions */
+
+/** @defgroup UART_Public_Functions
+ *  @{
+ */
+/**
+ * @brief      install call back function
+ *
+ * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  intType: select the interrupt
+ * @param[in]  cbFun: pointer to callback function
+ *
+ * @return     none
+ *
+ */
+void UART_InstallCallBackFunc(UART_ID_t uartId, UART_Int_t intType,
+                              isr_cb_t * cbFun)
+{
+    uartIsrCb[uartId][intType] = cbFun;
+}
+
+/**
+ * @brief      Get line status buffer in interrupt call back functions. The line 
+ *             status will be stored into line status buffer in UART_IRQHandler.
+ *             If the call back functions which are installed through 
+ *             UART_InstallCallBackFunc()  needs to get the line status, please 
+ *             use this function instead of UART_GetAllLineStatus or 
+ *             UART_GetLineStatus.
+ *
+ * @param[in]  uartId: Select the UART port,should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     linestatus
+ *
+ */
+uint32_t UART_GetLineStatusBufForCbf(UART_ID_t uartId)
+{        
+    return uartLineStatusBuf[uartId];
+}
+
+/**
  * @brief      Initializes the UART
  *
- * @param[in]  uartId:  Select the UART port,should be UART0_ID, UART1_ID,
+ * @param[in]  uartId:  Select the UART port,should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  uartConfig:  Pointer to a UART configuration structure
+ *
+ * @return     none
+ *
+ */
+void UART_Init(UART_ID_t uartId, const UART_Config_t* uartConfig)
+{
+    uint32_t integerDiv, fractionalDiv;
+    CLK_Module_t clk[] = {CLK_UART0,CLK_UART1,CLK_UART2,CLK_UART3,CLK_UART4, 
+                           CLK_UART5};
+    CLK_Module_t uartClkId = clk[uartId];
+    uint32_t clkFreq = CLK_GetModuleClkFreq(uartClkId, uartConfig->oscFreq);
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+
+  /************Configure the Baud Rate*********************************/
+
+    /* Enable DLAB to set baud rate */
+    UARTx->UART_LCR.DLAB = 0x01U;
+
+    /* get integer baudrate divisor*/
+    integerDiv = clkFreq/(16U * uartConfig->baudRate);
+
+    /* Config the DLL and DLH registers */
+    UARTx->UART_RBR_THR_DLL.UART_DLL.DL_L = integerDiv & 0xFFU;
+    UARTx->UART_DLH_IER.UART_DLH.DL_H = (integerDiv >> 0x08U)& 0xFFU;
+
+    /* calculate fractional divisor
+       divisor = clkFreq/(16*baudrate) = BRDI +BRDF
+       FD = BRDF*2^4 = 16* BRDF
+       BRDF = clkFreq%(16*baudrate)/(16*baudrate)
+       FD = clkFreq%(16*baudrate)*16/(16*baudrate)
+          = clkFreq%(16*baudrate)/baudrate  */
+    fractionalDiv = clkFreq%(16U * uartConfig->baudRate);
+    fractionalDiv /= uartConfig->baudRate;
+    UARTx->UART_FD.FD = fractionalDiv;
+
+    /* Disable DLAB */
+    UARTx->UART_LCR.DLAB = 0x0U;
+
+    if(uartConfig->parity == UART_PARITY_NONE)
+    {
+        UARTx->UART_LCR.PEN = 0x0U;
+    }
+    else if(uartConfig->parity == UART_PARITY_ODD)
+    {
+        UARTx->UART_LCR.PEN = 0x1U;
+        UARTx->UART_LCR.EPS = 0U;
+    }
+    else
+    {
+        UARTx->UART_LCR.PEN = 0x1U;
+        UARTx->UART_LCR.EPS = 1U;
+    }
+
+    /* Set UART Data Length and stop bit */
+    if(uartConfig->dataBits == UART_DATABITS_9)
+    {
+       UARTx->UART_LCR_EXT.DLS_E = 0x1U;
+    }
+    else
+    {
+        UARTx->UART_LCR.DLS = (uint32_t)uartConfig->dataBits ;
+    }
+    /* Set UART  stop bit */
+    UARTx->UART_LCR.STOP = (uint32_t)uartConfig->stopBits;
+
+    /***********Configure auto flow  *******************/
+    UARTx->UART_AFCR.AFCE = (uint32_t)uartConfig->autoFlowControl;
+
+    if(uartConfig->autoFlowControl == ENABLE)
+    {
+        UARTx->UART_AFCR.RTS = 1U;
+    }
+    else
+    {
+        UARTx->UART_AFCR.RTS = 0U;
+    }
+
+}
+
+/**
+ * @brief       Wait for UART busy bit clear
+ *
+ * @param[in]  uartId:  UART peripheral selected, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  cycle: the software cycles to be waited. User decides how many 
+ *                     cycles need to be waited.
+ * @return ResultStatus_t 
+ *                       - SUCC: busy bit is cleared
+ *                       - ERR: UART is still busy
+ *
+ */
+ResultStatus_t UART_WaitBusyClear(UART_ID_t uartId, uint32_t cycle)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    
+    ResultStatus_t ret = ERR;    
+    volatile uint32_t localcount = 0;
+    
+    while(localcount < cycle)
+    {
+        if((uint32_t)RESET == UARTx->UART_USR.BUSY)
+        {
+            ret = SUCC;
+            break;
+        }
+        
+        localcount++;
+    }   
+    
+    return ret;
+}
+
+/**
+ * @brief      Set UART rts enable 
+ *
+ * @param[in]  uartId:  UART peripheral selected, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  newState: Enable/Disable function state
+ *
+ * @return     none
+ *
+ */
+void UART_RtsEnable(UART_ID_t uartId, ControlState_t newState)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+
+    UARTx->UART_AFCR.RTS = (uint32_t)newState;
+
+}
+
+/**
+ * @brief      Set UART loopback mode
+ *
+ * @param[in]  uartId:  UART peripheral selected, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  newState: Enable/Disable function state
+ *
+ * @return     none
+ *
+ */
+void UART_SetLoopBackMode(UART_ID_t uartId, ControlState_t newState)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+
+    UARTx->UART_AFCR.LB = (uint32_t)newState;
+
+}
+
+/**
+ * @brief      Send break function, user can choose the length of break,
+ *             the length should not be less than eleven
+ *
+ * @param[in]  uartId:  UART peripheral selected, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  len:     the length of break
+ *
+ * @return     
+ *             - SUCC : break is sent
+ *             - ERR : break length is invalid
+ *
+ */
+ResultStatus_t UART_SendBreak(UART_ID_t uartId, uint8_t len)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    ResultStatus_t retVal =SUCC;
+    if(len < 0x0BU)
+    {
+        retVal = ERR;
+    }
+    else
+    {
+        UARTx->UART_LCR.LBKM = (uint32_t)len - 0xBU;
+        UARTx->UART_LCR.LBKEN = 0x1U;
+        /* send break characters */
+        UARTx->UART_LCR.BC = 0x1U;
+    }
+
+    return retVal;    
+}
+
+/**
+ * @brief      Receive one byte data from the UART peripheral
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     The received data
+ *
+ */
+uint8_t UART_ReceiveByte(UART_ID_t uartId)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+
+    /* Receive data */
+    return (uint8_t)(UARTx->UART_RBR_THR_DLL.UART_RBR.RBR_LSB);
+}
+
+/**
+ * @brief      Read received bytes from the RX FIFO
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  length:  the number of bytes to be read. When call this function,
+ *                      the user needs to make sure that the "length" is not
+ *                      greater than the number of bytes that is available in
+ *                      RX FIFO
+ * @param[out]  data:  points to the memory where the data to be stored
+ *.
+ * @return     none
+ */
+void UART_ReceiveBytes(UART_ID_t uartId,uint32_t length, uint8_t data[])
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+
+    for(uint32_t count = 0U; count <length; count++)
+    {
+        data[count] = (uint8_t)UARTx->UART_RBR_THR_DLL.UART_RBR.RBR_LSB;
+    }
+}
+
+/**
+ * @brief      Empty the RX FIFO. This function reads received data until RX
+ *             FIFO is empty
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     None
+ */
+void UART_EmptyRxFifo(UART_ID_t uartId)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+
+    volatile uint8_t dummyData;
+
+    while(((uint32_t)UART_GetLineStatus(uartId, UART_LINESTA_DR) & 0x1U) != 0U)
+    {
+        dummyData = (uint8_t)UARTx->UART_RBR_THR_DLL.UART_RBR.RBR_LSB;
+    }
+}
+
+/**
+ * @brief      Set receive 9 bits data mode 0
+ *
+ * @param[in]  uartId: Select the UART port, should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     none
+ *
+ */
+void UART_9BitsM0Rx(UART_ID_t uartId)
+{    
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    
+    if((uint32_t)SET == UARTx->UART_LCR_EXT.DLS_E)
+    {   /* Receive mode 0 */
+        UARTx->UART_LCR_EXT.ADDR_MATCH = 0x0U;        
+    }
+    else
+    {
+        /* none */
+    }
+
+}
+
+/**
+ * @brief      Program the address of  receive 9 bits data, mode 1
+ *
+ * @param[in]  uartId: Select the UART port, should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     none
+ *
+ */
+void UART_9BitsM1SetAddr(UART_ID_t uartId, uint8_t addr)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+   
+    /* set address in rar */
+    UARTx->UART_RAR.RAR = addr;
+}
+
+/**
+ * @brief      Select 9 bits hardware receive mode 1
+ *
+ * @param[in]  uartId: Select the UART port, should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     none
+ *
+ */
+void UART_9BitsHWRecvEnable(UART_ID_t uartId)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+
+    UARTx->UART_LCR_EXT.ADDR_MATCH = 0x1U;
+}
+
+/**
+ * @brief      Receive address from the UART peripheral, mode 1
+ *
+ * @param[in]  uartId: Select the UART port, should be UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     the received address
+ *
+ */
+uint16_t UART_9BitsM1RxAddr(UART_ID_t uartId)
+{
+    uint16_t ret;
+
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+
+    uint8_t rx_addr;
+    uint32_t regData;
+
+    regData = (uint32_t)UARTxw->UART_RBR_THR_DLL.UART_RBR;
+    rx_addr = (uint8_t)UARTx->UART_RAR.RAR;
+    
+
+    if(0x100U == (regData & 0x100U))
+    {
+        if((regData & 0xFFU) == rx_addr)
+        {
+            ret = (uint16_t)regData;
+        }
+        else
+        {
+            ret = (uint16_t)ERR;
+        }
+    }
+    else
+    {
+        ret = (uint16_t)ERR;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Receive one byte data from the UART peripheral, mode 1
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     The received data
+ *
+ */
+uint16_t UART_9BitsM1RxData(UART_ID_t uartId)
+{
+    uint16_t ret;
+    uint32_t regData;
+    
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    regData = (uint32_t)UARTxw->UART_RBR_THR_DLL.UART_RBR;
+    
+    if(0U == (regData & 0x100U))
+    {
+        ret = (uint16_t)(regData & 0xFFU);
+    }
+    else
+    {
+        ret = 0x1FFU;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Send one byte data to the UART peripheral
+ *
+ * @param[in]  uartId:  Select the UART port,should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  data:  The data to be sent
+ * @return     none
+ *
+ */
+void UART_SendByte(UART_ID_t uartId, uint8_t data)
+{
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    /* Send data */
+    UARTxw->UART_RBR_THR_DLL.UART_THR = (uint32_t)data;
+}
+
+/**
+ * @brief      Program the transmit target address, 9bits, mode 0
+ *
+ * @param[in]  uartId:  Select the UART port,should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  addr:  program the address
+ *
+ * @return     none
+ *
+ */
+void UART_9BitsM0SetAddr(UART_ID_t uartId, uint8_t addr)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    /* transmit mode 0 */
+    if(0x1U == UARTx->UART_LCR_EXT.DLS_E)
+    {
+        UARTx->UART_LCR_EXT.TRANSMIST_MODE = 0x0U;
+        UARTx->UART_TAR.TAR = (uint32_t)addr;
+    }
+}
+
+/**
+ * @brief      Set send address bit, mode 0
+ *
+ * @param[in]  uartId:  Select the UART port,should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     none
+ *
+ */
+void UART_9BitsM0SendAddr(UART_ID_t uartId)
+{
+    /* transmit mode 0 */
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+                
+    UARTx->UART_LCR_EXT.SEND_ADDR = 0x1U;    
+}
+
+/**
+ * @brief      Send 9 bits data to the UART peripheral, mode 1
+ *
+ * @param[in]  uartId:  Select the UART port,should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  data:  The data to be sent
+ * @return     none
+ *
+ */
+void UART_9BitsM1TxData(UART_ID_t uartId, uint16_t data)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    /* transmit mode 1 */
+    if((uint32_t)SET == UARTx->UART_LCR_EXT.DLS_E)
+    {
+        UARTx->UART_LCR_EXT.TRANSMIST_MODE = 0x1U;
+        /* Send data */
+        UARTxw->UART_RBR_THR_DLL.UART_THR = ((uint32_t)data) & 0x1FFU;
+    }
+}
+
+/**
+ * @brief      Config UART FIFO function
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  fifoConfig:  Pointer to a FIFO configuration
+ * @return     none
+ *
+ */
+void UART_FIFOConfig(UART_ID_t uartId, const UART_FIFOConfig_t * fifoConfig)
+{
+    uint32_t regValue;
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+
+    regValue =((((uint32_t)(fifoConfig->fifoRt) & 0x03U) << 6U)
+                    | (((uint32_t)(fifoConfig->fifoTet) & 0x03U) << 4U)
+                    | (((uint32_t)(fifoConfig->txFifoReset) & 0x01U) << 2U)
+                    | (((uint32_t)(fifoConfig->rxFifoReset) & 0x01U) << 1U)
+                    | ((uint32_t)(fifoConfig->fifoEnable) & 0x01U));
+
+    UARTxw->UART_IIR_FCR.UART_FCR = regValue;
+    
+    uartFifoControlBuf[uartId] = regValue; 
+    uartFifoControlBuf[uartId] &= (~(UART_RESET_RX_FIFO | UART_RESET_TX_FIFO));
+
+}
+
+/**
+ * @brief      Get UART FIFO status
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     status
+ *
+ */
+ControlState_t UART_GetFifoStatus(UART_ID_t uartId)
+{
+    ControlState_t ret;
+
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+
+    if(UARTx->UART_IIR_FCR.UART_IIR.FIFOSE == 3U)
+    {
+        ret = ENABLE;
+    }
+    else
+    {
+        ret = DISABLE;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief      Reset uart receive fifo
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     none
+ *
+ */
+void UART_ResetRxFifo(UART_ID_t uartId)
+{
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+
+    uartFifoControlBuf[uartId] |= UART_RESET_RX_FIFO;
+
+    UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
+    
+    uartFifoControlBuf[uartId] &= (~UART_RESET_RX_FIFO);
+}
+
+/**
+ * @brief      Reset uart transmit fifo
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  uartConfig:  Pointer to a UART configuration structure
+ * @return     none
+ *
+ */
+void UART_ResetTxFifo(UART_ID_t uartId)
+{
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+
+    uartFifoControlBuf[uartId] |= UART_RESET_TX_FIFO;    
+    UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
+    
+    uartFifoControlBuf[uartId] &= (~UART_RESET_TX_FIFO);
+}
+
+/**
+ * @brief      Enable/Disable debug enable. If enabled, hardware will not clean 
+ *             the recevier fifo automaticlly
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @param[in]  ControlState_t: ENABLE/DISABLE
  *
  * @return     none
  *
  */
-void UART_Init(UART_ID_t uartId, const UART_Config_t* uartConfig)
+void UART_DebugCmd(UART_ID_t uartId, ControlState_t Cmd)
 {
-    uint32_t integerDiv, fractionalDiv;
-    CLK_Module_t clk[] = {CLK_UART0,CLK_UART1,CLK_UART2,CLK_UART3,CLK_UART4, 
-                           CLK_UART5};
-    CLK_Module_t uartClkId = clk[uartId];
-    uint32_t clkFreq = CLK_GetModuleClkFreq(uartClkId, uartConfig->oscFreq);
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    
+    UARTx->UART_LCR.DEBUG_EN = (uint32_t)Cmd;
+}
 
-  /************Configure the Baud Rate*********************************/
+/**
+ * @brief      idle detect config
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @param[in]  config: config idle detect 
+ *
+ * @return     none
+ *
+ */
+void UART_IdleDetectConfig(UART_ID_t uartId,UART_IdleDetectConfig_t *config)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+        
+    UARTx->UART_LCR.IDLE_DET_LENGTH = (uint32_t)config->len;
+    UARTx->UART_LCR.IDLE_DET_EN = (uint32_t)config->Cmd;
+}
+
+/**
+ * @brief      Config UART in LIN mode
+ * @param[in]  uartId:  Select the UART port. It should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  config:  points to the configuration of LIN mode
+ * @return     none
+ */
+void UART_LinConfig(UART_ID_t uartId, const UART_LinConfig_t *config)
+{
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    
+    uint32_t integerDiv, fractionalDiv;
+    CLK_Module_t clk[] = {CLK_UART0,CLK_UART1,CLK_UART2,CLK_UART3,CLK_UART4,
+                          CLK_UART5};
+    CLK_Module_t uartClkId = clk[uartId];
+    uint32_t tmp;
 
     /* Enable DLAB to set baud rate */
     UARTx->UART_LCR.DLAB = 0x01U;
-
-    /* get integer baudrate divisor*/
-    integerDiv = clkFreq/(16U * uartConfig->baudRate);
+    tmp = CLK_GetModuleClkFreq(uartClkId, config->oscFreq);
+    
+     /* get baudrate divisor*/
+    integerDiv = tmp/(16U * config->baudRate);
 
     /* Config the DLL and DLH registers */
     UARTx->UART_RBR_THR_DLL.UART_DLL.DL_L = integerDiv & 0xFFU;
@@ -461,1197 +1679,1469 @@ void UART_Init(UART_ID_t uartId, const UART_Config_t* uartConfig)
        BRDF = clkFreq%(16*baudrate)/(16*baudrate)
        FD = clkFreq%(16*baudrate)*16/(16*baudrate)
           = clkFreq%(16*baudrate)/baudrate  */
-    fractionalDiv = clkFreq%(16U * uartConfig->baudRate);
-    fractionalDiv /= uartConfig->baudRate;
+    fractionalDiv = tmp%(16U * config->baudRate);
+    fractionalDiv /= config->baudRate;
     UARTx->UART_FD.FD = fractionalDiv;
-
+    
     /* Disable DLAB */
     UARTx->UART_LCR.DLAB = 0x0U;
+    /* no parity */
+    UARTx->UART_LCR.PEN = 0x0U;
 
-    if(uartConfig->parity == UART_PARITY_NONE)
-    {
-        UARTx->UART_LCR.PEN = 0x0U;
-    }
-    else if(uartConfig->parity == UART_PARITY_ODD)
-    {
-        UARTx->UART_LCR.PEN = 0x1U;
-        UARTx->UART_LCR.EPS = 0U;
-    }
-    else
-    {
-        UARTx->UART_LCR.PEN = 0x1U;
-        UARTx->UART_LCR.EPS = 1U;
-    }
+    /* 8 bits */
+    UARTx->UART_LCR.DLS = 3U ;
 
-    /* Set UART Data Length and stop bit */
-    if(uartConfig->dataBits == UART_DATABITS_9)
-    {
-       UARTx->UART_LCR_EXT.DLS_E = 0x1U;
-    }
-    else
-    {
-        UARTx->UART_LCR.DLS = (uint32_t)uartConfig->dataBits ;
-    }
-    /* Set UART  stop bit */
-    UARTx->UART_LCR.STOP = (uint32_t)uartConfig->stopBits;
+    /* 1 stop bit */
+    UARTx->UART_LCR.STOP = 0U;
 
-    /***********Configure auto flow  *******************/
-    UARTx->UART_AFCR.AFCE = (uint32_t)uartConfig->autoFlowControl;
+    UARTx->UART_AFCR.RTS = 0U;
 
-    if(uartConfig->autoFlowControl == ENABLE)
+    /* LIN mode */
+    UARTx->UART_LIN_CTL.LIN_MODE = 1U;
+    UARTx->UART_LIN_CTL.MASTER_MODE = (uint32_t)config->mode;
+
+    /* auto sync */
+    UARTx->UART_LCR.AUTO_SYNC_EN = (uint32_t)config->autoSyncEn;
+ 
+    /* ID filter enable */
+    UARTx->UART_LIN_PID_FILTER_CTRL.LIN_FILTER_EN = (uint32_t)config->idFilterEn;
+    
+    /* enable and clear FIFO in LIN mode */
+    uartFifoControlBuf[uartId] |= UART_ENABLE_FIFO;
+    
+    UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
+    
+    uartFifoControlBuf[uartId] |= ( UART_RESET_TX_FIFO | UART_RESET_RX_FIFO);
+    
+    UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
+    
+    uartFifoControlBuf[uartId] &= ( ~ (UART_RESET_TX_FIFO | UART_RESET_RX_FIFO));
+
+}
+
+/**
+ * @brief      Set UART in LIN mode as a LIN master and start to send the header
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  header:  points to the header to be send
+ * @return     status
+ *             - SUCC : header is sent
+ *             - ERR : header is not sent due to UART is busy
+ */
+ResultStatus_t UART_LinSendHeader(UART_ID_t uartId, 
+                                           const UART_LinHeader_t *header)
+{
+    ResultStatus_t ret;
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+
+    uint32_t breakLen;
+    uint32_t rsp_op_start = UARTx->UART_LIN_CTL.RSP_OP_START;
+    uint32_t header_op_start = UARTx->UART_LIN_CTL.HEADER_OP_START;
+
+    /* check if UART is busy */
+    if( (rsp_op_start != 0U) || (header_op_start != 0U) )
     {
-        UARTx->UART_AFCR.RTS = 1U;
+        ret = ERR;
     }
     else
     {
-        UARTx->UART_AFCR.RTS = 0U;
+        UARTx->UART_LIN_DEL_LENGTH.LIN_DEL_LENGTH = header->deleLen - 1U;
+        UARTx->UART_LIN_PID_VALUE.PID = header->id;    
+
+        breakLen = ((header->breakLen) >= UART_LIN_SEND_BREAK_MIN)?(
+                           (header->breakLen) - UART_LIN_SEND_BREAK_THR):
+                           (UART_LIN_SEND_BREAK_MIN - UART_LIN_SEND_BREAK_THR);                
+                           
+        if(breakLen != UARTx->UART_LCR.LBKM )
+        {
+            UARTx->UART_LCR.LBKM = breakLen;
+        }
+        else
+        {
+            /* Nothing to do */
+        }
+        UARTx->UART_LIN_CTL.MASTER_MODE = 1U;
+        /* start to send */
+        UARTx->UART_LIN_CTL.HEADER_OP_START = 1U;
+
+        ret = SUCC;
     }
 
+    return ret;
 }
 
 /**
- * @brief       Wait for UART busy bit clear
- *
- * @param[in]  uartId:  UART peripheral selected, should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  cycle: the software cycles to be waited. User decides how many 
- *                     cycles need to be waited.
- * @return ResultStatus_t 
- *                       - SUCC: busy bit is cleared
- *                       - ERR: UART is still busy
+ * @brief       This function stops receiving/sending header/response of LIN. 
  *
+ * @param[in]   uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *                     
+ * @return     none
  */
-ResultStatus_t UART_WaitBusyClear(UART_ID_t uartId, uint32_t cycle)
+void UART_LinStopTransmission(UART_ID_t uartId)
 {
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
     
-    ResultStatus_t ret = ERR;    
-    volatile uint32_t localcount = 0;
+    UARTx->UART_LIN_CTL.RSP_OP_START = 0U;
     
-    while(localcount < cycle)
+    UARTx->UART_LIN_CTL.HEADER_OP_START = 0U;
+    
+}
+
+/**
+ * @brief       If LIN is sending/receiving header/response
+ *                this function returns SET, otherwise, return RESET.
+ *
+ * @param[in]   uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *                     
+ * @return     SET/RESET
+ */
+FlagStatus_t UART_LinGetTransmissionStatus(UART_ID_t uartId)
+{
+    FlagStatus_t ret = RESET;
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    
+    uint32_t rsp_op_start = UARTx->UART_LIN_CTL.RSP_OP_START;
+    uint32_t header_op_start = UARTx->UART_LIN_CTL.HEADER_OP_START;
+
+    /* check if UART is busy */
+    if( (rsp_op_start != 0U) || (header_op_start != 0U) )
     {
-        if((uint32_t)RESET == UARTx->UART_USR.BUSY)
-        {
-            ret = SUCC;
-            break;
-        }
-        
-        localcount++;
-    }   
+        ret = SET;
+    }
+    else
+    {
+        /* nothing */
+    }
     
     return ret;
 }
 
 /**
- * @brief      Set UART rts enable 
- *
- * @param[in]  uartId:  UART peripheral selected, should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  newState: Enable/Disable function state
- *
- * @return     none
+ * @brief      Set LIN as a slave and start to receive a header.
+ *             FIFO is disabled before it starts to receive a header
  *
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     
+ *            - SUCC : it starts to receive header
+ *            - ERR : it dose not start to receive header due to UART is busy
  */
-void UART_RtsEnable(UART_ID_t uartId, ControlState_t newState)
+ResultStatus_t UART_LinStartReceiveHeader(UART_ID_t uartId)
 {
+    ResultStatus_t ret;
+    volatile uint32_t dummyData;
+    
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+         
+    uint32_t rsp_op_start = UARTx->UART_LIN_CTL.RSP_OP_START;
+    uint32_t header_op_start = UARTx->UART_LIN_CTL.HEADER_OP_START;
+    
+    /* check if UART is busy */
+    if( (rsp_op_start != 0U) || (header_op_start != 0U) )
+    {
+        ret = ERR;
+    }
+    else
+    {       
+        /* reset rx fifo then disable fifo */
+        uartFifoControlBuf[uartId] |= UART_RESET_RX_FIFO;
+        UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];        
+        uartFifoControlBuf[uartId] &= (~UART_RESET_RX_FIFO);
+        
+        uartFifoControlBuf[uartId] &= ~UART_ENABLE_FIFO;            
+        UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
 
-    UARTx->UART_AFCR.RTS = (uint32_t)newState;
+        UARTx->UART_LIN_CTL.MASTER_MODE = 0U;
+        /* read LSR to clear  BI and FE*/
+        dummyData = UARTxw->UART_LSR;
+        /* start to receive */
+        UARTx->UART_LIN_CTL.HEADER_OP_START = 1U;
 
+        ret = SUCC;
+    }
+
+    return ret;
 }
 
 /**
- * @brief      Set UART loopback mode
- *
- * @param[in]  uartId:  UART peripheral selected, should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  newState: Enable/Disable function state
- *
- * @return     none
- *
+ * @brief      read the 6-bit ID(exclude parity bits) of header
+ * @param[in]  uartId:  Select the UART port.UART0_ID, UART1_ID,
+ *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @return     ID
  */
-void UART_SetLoopBackMode(UART_ID_t uartId, ControlState_t newState)
+uint32_t UART_LinGetId(UART_ID_t uartId)
 {
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
 
-    UARTx->UART_AFCR.LB = (uint32_t)newState;
-
+    return UARTx->UART_LIN_PID_VALUE.PID;
 }
 
 /**
- * @brief      Send break function, user can choose the length of break,
- *             the length should not be less than eleven
- *
- * @param[in]  uartId:  UART peripheral selected, should be UART0_ID, UART1_ID,
+ * @brief      start to send a response
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  len:     the length of break
- *
- * @return     
- *             - SUCC : break is sent
- *             - ERR : break length is invalid
- *
+ * @param[in]  rsp:  Points to reponse structure to be sent.
+ * @return
+ *             - SUCC : response is sent
+ *             - ERR : resoponse is not sent due to UART is busy
  */
-ResultStatus_t UART_SendBreak(UART_ID_t uartId, uint8_t len)
+ResultStatus_t UART_LinSendResponse(UART_ID_t uartId,
+                                    const UART_LinResponse_t *rsp)
 {
+    ResultStatus_t ret;
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-    ResultStatus_t retVal =SUCC;
-    if(len < 0x0BU)
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+
+    uint32_t rsp_op_start = UARTx->UART_LIN_CTL.RSP_OP_START;
+    uint32_t header_op_start = UARTx->UART_LIN_CTL.HEADER_OP_START;
+
+    if((rsp->len > 8U) || ( (rsp_op_start != 0U)|| (header_op_start != 0U)))
     {
-        retVal = ERR;
+        ret = ERR;
     }
     else
     {
-        UARTx->UART_LCR.LBKM = (uint32_t)len - 0xBU;
-        UARTx->UART_LCR.LBKEN = 0x1U;
-        /* send break characters */
-        UARTx->UART_LCR.BC = 0x1U;
+        /* enable fifo  */
+        uartFifoControlBuf[uartId] |= UART_ENABLE_FIFO;
+        UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
+        
+        UARTx->UART_LIN_RSP_LENGTH.RSP_LENGTH = rsp->len;
+        UARTx->UART_LIN_CHECKSUM.CHECKSUM_TYPE = (uint32_t)rsp->checkType;
+
+        for(uint32_t count = 0U; count < rsp->len; count++)
+        {
+            UARTxw->UART_RBR_THR_DLL.UART_THR = rsp->data[count];
+        }
+
+        UARTx->UART_LIN_CTL.RSP_DIR = 1U;
+
+        UARTx->UART_LIN_CTL.RSP_OP_START = 1U;
+
+        ret = SUCC;
     }
 
-    return retVal;    
+    return ret;
 }
 
 /**
- * @brief      Receive one byte data from the UART peripheral
- *
- * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ * @brief      start to receive a response
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- *
- * @return     The received data
- *
+ * @param[in]  check:  checksum type.
+ * @param[in]  len:  response length.
+ * @return
+ *            - SUCC : it starts to receive response
+ *            - ERR : it dose not start to receive response due to UART is busy
  */
-uint8_t UART_ReceiveByte(UART_ID_t uartId)
+ResultStatus_t UART_LinStartReceiveResponse(UART_ID_t uartId,
+                                            UART_LinCheckSum_t check,
+                                            uint32_t len)
 {
+    ResultStatus_t ret;
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    
+    uint32_t rsp_op_start = UARTx->UART_LIN_CTL.RSP_OP_START;
+    uint32_t header_op_start = UARTx->UART_LIN_CTL.HEADER_OP_START;
 
-    /* Receive data */
-    return (uint8_t)(UARTx->UART_RBR_THR_DLL.UART_RBR.RBR_LSB);
+    /* check if UART is busy */
+    if((rsp_op_start != 0U) || (header_op_start !=0U))
+    {
+        ret = ERR;
+    }
+    else
+    {
+        /* enable fifo and reset rx fifo */
+        uartFifoControlBuf[uartId] |= UART_ENABLE_FIFO;
+        UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
+        
+        /* reset RX FIFO */
+        UART_ResetRxFifo(uartId);
+
+        UARTx->UART_LIN_RSP_LENGTH.RSP_LENGTH = len;
+        UARTx->UART_LIN_CHECKSUM.CHECKSUM_TYPE = (uint32_t)check;
+
+        UARTx->UART_LIN_CTL.RSP_DIR = 0U;
+
+        UARTx->UART_LIN_CTL.RSP_OP_START = 1U;
+
+        ret = SUCC;
+    }
+    return ret;
 }
 
 /**
- * @brief      Read received bytes from the RX FIFO
- * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ * @brief      read a response. if a reponse is received, this function can be
+ *             called to get the data of response. This function is called
+ *             after UART_LinStartReceiveResponse() and UART_INTSTA_RSP_DONE
+ *             status is set.
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  length:  the number of bytes to be read. When call this function,
- *                      the user needs to make sure that the "length" is not
- *                      greater than the number of bytes that is available in
- *                      RX FIFO
- * @param[out]  data:  points to the memory where the data to be stored
- *.
+ * @param[in]  len:  response length to be read.
+ * @param[in]  data:  points to the memory where the response data to be stored.
+ *                    the memory size must not be smaller than len
  * @return     none
  */
-void UART_ReceiveBytes(UART_ID_t uartId,uint32_t length, uint8_t data[])
+void UART_LinReadResponse(UART_ID_t uartId, uint32_t len, uint8_t data[])
 {
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
 
-    for(uint32_t count = 0U; count <length; count++)
+    for(uint32_t count = 0U; count < len; count++)
     {
         data[count] = (uint8_t)UARTx->UART_RBR_THR_DLL.UART_RBR.RBR_LSB;
     }
 }
 
 /**
- * @brief      Empty the RX FIFO. This function reads received data until RX
- *             FIFO is empty
+ * @brief      Get current value of Line Status register
+ *
  * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+* @param[in]  lineStatus:
+ *                       - UART_LINESTA_DR
+ *                       - UART_LINESTA_OE
+ *                       - UART_LINESTA_PE
+ *                       - UART_LINESTA_FE
+ *                       - UART_LINESTA_BI
+ *                       - UART_LINESTA_THRE
+ *                       - UART_LINESTA_TEMT
+ *                       - UART_LINESTA_RFE
+ *                       - UART_LINESTA_TRANS_ERR
+ *                       - UART_LINESTA_ADDR_RCVD
+ *                       - UART_LINESTA_ASYNC
+ *                       - UART_LINESTA_FIELD_ERR
+ *                       - UART_LINESTA_PID_ERR
+ *                       - UART_LINESTA_CHECKSUM_ERR
+ *                       - UART_LINESTA_TO_ERR
+ *                       - UART_LINESTA_HEADER_DONE
+ *                       - UART_LINESTA_RSP_DONE
+ *
+ * @note       This function returns only one line status. However,  once call 
+ *             this function, all line status will be cleared. If user
+ *             needs to read more than one line status, it is suggested to use 
+ *             UART_GetAllLineStatus() to get all line status and handle them 
+ *             one by one.
+ *
+ * @return     The state value of UART Line Status register
  *
- * @return     None
  */
-void UART_EmptyRxFifo(UART_ID_t uartId)
+FlagStatus_t UART_GetLineStatus(UART_ID_t uartId, UART_LineStatus_t lineStatus)
 {
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+    FlagStatus_t bitStatus;
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
 
-    volatile uint8_t dummyData;
+    bitStatus = (((UARTxw->UART_LSR & uartLineStatusTable[lineStatus]) != 0U) 
+                  ? SET : RESET);
 
-    while(((uint32_t)UART_GetLineStatus(uartId, UART_LINESTA_DR) & 0x1U) != 0U)
-    {
-        dummyData = (uint8_t)UARTx->UART_RBR_THR_DLL.UART_RBR.RBR_LSB;
-    }
+    return bitStatus;
 }
 
 /**
- * @brief      Set receive 9 bits data mode 0
+ * @brief      Get all Line Status 
  *
- * @param[in]  uartId: Select the UART port, should be UART0_ID, UART1_ID,
- *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @return     none
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * 
+ * @note       Once call the function, line status will be cleared
+ *
+ * @return     The state value of UART Line Status register
  *
  */
-void UART_9BitsM0Rx(UART_ID_t uartId)
-{    
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+uint32_t UART_GetAllLineStatus(UART_ID_t uartId)
+{
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
     
-    if((uint32_t)SET == UARTx->UART_LCR_EXT.DLS_E)
-    {   /* Receive mode 0 */
-        UARTx->UART_LCR_EXT.ADDR_MATCH = 0x0U;        
-    }
-    else
-    {
-        /* none */
-    }
-
+    uint32_t ret;
+    
+    ret = (uint32_t)UARTxw->UART_LSR & (uint32_t)0xFFFF;
+    
+    return ret;
 }
 
 /**
- * @brief      Program the address of  receive 9 bits data, mode 1
+ * @brief      Get busy status
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
  *
- * @param[in]  uartId: Select the UART port, should be UART0_ID, UART1_ID,
- *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @return     none
+ * @return     The busy Status
  *
  */
-void UART_9BitsM1SetAddr(UART_ID_t uartId, uint8_t addr)
+FlagStatus_t UART_GetBusyStatus(UART_ID_t uartId)
 {
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-   
-    /* set address in rar */
-    UARTx->UART_RAR.RAR = addr;
+
+    return (UARTx->UART_USR.BUSY != 0U) ? SET : RESET;
 }
 
 /**
- * @brief      Select 9 bits hardware receive mode 1
+ * @brief      Get current UART interrupt Status, except async status
  *
- * @param[in]  uartId: Select the UART port, should be UART0_ID, UART1_ID,
- *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @return     none
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  intType: select one interrupt
+ *
+ * @note       If only need async status, can use UART_GetLineStatus function.
+ *             
+ * @return     The state value of UART Status register
  *
  */
-void UART_9BitsHWRecvEnable(UART_ID_t uartId)
+IntStatus_t UART_GetIntStatus(UART_ID_t uartId, UART_Int_t intType)
 {
+    IntStatus_t bitStatus;
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+   
+    bitStatus = ((UARTx->UART_IIR_FCR.UART_IIR.IID ==
+                      uartInterruptStatusTable[intType] ) ? SET : RESET);  
 
-    UARTx->UART_LCR_EXT.ADDR_MATCH = 0x1U;
+    return bitStatus;
 }
 
 /**
- * @brief      Receive address from the UART peripheral, mode 1
+* @brief     Mask/Unmask the UART interrupt
+ *            UART_INT_RCVRTO and UART_INT_RBFI are controlled by the same bit,
+ *            so they are masked/unmasked at the same time. But UART_INT_RCVRTO
+ *            is only generated when it in fifo mode and fifo is enabled
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  intType:  Specifies the interrupt type
+ * @param[in]  intMask:  Enable/Disable Specified interrupt type
  *
- * @param[in]  uartId: Select the UART port, should be UART0_ID, UART1_ID,
- *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @return     the received address
+ * @return     none
  *
  */
-uint16_t UART_9BitsM1RxAddr(UART_ID_t uartId)
+void UART_IntMask(UART_ID_t uartId, UART_Int_t intType, IntMask_t intMask)
 {
-    uint16_t ret;
-
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
     uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
 
-    uint8_t rx_addr;
-    uint32_t regData;
-
-    regData = (uint32_t)UARTxw->UART_RBR_THR_DLL.UART_RBR;
-    rx_addr = (uint8_t)UARTx->UART_RAR.RAR;
-    
-
-    if(0x100U == (regData & 0x100U))
+    if(intMask == UNMASK)
     {
-        if((regData & 0xFFU) == rx_addr)
-        {
-            ret = (uint16_t)regData;
-        }
-        else
-        {
-            ret = (uint16_t)ERR;
-        }
+        UARTxw->UART_DLH_IER.UART_IER  |= (uartInterruptMaskTable[intType]);
     }
     else
     {
-        ret = (uint16_t)ERR;
+        UARTxw->UART_DLH_IER.UART_IER &= (~(uartInterruptMaskTable[intType]));
     }
-
-    return ret;
 }
 
 /**
- * @brief      Receive one byte data from the UART peripheral, mode 1
- *
- * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @return     The received data
+ * @brief      Enable a ID filter and config the ID filter value
+ * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID
+ * @param[in]  idIndex:  the index of ID filter. It indicates which ID filter
+ *                       will be enabled. Its range is 0-15
+ * @param[in]  idFilterValue:  the value of ID filter.
+ * @return
+ *            - SUCC
+ *            - ERR : parameter error
  *
  */
-uint16_t UART_9BitsM1RxData(UART_ID_t uartId)
+ResultStatus_t UART_LinEnableIdFilter(UART_ID_t uartId, uint8_t idIndex,
+                                      uint8_t idFilterValue)
 {
-    uint16_t ret;
-    uint32_t regData;
-    
+    ResultStatus_t ret;
+    volatile uint32_t* idFilterP[4];
+    volatile uint32_t regTmp;
+    uint32_t tmp;
+    uint32_t idInd = (uint32_t)idIndex;
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
     uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-    regData = (uint32_t)UARTxw->UART_RBR_THR_DLL.UART_RBR;
+
+    idFilterP[0] = &(UARTxw->UART_LIN_PID_FILTER_0);
+    idFilterP[1] = &(UARTxw->UART_LIN_PID_FILTER_1);
+    idFilterP[2] = &(UARTxw->UART_LIN_PID_FILTER_2);
+    idFilterP[3] = &(UARTxw->UART_LIN_PID_FILTER_3);
     
-    if(0U == (regData & 0x100U))
+    if(idInd >= 16U)
     {
-        ret = (uint16_t)(regData & 0xFFU);
+        ret = ERR;
     }
     else
     {
-        ret = 0x1FFU;
-    }
+        tmp = (idInd%4U)*8U;
+        regTmp = *idFilterP[idInd/4UL] & ~(0x3FUL << tmp);
+        *idFilterP[idInd/4U] = regTmp | ((uint32_t)idFilterValue << tmp);
+        UARTx->UART_LIN_PID_FILTER_CTRL.FID_MASK |= (1UL << idInd);
 
+        ret = SUCC;
+    }
+    
     return ret;
 }
 
 /**
- * @brief      Send one byte data to the UART peripheral
- *
- * @param[in]  uartId:  Select the UART port,should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  data:  The data to be sent
- * @return     none
+ * @brief      Disable a ID filter
+ * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID
+ * @param[in]  idIndex:  the index of ID filter. It indicates which ID filter
+ *                       will be disabled. Its range is 0-15
+ * @return
+ *            - SUCC
+ *            - ERR : parameter error
  *
  */
-void UART_SendByte(UART_ID_t uartId, uint8_t data)
+ResultStatus_t UART_LinDisableIdFilter(UART_ID_t uartId, uint32_t idIndex)
 {
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-    /* Send data */
-    UARTxw->UART_RBR_THR_DLL.UART_THR = (uint32_t)data;
+    ResultStatus_t ret;
+    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
+
+    if(idIndex >= 16U)
+    {
+        ret = ERR;
+    }
+    else
+    {
+        UARTx->UART_LIN_PID_FILTER_CTRL.FID_MASK &= ~(1UL << idIndex);
+        ret = SUCC;
+    }
+    return ret;
 }
 
 /**
- * @brief      Program the transmit target address, 9bits, mode 0
- *
- * @param[in]  uartId:  Select the UART port,should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  addr:  program the address
- *
+ * @brief      Enable and config the ID vague filter
+ * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID
+ * @param[in]  idFilterValue:  the value of ID filter. It is range is 0 - 0x3F.
+ * @param[in]  idFilterMask:  the mask of the vague ID filter. If a bit of
+ *                            idFilterMask is 0, this bit in the vague ID filter
+ *                            is ignored. Only bit0-5 is valid.
  * @return     none
  *
  */
-void UART_9BitsM0SetAddr(UART_ID_t uartId, uint8_t addr)
+void UART_LinEnableVagueIdFilter(UART_ID_t uartId,
+                                           uint8_t idFilterValue,
+                                           uint8_t idFilterMask)
 {
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-    /* transmit mode 0 */
-    if(0x1U == UARTx->UART_LCR_EXT.DLS_E)
-    {
-        UARTx->UART_LCR_EXT.TRANSMIST_MODE = 0x0U;
-        UARTx->UART_TAR.TAR = (uint32_t)addr;
-    }
+
+    UARTx->UART_LIN_PID_FILTER_VAGUE.FID_VAGUE = idFilterValue;
+    UARTx->UART_LIN_PID_FILTER_CTRL.FID_VAGUE_MASK = idFilterMask;
+    UARTx->UART_LIN_PID_FILTER_CTRL.FID_MASK |= ((uint32_t)1U << 16U);
 }
 
 /**
- * @brief      Set send address bit, mode 0
- *
- * @param[in]  uartId:  Select the UART port,should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @brief      Disable the vague ID filter
+ * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID
  * @return     none
  *
  */
-void UART_9BitsM0SendAddr(UART_ID_t uartId)
+void UART_LinDisableVagueIdFilter(UART_ID_t uartId)
 {
-    /* transmit mode 0 */
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-                
-    UARTx->UART_LCR_EXT.SEND_ADDR = 0x1U;    
+
+    UARTx->UART_LIN_PID_FILTER_CTRL.FID_MASK &= ~((uint32_t)1U << 16U);
 }
 
 /**
- * @brief      Send 9 bits data to the UART peripheral, mode 1
- *
- * @param[in]  uartId:  Select the UART port,should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  data:  The data to be sent
- * @return     none
+ * @brief      Enable/Disable ID filters
+ * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID
+ * @param[in]  ids:  the IDs to be enabled/disabled. The bit0-15 correspond to
+ *                   ID filter 0-15. Bit 16 corresponds to the vague ID filter.
+ *                   If a bit is 1,the corresponding ID filter is enabled;
+ *                   otherwise is disabled.
+ * @return    none
  *
  */
-void UART_9BitsM1TxData(UART_ID_t uartId, uint16_t data)
+void UART_LinIdFiltersCmd(UART_ID_t uartId, uint32_t idIndex)
 {
     uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-    /* transmit mode 1 */
-    if((uint32_t)SET == UARTx->UART_LCR_EXT.DLS_E)
-    {
-        UARTx->UART_LCR_EXT.TRANSMIST_MODE = 0x1U;
-        /* Send data */
-        UARTxw->UART_RBR_THR_DLL.UART_THR = ((uint32_t)data) & 0x1FFU;
-    }
+
+    UARTx->UART_LIN_PID_FILTER_CTRL.FID_MASK = idIndex;
 }
 
 /**
- * @brief      Config UART FIFO function
- *
- * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  fifoConfig:  Pointer to a FIFO configuration
- * @return     none
+ * @brief      Config the ID filter values for ID filter 0-15. It will config
+ *             the ID filter values for ID filter 0 - (idNum-1) in order. The
+ *             value to be configed is stored in the memory that idValues points
+ *             to.
+ * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID
+ * @param[in]  idNum:  the number of IDs to be configured. The range is 1-16.
+ * @param[in]  idValues:  a pointer to the ID filter value that will be used to
+ *                        config the ID filters. The size of the memory must
+ *                        not smaller than idNum
+ * @return
+ *            - SUCC
+ *            - ERR : parameter error
  *
  */
-void UART_FIFOConfig(UART_ID_t uartId, const UART_FIFOConfig_t * fifoConfig)
+ResultStatus_t UART_LinConfigIdFilters(UART_ID_t uartId, uint8_t idNum,
+                                       const uint8_t idValues[])
 {
-    uint32_t regValue;
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-
-    regValue =((((uint32_t)(fifoConfig->fifoRt) & 0x03U) << 6U)
-                    | (((uint32_t)(fifoConfig->fifoTet) & 0x03U) << 4U)
-                    | (((uint32_t)(fifoConfig->txFifoReset) & 0x01U) << 2U)
-                    | (((uint32_t)(fifoConfig->rxFifoReset) & 0x01U) << 1U)
-                    | ((uint32_t)(fifoConfig->fifoEnable) & 0x01U));
+    ResultStatus_t ret;
 
-    UARTxw->UART_IIR_FCR.UART_FCR = regValue;
+    volatile uint32_t regTmp;
+    uint32_t tmp;
+    volatile uint32_t* idFilterP[4];
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
     
-    uartFifoControlBuf[uartId] = regValue; 
-    uartFifoControlBuf[uartId] &= (~(UART_RESET_RX_FIFO | UART_RESET_TX_FIFO));
+    idFilterP[0] = &(UARTxw->UART_LIN_PID_FILTER_0);
+    idFilterP[1] = &(UARTxw->UART_LIN_PID_FILTER_1);
+    idFilterP[2] = &(UARTxw->UART_LIN_PID_FILTER_2);
+    idFilterP[3] = &(UARTxw->UART_LIN_PID_FILTER_3);
 
+    if(idNum > 16U)
+    {
+        ret = ERR;
+     }
+    else
+    {
+        for(uint8_t index = 0U; index < idNum; index++)
+        {
+            tmp = (index % 4UL) * 8UL;
+            regTmp = *idFilterP[index/4UL] & ~(0x3FUL << tmp);
+            *idFilterP[index/4UL] = regTmp | (uint8_t)(idValues[index] << tmp);
+            regTmp = regTmp | ((uint32_t)(idValues[index]) << tmp);
+            *idFilterP[index/4UL] = regTmp;
+        }
+        ret = SUCC;
+    }
+    return ret;
 }
 
 /**
- * @brief      Get UART FIFO status
+ * @brief      Config the buffered mode of a UART
  *
  * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  txBuf:  points to the TX ring storage. NULL disables buffered TX.
+ * @param[in]  txSize:  size of txBuf in bytes, it shall be a power of 2.
+ * @param[in]  rxBuf:  points to the RX ring storage. NULL disables buffered RX.
+ * @param[in]  rxSize:  size of rxBuf in bytes, it shall be a power of 2.
+ *
  * @return     status
+ *             - SUCC -- successful
+ *             - ERR -- txSize or rxSize is not a power of 2
  *
  */
-ControlState_t UART_GetFifoStatus(UART_ID_t uartId)
+ResultStatus_t UART_BufferedConfig(UART_ID_t uartId, uint8_t txBuf[], 
+                                   uint32_t txSize, uint8_t rxBuf[],
+                                   uint32_t rxSize)
 {
-    ControlState_t ret;
-
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-
-    if(UARTx->UART_IIR_FCR.UART_IIR.FIFOSE == 3U)
+    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    UART_Buffered_t *buffered = &uartBuffered[uartId];
+    ResultStatus_t ret = SUCC;
+    
+    if((txBuf != NULL) && 
+       ((0U == txSize) || ((txSize & (txSize - 1U)) != 0U)))
     {
-        ret = ENABLE;
+        ret = ERR;
+    }
+    else if((rxBuf != NULL) && 
+            ((0U == rxSize) || ((rxSize & (rxSize - 1U)) != 0U) ||
+             (uartDma[uartId].rxBuf != NULL)))
+    {
+        ret = ERR;
     }
     else
     {
-        ret = DISABLE;
+        buffered->txRing.buf = txBuf;
+        buffered->txRing.size = (NULL == txBuf) ? 0U : txSize;
+        buffered->txRing.head = 0U;
+        buffered->txRing.tail = 0U;
+        
+        buffered->rxRing.buf = rxBuf;
+        buffered->rxRing.size = (NULL == rxBuf) ? 0U : rxSize;
+        buffered->rxRing.head = 0U;
+        buffered->rxRing.tail = 0U;
+        buffered->rxDropCnt = 0U;
+        
+        if(rxBuf != NULL)
+        {
+            UARTxw->UART_DLH_IER.UART_IER |= 
+                uartInterruptMaskTable[UART_INT_RBFI];
+        }
     }
-
+    
     return ret;
 }
 
 /**
- * @brief      Reset uart receive fifo
+ * @brief      Copy data into the TX ring and start the transmission
  *
  * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @return     none
+ * @param[in]  data:  points to the data to be sent
+ * @param[in]  length:  the number of bytes to be sent
+ *
+ * @return     the number of bytes copied into the TX ring
  *
  */
-void UART_ResetRxFifo(UART_ID_t uartId)
+uint32_t UART_Write(UART_ID_t uartId, const uint8_t data[], uint32_t length)
 {
     uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-
-    uartFifoControlBuf[uartId] |= UART_RESET_RX_FIFO;
-
-    UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
+    UART_Ring_t *ring = &uartBuffered[uartId].txRing;
+    uint32_t head = ring->head;
+    uint32_t tail = ring->tail;
+    uint32_t num = 0U;
+    uint32_t primask;
     
-    uartFifoControlBuf[uartId] &= (~UART_RESET_RX_FIFO);
+    if((ring->buf != NULL) && (data != NULL))
+    {
+        while((num < length) && ((head - tail) < ring->size))
+        {
+            ring->buf[head & (ring->size - 1U)] = data[num];
+            head++;
+            num++;
+        }
+        
+        if(num > 0U)
+        {
+            /* The data shall be written before it is visible to the ISR */
+            COMMON_DMB();
+            ring->head = head;
+            
+            /* The ISR masks TX empty interrupt when the ring is empty, so it 
+               is unmasked after each write. It fires at once if the TX FIFO 
+               is below the trigger level. */
+            primask = COMMON_GetPRIMASK();
+            COMMON_DISABLE_INTERRUPTS();
+            UARTxw->UART_DLH_IER.UART_IER |= 
+                uartInterruptMaskTable[UART_INT_TBEI];
+            COMMON_SetPRIMASK(primask);
+        }
+    }
+    
+    return num;
 }
 
 /**
- * @brief      Reset uart transmit fifo
+ * @brief      Read received data out of the RX ring
  *
  * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @return     none
+ * @param[out] data:  points to the memory where the data to be stored
+ * @param[in]  length:  the maximum number of bytes to be read
+ *
+ * @return     the number of bytes read
  *
  */
-void UART_ResetTxFifo(UART_ID_t uartId)
+uint32_t UART_Read(UART_ID_t uartId, uint8_t data[], uint32_t length)
 {
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-
-    uartFifoControlBuf[uartId] |= UART_RESET_TX_FIFO;    
-    UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
+    UART_Ring_t *ring = &uartBuffered[uartId].rxRing;
+    uint32_t head = ring->head;
+    uint32_t tail = ring->tail;
+    uint32_t num = 0U;
     
-    uartFifoControlBuf[uartId] &= (~UART_RESET_TX_FIFO);
+    if((ring->buf != NULL) && (data != NULL))
+    {
+        while((tail != head) && (num < length))
+        {
+            data[num] = ring->buf[tail & (ring->size - 1U)];
+            tail++;
+            num++;
+        }
+        
+        /* The data shall be read before it is released to the producer */
+        COMMON_DMB();
+        ring->tail = tail;
+    }
+    
+    return num;
 }
 
 /**
- * @brief      Enable/Disable debug enable. If enabled, hardware will not clean 
- *             the recevier fifo automaticlly
+ * @brief      Get the number of bytes waiting in the TX ring
  *
  * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
  *
- * @param[in]  ControlState_t: ENABLE/DISABLE
- *
- * @return     none
+ * @return     the number of bytes not yet moved into the TX FIFO
  *
  */
-void UART_DebugCmd(UART_ID_t uartId, ControlState_t Cmd)
+uint32_t UART_GetTxPending(UART_ID_t uartId)
 {
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-    
-    UARTx->UART_LCR.DEBUG_EN = (uint32_t)Cmd;
+    return uartBuffered[uartId].txRing.head - uartBuffered[uartId].txRing.tail;
 }
 
 /**
- * @brief      idle detect config
+ * @brief      Get the number of received bytes dropped because the RX ring
+ *             was full
  *
  * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
  *
- * @param[in]  config: config idle detect 
- *
- * @return     none
+ * @return     the number of dropped bytes
  *
  */
-void UART_IdleDetectConfig(UART_ID_t uartId,UART_IdleDetectConfig_t *config)
+uint32_t UART_GetRxDropCount(UART_ID_t uartId)
 {
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-        
-    UARTx->UART_LCR.IDLE_DET_LENGTH = (uint32_t)config->len;
-    UARTx->UART_LCR.IDLE_DET_EN = (uint32_t)config->Cmd;
+    return uartBuffered[uartId].rxDropCnt;
 }
 
 /**
- * @brief      Config UART in LIN mode
- * @param[in]  uartId:  Select the UART port. It should be UART0_ID, UART1_ID,
+ * @brief      Config the DMA streaming mode of a UART
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  config:  points to the configuration of LIN mode
- * @return     none
+ * @param[in]  config:  Pointer to the DMA streaming configuration
+ *
+ * @return     status
+ *             - SUCC -- successful
+ *             - ERR -- rxSize is out of range, or buffered RX is in use
+ *
  */
-void UART_LinConfig(UART_ID_t uartId, const UART_LinConfig_t *config)
+ResultStatus_t UART_DmaConfig(UART_ID_t uartId, const UART_DmaConfig_t *config)
 {
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
     uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    UART_Dma_t *dma = &uartDma[uartId];
+    DMA_TransferConfig_t dmaConfig;
+    UART_IdleDetectConfig_t idleConfig;
+    ResultStatus_t ret = SUCC;
     
-    uint32_t integerDiv, fractionalDiv;
-    CLK_Module_t clk[] = {CLK_UART0,CLK_UART1,CLK_UART2,CLK_UART3,CLK_UART4,
-                          CLK_UART5};
-    CLK_Module_t uartClkId = clk[uartId];
-    uint32_t tmp;
-
-    /* Enable DLAB to set baud rate */
-    UARTx->UART_LCR.DLAB = 0x01U;
-    tmp = CLK_GetModuleClkFreq(uartClkId, config->oscFreq);
-    
-     /* get baudrate divisor*/
-    integerDiv = tmp/(16U * config->baudRate);
-
-    /* Config the DLL and DLH registers */
-    UARTx->UART_RBR_THR_DLL.UART_DLL.DL_L = integerDiv & 0xFFU;
-    UARTx->UART_DLH_IER.UART_DLH.DL_H = (integerDiv >> 0x08U)& 0xFFU;
-
-    /* calculate fractional divisor
-       divisor = clkFreq/(16*baudrate) = BRDI +BRDF
-       FD = BRDF*2^4 = 16* BRDF
-       BRDF = clkFreq%(16*baudrate)/(16*baudrate)
-       FD = clkFreq%(16*baudrate)*16/(16*baudrate)
-          = clkFreq%(16*baudrate)/baudrate  */
-    fractionalDiv = tmp%(16U * config->baudRate);
-    fractionalDiv /= config->baudRate;
-    UARTx->UART_FD.FD = fractionalDiv;
-    
-    /* Disable DLAB */
-    UARTx->UART_LCR.DLAB = 0x0U;
-    /* no parity */
-    UARTx->UART_LCR.PEN = 0x0U;
-
-    /* 8 bits */
-    UARTx->UART_LCR.DLS = 3U ;
-
-    /* 1 stop bit */
-    UARTx->UART_LCR.STOP = 0U;
-
-    UARTx->UART_AFCR.RTS = 0U;
-
-    /* LIN mode */
-    UARTx->UART_LIN_CTL.LIN_MODE = 1U;
-    UARTx->UART_LIN_CTL.MASTER_MODE = (uint32_t)config->mode;
-
-    /* auto sync */
-    UARTx->UART_LCR.AUTO_SYNC_EN = (uint32_t)config->autoSyncEn;
- 
-    /* ID filter enable */
-    UARTx->UART_LIN_PID_FILTER_CTRL.LIN_FILTER_EN = (uint32_t)config->idFilterEn;
-    
-    /* enable and clear FIFO in LIN mode */
-    uartFifoControlBuf[uartId] |= UART_ENABLE_FIFO;
-    
-    UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
-    
-    uartFifoControlBuf[uartId] |= ( UART_RESET_TX_FIFO | UART_RESET_RX_FIFO);
-    
-    UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
-    
-    uartFifoControlBuf[uartId] &= ( ~ (UART_RESET_TX_FIFO | UART_RESET_RX_FIFO));
-
-}
-
-/**
- * @brief      Set UART in LIN mode as a LIN master and start to send the header
- * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  header:  points to the header to be send
- * @return     status
- *             - SUCC : header is sent
- *             - ERR : header is not sent due to UART is busy
- */
-ResultStatus_t UART_LinSendHeader(UART_ID_t uartId, 
-                                           const UART_LinHeader_t *header)
-{
-    ResultStatus_t ret;
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-
-    uint32_t breakLen;
-    uint32_t rsp_op_start = UARTx->UART_LIN_CTL.RSP_OP_START;
-    uint32_t header_op_start = UARTx->UART_LIN_CTL.HEADER_OP_START;
-
-    /* check if UART is busy */
-    if( (rsp_op_start != 0U) || (header_op_start != 0U) )
+    if((config->rxBuf != NULL) && 
+       ((config->rxSize < 2U) || ((uint32_t)config->rxSize > UART_DMA_RX_SIZE_MAX) ||
+        (uartBuffered[uartId].rxRing.buf != NULL)))
     {
         ret = ERR;
     }
     else
     {
-        UARTx->UART_LIN_DEL_LENGTH.LIN_DEL_LENGTH = header->deleLen - 1U;
-        UARTx->UART_LIN_PID_VALUE.PID = header->id;    
-
-        breakLen = ((header->breakLen) >= UART_LIN_SEND_BREAK_MIN)?(
-                           (header->breakLen) - UART_LIN_SEND_BREAK_THR):
-                           (UART_LIN_SEND_BREAK_MIN - UART_LIN_SEND_BREAK_THR);                
-                           
-        if(breakLen != UARTx->UART_LCR.LBKM )
+        if(dma->rxBuf != NULL)
         {
-            UARTx->UART_LCR.LBKM = breakLen;
+            DMA_ChannelRequestDisable(dma->rxChannel);
         }
-        else
+        
+        dma->rxBuf = NULL;
+        dma->txEnable = config->txEnable;
+        dma->txChannel = config->txChannel;
+        
+        if(config->rxBuf != NULL)
         {
-            /* Nothing to do */
+            /* one byte per minor loop, rewind to the start after a major loop */
+            dmaConfig.channel = config->rxChannel;
+            dmaConfig.channelPriority = DMA_GetChannelPriority(config->rxChannel);
+            dmaConfig.channelPreempt = DMA_GetChannelPreempt(config->rxChannel);
+            dmaConfig.source = uartDmaRxReqTable[uartId];
+            /*PRQA S 0306 ++*/
+            dmaConfig.srcAddr = (uint32_t)&UARTxw->UART_RBR_THR_DLL.UART_RBR;
+            dmaConfig.destAddr = (uint32_t)config->rxBuf;
+            /*PRQA S 0306 --*/
+            dmaConfig.minorLoopSrcOffset = 0;
+            dmaConfig.minorLoopDestOffset = 1;
+            dmaConfig.majorLoopSrcOffset = 0;
+            dmaConfig.majorLoopDestOffset = (int16_t)(-(int32_t)config->rxSize);
+            dmaConfig.transferByteNum = 1U;
+            dmaConfig.minorLoopNum = config->rxSize;
+            dmaConfig.srcTransferSize = DMA_TRANSFER_SIZE_1B;
+            dmaConfig.destTransferSize = DMA_TRANSFER_SIZE_1B;
+            dmaConfig.disableRequestAfterDoneCmd = DISABLE;
+            
+            DMA_ChannelRequestDisable(config->rxChannel);
+            ret = DMA_ConfigTransfer(&dmaConfig);
+        }
+        
+        if((SUCC == ret) && (config->rxBuf != NULL))
+        {
+            dma->rxSize = (uint32_t)config->rxSize;
+            dma->readPos = 0U;
+            dma->idlePos = 0U;
+            dma->rxCallback = config->rxCallback;
+            dma->rxChannel = config->rxChannel;
+            dma->rxBuf = config->rxBuf;
+            
+            idleConfig.Cmd = ENABLE;
+            idleConfig.len = config->idleLen;
+            UART_IdleDetectConfig(uartId, &idleConfig);
+            
+            DMA_ChannelRequestEnable(config->rxChannel);
+            UARTxw->UART_DLH_IER.UART_IER |= 
+                uartInterruptMaskTable[UART_INT_RCVRTO];
         }
-        UARTx->UART_LIN_CTL.MASTER_MODE = 1U;
-        /* start to send */
-        UARTx->UART_LIN_CTL.HEADER_OP_START = 1U;
-
-        ret = SUCC;
-    }
-
-    return ret;
-}
-
-/**
- * @brief       This function stops receiving/sending header/response of LIN. 
- *
- * @param[in]   uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
- *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- *                     
- * @return     none
- */
-void UART_LinStopTransmission(UART_ID_t uartId)
-{
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-    
-    UARTx->UART_LIN_CTL.RSP_OP_START = 0U;
-    
-    UARTx->UART_LIN_CTL.HEADER_OP_START = 0U;
-    
-}
-
-/**
- * @brief       If LIN is sending/receiving header/response
- *                this function returns SET, otherwise, return RESET.
- *
- * @param[in]   uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
- *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- *                     
- * @return     SET/RESET
- */
-FlagStatus_t UART_LinGetTransmissionStatus(UART_ID_t uartId)
-{
-    FlagStatus_t ret = RESET;
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-    
-    uint32_t rsp_op_start = UARTx->UART_LIN_CTL.RSP_OP_START;
-    uint32_t header_op_start = UARTx->UART_LIN_CTL.HEADER_OP_START;
-
-    /* check if UART is busy */
-    if( (rsp_op_start != 0U) || (header_op_start != 0U) )
-    {
-        ret = SET;
-    }
-    else
-    {
-        /* nothing */
     }
     
     return ret;
 }
 
 /**
- * @brief      Set LIN as a slave and start to receive a header.
- *             FIFO is disabled before it starts to receive a header
+ * @brief      Read received data out of the DMA RX buffer
  *
- * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @return     
- *            - SUCC : it starts to receive header
- *            - ERR : it dose not start to receive header due to UART is busy
+ * @param[out] data:  points to the memory where the data to be stored
+ * @param[in]  length:  the maximum number of bytes to be read
+ *
+ * @return     the number of bytes read
+ *
  */
-ResultStatus_t UART_LinStartReceiveHeader(UART_ID_t uartId)
+uint32_t UART_DmaRead(UART_ID_t uartId, uint8_t data[], uint32_t length)
 {
-    ResultStatus_t ret;
-    volatile uint32_t dummyData;
+    UART_Dma_t *dma = &uartDma[uartId];
+    uint32_t head;
+    uint32_t tail = dma->readPos;
+    uint32_t num = 0U;
     
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-         
-    uint32_t rsp_op_start = UARTx->UART_LIN_CTL.RSP_OP_START;
-    uint32_t header_op_start = UARTx->UART_LIN_CTL.HEADER_OP_START;
-    
-    /* check if UART is busy */
-    if( (rsp_op_start != 0U) || (header_op_start != 0U) )
+    if((dma->rxBuf != NULL) && (data != NULL))
     {
-        ret = ERR;
-    }
-    else
-    {       
-        /* reset rx fifo then disable fifo */
-        uartFifoControlBuf[uartId] |= UART_RESET_RX_FIFO;
-        UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];        
-        uartFifoControlBuf[uartId] &= (~UART_RESET_RX_FIFO);
+        head = UART_DmaRxPos(uartId);
         
-        uartFifoControlBuf[uartId] &= ~UART_ENABLE_FIFO;            
-        UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
-
-        UARTx->UART_LIN_CTL.MASTER_MODE = 0U;
-        /* read LSR to clear  BI and FE*/
-        dummyData = UARTxw->UART_LSR;
-        /* start to receive */
-        UARTx->UART_LIN_CTL.HEADER_OP_START = 1U;
-
-        ret = SUCC;
+        while((tail != head) && (num < length))
+        {
+            data[num] = dma->rxBuf[tail];
+            num++;
+            tail++;
+            if(tail == dma->rxSize)
+            {
+                tail = 0U;
+            }
+        }
+        
+        dma->readPos = tail;
     }
-
-    return ret;
+    
+    return num;
 }
 
 /**
- * @brief      read the 6-bit ID(exclude parity bits) of header
- * @param[in]  uartId:  Select the UART port.UART0_ID, UART1_ID,
- *                     UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @return     ID
+ * @brief      Get the number of bytes in the DMA RX buffer not read yet
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     the number of bytes can be read by UART_DmaRead()
+ *
  */
-uint32_t UART_LinGetId(UART_ID_t uartId)
+uint32_t UART_DmaGetRxCount(UART_ID_t uartId)
 {
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-
-    return UARTx->UART_LIN_PID_VALUE.PID;
+    UART_Dma_t *dma = &uartDma[uartId];
+    uint32_t head;
+    uint32_t count = 0U;
+    
+    if(dma->rxBuf != NULL)
+    {
+        head = UART_DmaRxPos(uartId);
+        count = (head >= dma->readPos) ? (head - dma->readPos) : 
+                                         ((dma->rxSize - dma->readPos) + head);
+    }
+    
+    return count;
 }
 
 /**
- * @brief      start to send a response
- * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ * @brief      Send a buffer through the TX DMA channel
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  rsp:  Points to reponse structure to be sent.
- * @return
- *             - SUCC : response is sent
- *             - ERR : resoponse is not sent due to UART is busy
+ * @param[in]  data:  points to the data to be sent
+ * @param[in]  length:  the number of bytes to be sent
+ *
+ * @return     status
+ *             - SUCC -- the transfer is started
+ *             - BUSY -- the previous transfer is not finished
+ *             - ERR -- DMA TX is not enabled or length is 0
+ *
  */
-ResultStatus_t UART_LinSendResponse(UART_ID_t uartId,
-                                    const UART_LinResponse_t *rsp)
+ResultStatus_t UART_DmaWrite(UART_ID_t uartId, const uint8_t data[], 
+                             uint16_t length)
 {
-    ResultStatus_t ret;
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
     uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-
-    uint32_t rsp_op_start = UARTx->UART_LIN_CTL.RSP_OP_START;
-    uint32_t header_op_start = UARTx->UART_LIN_CTL.HEADER_OP_START;
-
-    if((rsp->len > 8U) || ( (rsp_op_start != 0U)|| (header_op_start != 0U)))
+    UART_Dma_t *dma = &uartDma[uartId];
+    DMA_TransferConfig_t dmaConfig;
+    ResultStatus_t ret;
+    
+    if((ENABLE != dma->txEnable) || (NULL == data) || (0U == length))
     {
         ret = ERR;
     }
+    else if(SET == DMA_GetChannelRequestStatus(dma->txChannel))
+    {
+        /* the request is disabled by hardware when the transfer is done */
+        ret = BUSY;
+    }
     else
     {
-        /* enable fifo  */
-        uartFifoControlBuf[uartId] |= UART_ENABLE_FIFO;
-        UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
+        dmaConfig.channel = dma->txChannel;
+        dmaConfig.channelPriority = DMA_GetChannelPriority(dma->txChannel);
+        dmaConfig.channelPreempt = DMA_GetChannelPreempt(dma->txChannel);
+        dmaConfig.source = uartDmaTxReqTable[uartId];
+        /*PRQA S 0306 ++*/
+        dmaConfig.srcAddr = (uint32_t)data;
+        dmaConfig.destAddr = (uint32_t)&UARTxw->UART_RBR_THR_DLL.UART_THR;
+        /*PRQA S 0306 --*/
+        dmaConfig.minorLoopSrcOffset = 1;
+        dmaConfig.minorLoopDestOffset = 0;
+        dmaConfig.majorLoopSrcOffset = 0;
+        dmaConfig.majorLoopDestOffset = 0;
+        dmaConfig.transferByteNum = 1U;
+        dmaConfig.minorLoopNum = length;
+        dmaConfig.srcTransferSize = DMA_TRANSFER_SIZE_1B;
+        dmaConfig.destTransferSize = DMA_TRANSFER_SIZE_1B;
+        dmaConfig.disableRequestAfterDoneCmd = ENABLE;
         
-        UARTx->UART_LIN_RSP_LENGTH.RSP_LENGTH = rsp->len;
-        UARTx->UART_LIN_CHECKSUM.CHECKSUM_TYPE = (uint32_t)rsp->checkType;
-
-        for(uint32_t count = 0U; count < rsp->len; count++)
+        ret = DMA_ConfigTransfer(&dmaConfig);
+        
+        if(SUCC == ret)
         {
-            UARTxw->UART_RBR_THR_DLL.UART_THR = rsp->data[count];
+            DMA_ChannelRequestEnable(dma->txChannel);
         }
-
-        UARTx->UART_LIN_CTL.RSP_DIR = 1U;
-
-        UARTx->UART_LIN_CTL.RSP_OP_START = 1U;
-
-        ret = SUCC;
     }
-
+    
     return ret;
 }
 
 /**
- * @brief      start to receive a response
- * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ * @brief      Get the DMA TX status
+ *
+ * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  check:  checksum type.
- * @param[in]  len:  response length.
- * @return
- *            - SUCC : it starts to receive response
- *            - ERR : it dose not start to receive response due to UART is busy
+ *
+ * @return     SET: the DMA is still moving data into the TX FIFO
+ *             RESET: the DMA TX is idle
+ *
  */
-ResultStatus_t UART_LinStartReceiveResponse(UART_ID_t uartId,
-                                            UART_LinCheckSum_t check,
-                                            uint32_t len)
+FlagStatus_t UART_DmaGetTxStatus(UART_ID_t uartId)
 {
-    ResultStatus_t ret;
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    FlagStatus_t ret = RESET;
     
-    uint32_t rsp_op_start = UARTx->UART_LIN_CTL.RSP_OP_START;
-    uint32_t header_op_start = UARTx->UART_LIN_CTL.HEADER_OP_START;
-
-    /* check if UART is busy */
-    if((rsp_op_start != 0U) || (header_op_start !=0U))
-    {
-        ret = ERR;
-    }
-    else
+    if(ENABLE == uartDma[uartId].txEnable)
     {
-        /* enable fifo and reset rx fifo */
-        uartFifoControlBuf[uartId] |= UART_ENABLE_FIFO;
-        UARTxw->UART_IIR_FCR.UART_FCR = uartFifoControlBuf[uartId];
-        
-        /* reset RX FIFO */
-        UART_ResetRxFifo(uartId);
-
-        UARTx->UART_LIN_RSP_LENGTH.RSP_LENGTH = len;
-        UARTx->UART_LIN_CHECKSUM.CHECKSUM_TYPE = (uint32_t)check;
-
-        UARTx->UART_LIN_CTL.RSP_DIR = 0U;
-
-        UARTx->UART_LIN_CTL.RSP_OP_START = 1U;
-
-        ret = SUCC;
+        ret = DMA_GetChannelRequestStatus(uartDma[uartId].txChannel);
     }
+    
     return ret;
 }
 
 /**
- * @brief      read a response. if a reponse is received, this function can be
- *             called to get the data of response. This function is called
- *             after UART_LinStartReceiveResponse() and UART_INTSTA_RSP_DONE
- *             status is set.
+ * @brief      Start a LIN master schedule table
+ *
  * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  len:  response length to be read.
- * @param[in]  data:  points to the memory where the response data to be stored.
- *                    the memory size must not be smaller than len
- * @return     none
+ * @param[in]  schedule:  points to the schedule table
+ *
+ * @return     status
+ *             - SUCC : the table is accepted
+ *             - ERR : the table is empty or a slot is invalid
+ *
  */
-void UART_LinReadResponse(UART_ID_t uartId, uint32_t len, uint8_t data[])
+ResultStatus_t UART_LinScheduleStart(UART_ID_t uartId,
+                                     const UART_LinSchedule_t *schedule)
 {
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-
-    for(uint32_t count = 0U; count < len; count++)
+    UART_LinSched_t *sched = &uartLinSched[uartId];
+    ResultStatus_t ret = SUCC;
+    uint32_t primask;
+    
+    if((NULL == schedule->slots) || (0U == schedule->slotNum) ||
+       (uartLinSlave[uartId].table != NULL))
     {
-        data[count] = (uint8_t)UARTx->UART_RBR_THR_DLL.UART_RBR.RBR_LSB;
+        ret = ERR;
+    }
+    
+    for(uint32_t idx = 0U; (idx < schedule->slotNum) && (SUCC == ret); idx++)
+    {
+        if((0U == schedule->slots[idx].delay) || 
+           ((schedule->slots[idx].dir != UART_LIN_SLOT_HEADER_ONLY) && 
+            ((0U == schedule->slots[idx].len) || 
+             (schedule->slots[idx].len > 8U) ||
+             (NULL == schedule->slots[idx].data))))
+        {
+            ret = ERR;
+        }
+    }
+    
+    if(SUCC == ret)
+    {
+        primask = COMMON_GetPRIMASK();
+        COMMON_DISABLE_INTERRUPTS();
+        if(NULL == sched->table)
+        {
+            sched->table = schedule;
+            sched->pending = NULL;
+            sched->nextSlot = 0U;
+            sched->ticksLeft = 0U;
+            sched->busy = RESET;
+        }
+        else
+        {
+            sched->pending = schedule;
+        }
+        COMMON_SetPRIMASK(primask);
+        
+        UART_IntMask(uartId, UART_INT_HEADER_DONE, UNMASK);
+        UART_IntMask(uartId, UART_INT_RSP_DONE, UNMASK);
     }
+    
+    return ret;
 }
 
 /**
- * @brief      Get current value of Line Status register
+ * @brief      Stop the LIN master schedule table
  *
- * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
-* @param[in]  lineStatus:
- *                       - UART_LINESTA_DR
- *                       - UART_LINESTA_OE
- *                       - UART_LINESTA_PE
- *                       - UART_LINESTA_FE
- *                       - UART_LINESTA_BI
- *                       - UART_LINESTA_THRE
- *                       - UART_LINESTA_TEMT
- *                       - UART_LINESTA_RFE
- *                       - UART_LINESTA_TRANS_ERR
- *                       - UART_LINESTA_ADDR_RCVD
- *                       - UART_LINESTA_ASYNC
- *                       - UART_LINESTA_FIELD_ERR
- *                       - UART_LINESTA_PID_ERR
- *                       - UART_LINESTA_CHECKSUM_ERR
- *                       - UART_LINESTA_TO_ERR
- *                       - UART_LINESTA_HEADER_DONE
- *                       - UART_LINESTA_RSP_DONE
- *
- * @note       This function returns only one line status. However,  once call 
- *             this function, all line status will be cleared. If user
- *             needs to read more than one line status, it is suggested to use 
- *             UART_GetAllLineStatus() to get all line status and handle them 
- *             one by one.
  *
- * @return     The state value of UART Line Status register
+ * @return     none
  *
  */
-FlagStatus_t UART_GetLineStatus(UART_ID_t uartId, UART_LineStatus_t lineStatus)
+void UART_LinScheduleStop(UART_ID_t uartId)
 {
-    FlagStatus_t bitStatus;
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-
-    bitStatus = (((UARTxw->UART_LSR & uartLineStatusTable[lineStatus]) != 0U) 
-                  ? SET : RESET);
-
-    return bitStatus;
+    UART_LinSched_t *sched = &uartLinSched[uartId];
+    uint32_t primask;
+    
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    sched->table = NULL;
+    sched->pending = NULL;
+    sched->busy = RESET;
+    UART_LinStopTransmission(uartId);
+    COMMON_SetPRIMASK(primask);
 }
 
 /**
- * @brief      Get all Line Status 
+ * @brief      Advance the LIN schedule by one tick
  *
- * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * 
- * @note       Once call the function, line status will be cleared
+ * @param[in]  tickLatency:  time passed since the timer event
  *
- * @return     The state value of UART Line Status register
+ * @return     none
  *
  */
-uint32_t UART_GetAllLineStatus(UART_ID_t uartId)
+void UART_LinScheduleTick(UART_ID_t uartId, uint32_t tickLatency)
 {
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-    
-    uint32_t ret;
-    
-    ret = (uint32_t)UARTxw->UART_LSR & (uint32_t)0xFFFF;
+    UART_LinSched_t *sched = &uartLinSched[uartId];
+    const UART_LinSlot_t *slot;
+    UART_LinHeader_t header;
     
-    return ret;
+    if(sched->ticksLeft > 1U)
+    {
+        sched->ticksLeft--;
+    }
+    else if(sched->table != NULL)
+    {
+        if(SET == sched->busy)
+        {
+            /* the frame overran its slot */
+            UART_LinStopTransmission(uartId);
+            UART_LinSchedSlotEnd(uartId, UART_LIN_SLOT_NO_RSP);
+        }
+        
+        if(sched->pending != NULL)
+        {
+            sched->table = sched->pending;
+            sched->pending = NULL;
+            sched->nextSlot = 0U;
+        }
+        
+        sched->curSlot = sched->nextSlot;
+        slot = &sched->table->slots[sched->curSlot];
+        
+        sched->nextSlot++;
+        if(sched->nextSlot == sched->table->slotNum)
+        {
+            sched->nextSlot = 0U;
+        }
+        sched->ticksLeft = slot->delay;
+        
+        header.id = slot->id;
+        header.breakLen = sched->table->breakLen;
+        header.deleLen = sched->table->deleLen;
+        
+        if(SUCC == UART_LinSendHeader(uartId, &header))
+        {
+            sched->busy = SET;
+            
+            if((0U == sched->stats.slotCnt) || 
+               (tickLatency < sched->stats.latencyMin))
+            {
+                sched->stats.latencyMin = tickLatency;
+            }
+            if(tickLatency > sched->stats.latencyMax)
+            {
+                sched->stats.latencyMax = tickLatency;
+            }
+            sched->stats.latencySum += tickLatency;
+            sched->stats.slotCnt++;
+        }
+        else
+        {
+            sched->stats.overrunCnt++;
+        }
+    }
+    else
+    {
+        /* schedule is stopped */
+    }
 }
 
 /**
- * @brief      Get busy status
+ * @brief      Get the LIN schedule statistics
  *
- * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[out] stats:  points to the memory where the statistics to be stored
  *
- * @return     The busy Status
+ * @return     none
  *
  */
-FlagStatus_t UART_GetBusyStatus(UART_ID_t uartId)
+void UART_LinGetScheduleStats(UART_ID_t uartId, UART_LinScheduleStats_t *stats)
 {
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-
-    return (UARTx->UART_USR.BUSY != 0U) ? SET : RESET;
+    uint32_t primask;
+    
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    *stats = uartLinSched[uartId].stats;
+    COMMON_SetPRIMASK(primask);
 }
 
 /**
- * @brief      Get current UART interrupt Status, except async status
+ * @brief      Clear the LIN schedule statistics
  *
- * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  intType: select one interrupt
  *
- * @note       If only need async status, can use UART_GetLineStatus function.
- *             
- * @return     The state value of UART Status register
+ * @return     none
  *
  */
-IntStatus_t UART_GetIntStatus(UART_ID_t uartId, UART_Int_t intType)
+void UART_LinClearScheduleStats(UART_ID_t uartId)
 {
-    IntStatus_t bitStatus;
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-   
-    bitStatus = ((UARTx->UART_IIR_FCR.UART_IIR.IID ==
-                      uartInterruptStatusTable[intType] ) ? SET : RESET);  
-
-    return bitStatus;
+    UART_LinScheduleStats_t *stats = &uartLinSched[uartId].stats;
+    uint32_t primask;
+    
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    stats->slotCnt = 0U;
+    stats->headerErrCnt = 0U;
+    stats->rspErrCnt = 0U;
+    stats->noRspCnt = 0U;
+    stats->overrunCnt = 0U;
+    stats->latencyMin = 0U;
+    stats->latencyMax = 0U;
+    stats->latencySum = 0U;
+    COMMON_SetPRIMASK(primask);
 }
 
 /**
-* @brief     Mask/Unmask the UART interrupt
- *            UART_INT_RCVRTO and UART_INT_RBFI are controlled by the same bit,
- *            so they are masked/unmasked at the same time. But UART_INT_RCVRTO
- *            is only generated when it in fifo mode and fifo is enabled
- * @param[in]  uartId:  Select the UART port, should be UART0_ID, UART1_ID,
+ * @brief      Start the LIN slave node with a response table
+ *
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
  *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
- * @param[in]  intType:  Specifies the interrupt type
- * @param[in]  intMask:  Enable/Disable Specified interrupt type
+ * @param[in]  table:  points to the response table
  *
- * @return     none
+ * @return     status
+ *             - SUCC : the slave node is started
+ *             - ERR : the table is invalid, the UART is busy or a schedule
+ *                     table is running
  *
  */
-void UART_IntMask(UART_ID_t uartId, UART_Int_t intType, IntMask_t intMask)
+ResultStatus_t UART_LinSlaveStart(UART_ID_t uartId, 
+                                  const UART_LinSlaveTable_t *table)
 {
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-
-    if(intMask == UNMASK)
+    UART_LinSlave_t *slave = &uartLinSlave[uartId];
+    uint8_t exactIds[UART_LIN_EXACT_FILTER_NUM];
+    uint32_t exactNum = 0U;
+    uint32_t filterMask;
+    uint8_t vagueValue = 0U;
+    uint8_t vagueMask = UART_LIN_ID_MASK;
+    uint8_t id;
+    ResultStatus_t ret = SUCC;
+    
+    if((NULL == table) || (NULL == table->entries) || (0U == table->entryNum) ||
+       (table->entryNum > UART_LIN_ID_NUM) || (slave->table != NULL) ||
+       (uartLinSched[uartId].table != NULL))
     {
-        UARTxw->UART_DLH_IER.UART_IER  |= (uartInterruptMaskTable[intType]);
+        ret = ERR;
     }
     else
     {
-        UARTxw->UART_DLH_IER.UART_IER &= (~(uartInterruptMaskTable[intType]));
+        /* the lookup table is only rebuilt when no slave is running */
+        for(uint32_t idx = 0U; idx < UART_LIN_ID_NUM; idx++)
+        {
+            slave->entryIdx[idx] = UART_LIN_ENTRY_NONE;
+        }
     }
-}
-
-/**
- * @brief      Enable a ID filter and config the ID filter value
- * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID
- * @param[in]  idIndex:  the index of ID filter. It indicates which ID filter
- *                       will be enabled. Its range is 0-15
- * @param[in]  idFilterValue:  the value of ID filter.
- * @return
- *            - SUCC
- *            - ERR : parameter error
- *
- */
-ResultStatus_t UART_LinEnableIdFilter(UART_ID_t uartId, uint8_t idIndex,
-                                      uint8_t idFilterValue)
-{
-    ResultStatus_t ret;
-    volatile uint32_t* idFilterP[4];
-    volatile uint32_t regTmp;
-    uint32_t tmp;
-    uint32_t idInd = (uint32_t)idIndex;
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
-
-    idFilterP[0] = &(UARTxw->UART_LIN_PID_FILTER_0);
-    idFilterP[1] = &(UARTxw->UART_LIN_PID_FILTER_1);
-    idFilterP[2] = &(UARTxw->UART_LIN_PID_FILTER_2);
-    idFilterP[3] = &(UARTxw->UART_LIN_PID_FILTER_3);
     
-    if(idInd >= 16U)
+    for(uint32_t idx = 0U; (SUCC == ret) && (idx < table->entryNum); idx++)
     {
-        ret = ERR;
+        id = table->entries[idx].id;
+        
+        if((id > UART_LIN_ID_MASK) || 
+           (slave->entryIdx[id] != UART_LIN_ENTRY_NONE) ||
+           (0U == table->entries[idx].rsp.len) || 
+           (table->entries[idx].rsp.len > 8U))
+        {
+            ret = ERR;
+        }
+        else
+        {
+            slave->entryIdx[id] = (uint8_t)idx;
+            
+            if(exactNum < UART_LIN_EXACT_FILTER_NUM)
+            {
+                exactIds[exactNum] = id;
+                exactNum++;
+            }
+            else if(exactNum == UART_LIN_EXACT_FILTER_NUM)
+            {
+                vagueValue = id;
+                exactNum++;
+            }
+            else
+            {
+                /* keep only the bits all remaining IDs agree on */
+                vagueMask &= (uint8_t)~(uint8_t)(id ^ vagueValue);
+            }
+        }
     }
-    else
+    
+    if(SUCC == ret)
     {
-        tmp = (idInd%4U)*8U;
-        regTmp = *idFilterP[idInd/4UL] & ~(0x3FUL << tmp);
-        *idFilterP[idInd/4U] = regTmp | ((uint32_t)idFilterValue << tmp);
-        UARTx->UART_LIN_PID_FILTER_CTRL.FID_MASK |= (1UL << idInd);
-
-        ret = SUCC;
+        /* only IDs of the table can raise the header done interrupt */
+        (void)UART_LinConfigIdFilters(uartId, (uint8_t)((exactNum > UART_LIN_EXACT_FILTER_NUM) ? 
+                                                        UART_LIN_EXACT_FILTER_NUM : exactNum), 
+                                      exactIds);
+        filterMask = (exactNum >= UART_LIN_EXACT_FILTER_NUM) ? 0xFFFFU : 
+                     (((uint32_t)1U << exactNum) - 1U);
+        UART_LinIdFiltersCmd(uartId, filterMask);
+        
+        if(exactNum > UART_LIN_EXACT_FILTER_NUM)
+        {
+            UART_LinEnableVagueIdFilter(uartId, vagueValue & vagueMask, vagueMask);
+        }
+        
+        uartRegPtr[uartId]->UART_LIN_PID_FILTER_CTRL.LIN_FILTER_EN = 1U;
+        
+        slave->cur = NULL;
+        slave->table = table;
+        
+        UART_IntMask(uartId, UART_INT_HEADER_DONE, UNMASK);
+        UART_IntMask(uartId, UART_INT_RSP_DONE, UNMASK);
+        
+        if(SUCC != UART_LinStartReceiveHeader(uartId))
+        {
+            slave->table = NULL;
+            ret = ERR;
+        }
     }
     
     return ret;
 }
 
 /**
- * @brief      Disable a ID filter
- * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID
- * @param[in]  idIndex:  the index of ID filter. It indicates which ID filter
- *                       will be disabled. Its range is 0-15
- * @return
- *            - SUCC
- *            - ERR : parameter error
+ * @brief      Stop the LIN slave node
+ *
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ *
+ * @return     none
  *
  */
-ResultStatus_t UART_LinDisableIdFilter(UART_ID_t uartId, uint32_t idIndex)
+void UART_LinSlaveStop(UART_ID_t uartId)
 {
-    ResultStatus_t ret;
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-
-    if(idIndex >= 16U)
-    {
-        ret = ERR;
-    }
-    else
+    uint32_t primask;
+    
+    primask = COMMON_GetPRIMASK();
+    COMMON_DISABLE_INTERRUPTS();
+    if(uartLinSlave[uartId].table != NULL)
     {
-        UARTx->UART_LIN_PID_FILTER_CTRL.FID_MASK &= ~(1UL << idIndex);
-        ret = SUCC;
+        /* remove the ID filters programmed by UART_LinSlaveStart() */
+        UART_LinIdFiltersCmd(uartId, 0U);
+        uartRegPtr[uartId]->UART_LIN_PID_FILTER_CTRL.LIN_FILTER_EN = 0U;
     }
-    return ret;
+    uartLinSlave[uartId].table = NULL;
+    uartLinSlave[uartId].cur = NULL;
+    UART_LinStopTransmission(uartId);
+    COMMON_SetPRIMASK(primask);
 }
 
 /**
- * @brief      Enable and config the ID vague filter
- * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID
- * @param[in]  idFilterValue:  the value of ID filter. It is range is 0 - 0x3F.
- * @param[in]  idFilterMask:  the mask of the vague ID filter. If a bit of
- *                            idFilterMask is 0, this bit in the vague ID filter
- *                            is ignored. Only bit0-5 is valid.
- * @return     none
+ * @brief      Update the cached response of a published ID
  *
- */
-void UART_LinEnableVagueIdFilter(UART_ID_t uartId,
-                                           uint8_t idFilterValue,
-                                           uint8_t idFilterMask)
-{
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-
-    UARTx->UART_LIN_PID_FILTER_VAGUE.FID_VAGUE = idFilterValue;
-    UARTx->UART_LIN_PID_FILTER_CTRL.FID_VAGUE_MASK = idFilterMask;
-    UARTx->UART_LIN_PID_FILTER_CTRL.FID_MASK |= ((uint32_t)1U << 16U);
-}
-
-/**
- * @brief      Disable the vague ID filter
- * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID
- * @return     none
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  id:  6-bit ID
+ * @param[in]  data:  the new response
  *
- */
-void UART_LinDisableVagueIdFilter(UART_ID_t uartId)
-{
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-
-    UARTx->UART_LIN_PID_FILTER_CTRL.FID_MASK &= ~((uint32_t)1U << 16U);
-}
-
-/**
- * @brief      Enable/Disable ID filters
- * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID
- * @param[in]  ids:  the IDs to be enabled/disabled. The bit0-15 correspond to
- *                   ID filter 0-15. Bit 16 corresponds to the vague ID filter.
- *                   If a bit is 1,the corresponding ID filter is enabled;
- *                   otherwise is disabled.
- * @return    none
+ * @return     status
+ *             - SUCC : the response is updated
+ *             - ERR : the ID is not published by the table
  *
  */
-void UART_LinIdFiltersCmd(UART_ID_t uartId, uint32_t idIndex)
+ResultStatus_t UART_LinSlaveUpdateResponse(UART_ID_t uartId, uint8_t id,
+                                           const uint8_t data[])
 {
-    uart_reg_t * UARTx = (uart_reg_t *)(uartRegPtr[uartId]);
-
-    UARTx->UART_LIN_PID_FILTER_CTRL.FID_MASK = idIndex;
+    UART_LinSlave_t *slave = &uartLinSlave[uartId];
+    UART_LinSlaveEntry_t *entry;
+    ResultStatus_t ret = ERR;
+    uint32_t primask;
+    uint32_t idx;
+    
+    if((slave->table != NULL) && (id <= UART_LIN_ID_MASK))
+    {
+        idx = slave->entryIdx[id];
+        
+        if(idx != UART_LIN_ENTRY_NONE)
+        {
+            entry = &slave->table->entries[idx];
+            
+            if(UART_LIN_RSP_PUBLISH == entry->dir)
+            {
+                /* the header done interrupt shall not send a half update */
+                primask = COMMON_GetPRIMASK();
+                COMMON_DISABLE_INTERRUPTS();
+                for(uint32_t count = 0U; count < entry->rsp.len; count++)
+                {
+                    entry->rsp.data[count] = data[count];
+                }
+                COMMON_SetPRIMASK(primask);
+                
+                ret = SUCC;
+            }
+        }
+    }
+    
+    return ret;
 }
 
 /**
- * @brief      Config the ID filter values for ID filter 0-15. It will config
- *             the ID filter values for ID filter 0 - (idNum-1) in order. The
- *             value to be configed is stored in the memory that idValues points
- *             to.
- * @param[in]  uartId:  Select the UART port.It should be UART0_ID, UART1_ID,
- *                      UART2_ID, UART3_ID
- * @param[in]  idNum:  the number of IDs to be configured. The range is 1-16.
- * @param[in]  idValues:  a pointer to the ID filter value that will be used to
- *                        config the ID filters. The size of the memory must
- *                        not smaller than idNum
- * @return
- *            - SUCC
- *            - ERR : parameter error
+ * @brief      Read the last response of a subscribed ID
+ *
+ * @param[in]  uartId:  Select the UART port.It should be  UART0_ID, UART1_ID,
+ *                      UART2_ID, UART3_ID, UART4_ID, UART5_ID.
+ * @param[in]  id:  6-bit ID
+ * @param[out] data:  points to the memory where the response to be stored
+ *
+ * @return     status
+ *             - SUCC : the response is read
+ *             - ERR : the ID is not subscribed by the table
  *
  */
-ResultStatus_t UART_LinConfigIdFilters(UART_ID_t uartId, uint8_t idNum,
-                                       const uint8_t idValues[])
+ResultStatus_t UART_LinSlaveReadData(UART_ID_t uartId, uint8_t id,
+                                     uint8_t data[])
 {
-    ResultStatus_t ret;
-
-    volatile uint32_t regTmp;
-    uint32_t tmp;
-    volatile uint32_t* idFilterP[4];
-    uart_reg_w_t * UARTxw = (uart_reg_w_t *)(uartRegWPtr[uartId]);
+    UART_LinSlave_t *slave = &uartLinSlave[uartId];
+    UART_LinSlaveEntry_t *entry;
+    ResultStatus_t ret = ERR;
+    uint32_t primask;
+    uint32_t idx;
     
-    idFilterP[0] = &(UARTxw->UART_LIN_PID_FILTER_0);
-    idFilterP[1] = &(UARTxw->UART_LIN_PID_FILTER_1);
-    idFilterP[2] = &(UARTxw->UART_LIN_PID_FILTER_2);
-    idFilterP[3] = &(UARTxw->UART_LIN_PID_FILTER_3);
-
-    if(idNum > 16U)
-    {
-        ret = ERR;
-     }
-    else
+    if((slave->table != NULL) && (id <= UART_LIN_ID_MASK))
     {
-        for(uint8_t index = 0U; index < idNum; index++)
+        idx = slave->entryIdx[id];
+        
+        if(idx != UART_LIN_ENTRY_NONE)
         {
-            tmp = (index % 4UL) * 8UL;
-            regTmp = *idFilterP[index/4UL] & ~(0x3FUL << tmp);
-            *idFilterP[index/4UL] = regTmp | (uint8_t)(idValues[index] << tmp);
-            regTmp = regTmp | ((uint32_t)(idValues[index]) << tmp);
-            *idFilterP[index/4UL] = regTmp;
+            entry = &slave->table->entries[idx];
+            
+            if(UART_LIN_RSP_SUBSCRIBE == entry->dir)
+            {
+                primask = COMMON_GetPRIMASK();
+                COMMON_DISABLE_INTERRUPTS();
+                for(uint32_t count = 0U; count < entry->rsp.len; count++)
+                {
+                    data[count] = entry->rsp.data[count];
+                }
+                COMMON_SetPRIMASK(primask);
+                
+                ret = SUCC;
+            }
         }
-        ret = SUCC;
     }
+    
     return ret;
 }
 
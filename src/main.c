@@ -28,6 +28,10 @@ static const STIM_Config_t stimConfig =
     .clockSource = STIM_FUNCTION_CLOCK,
 };
 
+/* STIM period count, the UART ring is drained by its own interrupt, so 
+   printing is done in the main loop instead of the STIM interrupt */
+static volatile uint32_t stimTickCnt = 0U;
+
 void Ex_LedPinsInit(void)
 {
     /* Enable PORTB/PORTD module*/
@@ -80,6 +84,11 @@ void Ex_LightGreen(void)
 }
 
 static void STIM_IntCallBack(void)
+{
+    stimTickCnt++;
+}
+
+static void Ex_LightSequence(void)
 {
     Ex_LightBlue();
     Ex_Print("Blue light.\n");
@@ -120,6 +129,8 @@ void Ex_StimInit(void)
 
 int main(void)
 {
+    uint32_t tickCnt = 0U;
+
     /* CLock init*/
     Ex_ClockInit();
 
@@ -138,5 +149,12 @@ int main(void)
     /* Init stim*/
     Ex_StimInit();
 
-    for (;;);
+    for (;;)
+    {
+        if(tickCnt != stimTickCnt)
+        {
+            tickCnt = stimTickCnt;
+            Ex_LightSequence();
+        }
+    }
 }
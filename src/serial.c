@@ -23,6 +23,43 @@
     .oscFreq = 40000000             /* UART function clock freq: 40000000 */
 };
 
+/* UART FIFO configuration */
+static const UART_FIFOConfig_t uartFifoConfig =
+{
+    .fifoEnable = ENABLE,               /* FIFO enable */
+    .txFifoReset = ENABLE,              /* Reset TX FIFO */
+    .rxFifoReset = ENABLE,              /* Reset RX FIFO */
+    .fifoTet = UART_TX_FIFO_CHAR_2,     /* TX empty interrupt at 2 characters */
+    .fifoRt = UART_RX_FIFO_HALF         /* RX interrupt at half full */
+};
+
+/* Buffered mode ring storage, size shall be a power of 2 */
+static uint8_t uartTxBuf[512];
+static uint8_t uartRxBuf[64];
+
+/* Copy data into the TX ring, wait only when the ring is full */
+static void Ex_UartWrite(const uint8_t *data, uint32_t len)
+{
+    uint32_t sent = 0U;
+
+    while(sent < len)
+    {
+        sent += UART_Write(UART1_ID, &data[sent], len - sent);
+    }
+}
+
+#if defined(__ICCARM__) || defined(__ARMCC_VERSION)
+/* Wait for one received byte */
+static uint8_t Ex_UartReadByte(void)
+{
+    uint8_t data;
+
+    while(0U == UART_Read(UART1_ID, &data, 1U));
+
+    return data;
+}
+#endif
+
  void Ex_BoardUartInit(void)
 {
     /* Set and enable UART clock */
@@ -41,6 +78,12 @@
     /* Inital UART */
     UART_Init(UART1_ID, &uartConfig);
 
+    /* Buffered mode: the UART interrupt moves data in FIFO bursts */
+    UART_FIFOConfig(UART1_ID, &uartFifoConfig);
+    (void)UART_BufferedConfig(UART1_ID, uartTxBuf, sizeof(uartTxBuf),
+                              uartRxBuf, sizeof(uartRxBuf));
+    INT_EnableIRQ(UART1_IRQn);
+
     /*Set printf not buffered*/
 #if defined(__GNUC__) | defined(__ghs__)
     setbuf(stdout, NULL);
@@ -50,20 +93,16 @@
 #if defined(__ICCARM__)
 int fputc(int ch, FILE *f)
 {
-    /* Wait untill FIFO is empty */
-    while(RESET == UART_GetLineStatus(UART1_ID, UART_LINESTA_TEMT));
+    uint8_t data = (uint8_t)ch;
 
     /* Send data */
-    UART_SendByte(UART1_ID, (uint8_t)ch);
+    Ex_UartWrite(&data, 1U);
     return ch;
 }
 
 int fgetc(FILE *f)
 {
-    /* Wait untill FIFO is ready */
-    while(RESET == UART_GetLineStatus(UART1_ID, UART_LINESTA_DR));
-
-    return (int)UART_ReceiveByte(UART1_ID);
+    return (int)Ex_UartReadByte();
 }
 
 #elif defined(__ARMCC_VERSION)
@@ -75,21 +114,18 @@ FILE __stderr;
 
 int fputc(int ch, FILE *f)
 {
-    (void)(f);
-    /* Wait untill FIFO is empty */
-    while(RESET == UART_GetLineStatus(UART1_ID, UART_LINESTA_TEMT));
+    uint8_t data = (uint8_t)ch;
 
+    (void)(f);
     /* Send data */
-    UART_SendByte(UART1_ID, ch);
+    Ex_UartWrite(&data, 1U);
     return ch;
 }
 
 int fgetc(FILE *f)
 {
     (void)(f);
-    /* Wait untill FIFO is ready */
-    while(RESET == UART_GetLineStatus(UART1_ID, UART_LINESTA_DR));
-    return UART_ReceiveByte(UART1_ID);
+    return (int)Ex_UartReadByte();
 }
 
 void _sys_exit(int return_code) {
@@ -99,18 +135,8 @@ label:  goto label;  /* endless loop */
 #elif defined(__GNUC__) | defined(__ghs__)
 int _write (int file, char *ptr, int len) 
 {
-    uint32_t idx = 0;
-    int ch = 0;
-
-    for(idx = 0; idx < len; idx++)
-    {
-        ch = *(ptr + idx);
-        /* Wait untill FIFO is empty */
-        while(RESET == UART_GetLineStatus(UART1_ID, UART_LINESTA_TEMT));
-      
-        /* Send data */
-        UART_SendByte(UART1_ID, ch);
-    }
+    /* Send data */
+    Ex_UartWrite((const uint8_t *)ptr, (uint32_t)len);
 
     return len;
 }
@@ -18,6 +18,7 @@
 #include "uart_drv.h"
 #include "clock_drv.h"
 #include "sysctrl_drv.h"
+#include "int_drv.h"
 #include <stdio.h>
 
 /* Example print function*/